@@ -34,6 +34,14 @@ class SimpleProcAst : public ProcAst {
         _statement.reset(statement);
     }
 
+    /*
+     * Give up ownership of the procedure body, so that it can be
+     * replaced.
+     */
+    StatementAst* release_statement() {
+        return _statement.release();
+    }
+
     virtual std::string get_name() {
         return _name;
     }
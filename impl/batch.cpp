@@ -22,6 +22,7 @@
 #include <sstream>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <iostream>
 #include <fstream>
 #include <istream>
@@ -29,15 +30,17 @@
 #include <algorithm>
 #include <stdexcept>
 #include "simple/spa.h"
+#include "simple/util/memo_cache.h"
 #include "impl/parse_error.h"
 
 using namespace std;
 using simple::parser::IncompleteParseError;
+using simple::util::MemoCacheBudget;
 
 bool file_exists(const string& filename)
 {
   ifstream ifile(filename);
-  return ifile != NULL;
+  return ifile.good();
 }
 
 void normalize_string(string& str)
@@ -166,12 +169,25 @@ int main(int argc, const char* argv[]) {
     cerr.tie(nullptr);
 
     if(argc < 3) {
-        cout << "Usage: batch [source_file] [pql_file]." << endl;
+        cout << "Usage: batch [source_file] [pql_file] "
+                "[--cache-limit mb] [--cache-stats]." << endl;
         return 0;
     }
 
     string source_file(argv[1]);
     string pql_file(argv[2]);
+    bool print_cache_stats = false;
+
+    for(int i = 3; i < argc; ++i) {
+        string arg(argv[i]);
+
+        if(arg == "--cache-limit" && i + 1 < argc) {
+            MemoCacheBudget::global().set_limit(
+                (size_t) atoi(argv[++i]) << 20);
+        } else if(arg == "--cache-stats") {
+            print_cache_stats = true;
+        }
+    }
 
     if(!file_exists(source_file)) {
         cout << "Unable to open simple source file " << source_file << endl;
@@ -188,7 +204,7 @@ int main(int argc, const char* argv[]) {
     }
 
     ifstream pql_source(pql_file);
-    if(pql_source == NULL) {
+    if(!pql_source) {
         cout << "Unable to open pql file " << pql_file << endl;
         return 0;
     }
@@ -200,5 +216,9 @@ int main(int argc, const char* argv[]) {
         return 0;
     }
 
+    if(print_cache_stats) {
+        MemoCacheBudget::global().print_stats(cout);
+    }
+
     return 0;
 }
@@ -0,0 +1,331 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "impl/boolean_processor.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+
+/*
+ * Unpack a single PQL term into the condition, query variable or
+ * wildcard slot of one side of a boolean clause.
+ */
+class TermUnpackVisitor : public PqlTermVisitor {
+  public:
+    TermUnpackVisitor(SimpleCondition **condition, Qvar *qvar, bool *wildcard) :
+        _condition(condition), _qvar(qvar), _wildcard(wildcard)
+    { }
+
+    void visit_condition_term(PqlConditionTerm *term) {
+        *_condition = term->get_condition().get();
+    }
+
+    void visit_variable_term(PqlVariableTerm *term) {
+        *_qvar = term->get_query_variable();
+    }
+
+    void visit_wildcard_term(PqlWildcardTerm *term) {
+        *_wildcard = true;
+    }
+
+  private:
+    SimpleCondition **_condition;
+    Qvar            *_qvar;
+    bool            *_wildcard;
+};
+
+BooleanQueryProcessor::BooleanQueryProcessor(
+        const std::map<Qvar, PredicatePtr>& predicates,
+        PredicatePtr wildcard_pred,
+        int max_bindings) :
+    _predicates(predicates), _wildcard_pred(wildcard_pred),
+    _max_bindings(max_bindings), _bindings_tried(0), _exhausted(false)
+{ }
+
+BooleanQueryProcessor::BooleanClause
+BooleanQueryProcessor::unpack_clause(PqlClause *clause) {
+    BooleanClause result;
+    result.solver = clause->get_solver();
+    result.left_condition = NULL;
+    result.right_condition = NULL;
+    result.left_wildcard = false;
+    result.right_wildcard = false;
+
+    TermUnpackVisitor left_visitor(&result.left_condition,
+            &result.left_qvar, &result.left_wildcard);
+    clause->get_left_term()->accept_pql_term_visitor(&left_visitor);
+
+    TermUnpackVisitor right_visitor(&result.right_condition,
+            &result.right_qvar, &result.right_wildcard);
+    clause->get_right_term()->accept_pql_term_visitor(&right_visitor);
+
+    return result;
+}
+
+bool BooleanQueryProcessor::solve(const ClauseSet& clauses, bool& result) {
+    _clauses.clear();
+    _bindings.clear();
+    _bindings_tried = 0;
+    _exhausted = false;
+
+    for(ClauseSet::const_iterator it = clauses.begin();
+            it != clauses.end(); ++it)
+    {
+        _clauses.push_back(unpack_clause(it->get()));
+    }
+
+    _solved.assign(_clauses.size(), false);
+
+    result = search(_clauses.size());
+    return !_exhausted;
+}
+
+/*
+ * Pick the unsolved clause with the fewest unbound query variables
+ * and try to satisfy it under the current bindings. Clauses without
+ * unbound query variables are pure checks and so are always tried
+ * first, which prunes a failing branch as early as possible.
+ */
+bool BooleanQueryProcessor::search(size_t remaining) {
+    if(remaining == 0) return true;
+
+    size_t best = _clauses.size();
+    int best_unbound = 3;
+
+    for(size_t i = 0; i < _clauses.size(); ++i) {
+        if(_solved[i]) continue;
+
+        int unbound = count_unbound(_clauses[i]);
+        if(unbound < best_unbound) {
+            best = i;
+            best_unbound = unbound;
+        }
+    }
+
+    const BooleanClause& clause = _clauses[best];
+
+    bool left_free = is_free(clause.left_qvar);
+    bool right_free = is_free(clause.right_qvar);
+
+    if(!left_free && !right_free) {
+        if(!solve_bound_clause(clause)) return false;
+
+        _solved[best] = true;
+        bool result = search(remaining - 1);
+        _solved[best] = false;
+
+        return result;
+
+    } else if(left_free && right_free) {
+        if(clause.left_qvar == clause.right_qvar) {
+            return bind_same(best, remaining);
+        } else {
+            return bind_either(best, remaining);
+        }
+
+    } else if(left_free) {
+        return bind_left(best, remaining);
+
+    } else {
+        return bind_right(best, remaining);
+    }
+}
+
+bool BooleanQueryProcessor::solve_bound_clause(const BooleanClause& clause) {
+    QuerySolver *solver = clause.solver;
+    SimpleCondition *left = get_side(clause.left_condition, clause.left_qvar);
+    SimpleCondition *right = get_side(clause.right_condition, clause.right_qvar);
+
+    if(clause.left_wildcard && clause.right_wildcard) {
+        return solver->is_nonempty(_wildcard_pred->global_set());
+
+    } else if(clause.left_wildcard) {
+        return solver->has_left(right);
+
+    } else if(clause.right_wildcard) {
+        return solver->has_right(left);
+
+    } else {
+        return solver->validate(left, right);
+    }
+}
+
+/*
+ * The left query variable is the only unbound side of the clause. Its
+ * candidates are checked one pair at a time, so the search stops at the
+ * first witness without solving the whole left result of the clause.
+ */
+bool BooleanQueryProcessor::bind_left(size_t index, size_t remaining) {
+    const BooleanClause& clause = _clauses[index];
+    QuerySolver *solver = clause.solver;
+    SimpleCondition *right = clause.right_wildcard ? NULL :
+        get_side(clause.right_condition, clause.right_qvar);
+
+    const ConditionSet& domain = get_predicate(clause.left_qvar)->global_set();
+    for(ConditionSet::iterator it = domain.begin();
+            it != domain.end() && !_exhausted; ++it)
+    {
+        if(right == NULL) {
+            if(!solver->has_right(*it)) continue;
+        } else {
+            if(!solver->validate(*it, right)) continue;
+        }
+
+        if(try_binding(clause.left_qvar, *it, index, true, remaining)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * The right query variable is the only unbound side of the clause.
+ */
+bool BooleanQueryProcessor::bind_right(size_t index, size_t remaining) {
+    const BooleanClause& clause = _clauses[index];
+    QuerySolver *solver = clause.solver;
+    SimpleCondition *left = clause.left_wildcard ? NULL :
+        get_side(clause.left_condition, clause.left_qvar);
+
+    const ConditionSet& domain = get_predicate(clause.right_qvar)->global_set();
+    for(ConditionSet::iterator it = domain.begin();
+            it != domain.end() && !_exhausted; ++it)
+    {
+        if(left == NULL) {
+            if(!solver->has_left(*it)) continue;
+        } else {
+            if(!solver->validate(left, *it)) continue;
+        }
+
+        if(try_binding(clause.right_qvar, *it, index, true, remaining)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Both sides of the clause are the same unbound query variable.
+ */
+bool BooleanQueryProcessor::bind_same(size_t index, size_t remaining) {
+    const BooleanClause& clause = _clauses[index];
+    const ConditionSet& domain = get_predicate(clause.left_qvar)->global_set();
+
+    for(ConditionSet::iterator it = domain.begin();
+            it != domain.end() && !_exhausted; ++it)
+    {
+        if(!clause.solver->validate(*it, *it)) continue;
+        if(try_binding(clause.left_qvar, *it, index, true, remaining)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Both sides of the clause are unbound. Bind the side with the smaller
+ * domain and leave the clause unsolved, so that the next search step
+ * picks it up again with only the other side unbound.
+ */
+bool BooleanQueryProcessor::bind_either(size_t index, size_t remaining) {
+    const BooleanClause& clause = _clauses[index];
+    QuerySolver *solver = clause.solver;
+
+    const ConditionSet& left_domain =
+        get_predicate(clause.left_qvar)->global_set();
+    const ConditionSet& right_domain =
+        get_predicate(clause.right_qvar)->global_set();
+
+    if(left_domain.get_size() <= right_domain.get_size()) {
+        for(ConditionSet::iterator it = left_domain.begin();
+                it != left_domain.end() && !_exhausted; ++it)
+        {
+            if(!solver->has_right(*it)) continue;
+            if(try_binding(clause.left_qvar, *it, index, false, remaining)) {
+                return true;
+            }
+        }
+    } else {
+        for(ConditionSet::iterator it = right_domain.begin();
+                it != right_domain.end() && !_exhausted; ++it)
+        {
+            if(!solver->has_left(*it)) continue;
+            if(try_binding(clause.right_qvar, *it, index, false, remaining)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool BooleanQueryProcessor::try_binding(
+        const Qvar& qvar, const ConditionPtr& condition,
+        size_t index, bool solved, size_t remaining)
+{
+    if(++_bindings_tried > _max_bindings) {
+        _exhausted = true;
+        return false;
+    }
+
+    _bindings.insert(std::make_pair(qvar, condition));
+    _solved[index] = solved;
+
+    bool result = search(solved ? remaining - 1 : remaining);
+
+    _solved[index] = false;
+    _bindings.erase(qvar);
+
+    return result;
+}
+
+int BooleanQueryProcessor::count_unbound(const BooleanClause& clause) {
+    int count = 0;
+    if(is_free(clause.left_qvar)) ++count;
+    if(is_free(clause.right_qvar)) ++count;
+    return count;
+}
+
+bool BooleanQueryProcessor::is_free(const Qvar& qvar) {
+    return !qvar.empty() && _bindings.count(qvar) == 0;
+}
+
+/*
+ * Get the condition of one side of a clause, which is either the
+ * condition term itself or the condition bound to the query variable.
+ */
+SimpleCondition* BooleanQueryProcessor::get_side(
+        SimpleCondition *condition, const Qvar& qvar)
+{
+    if(qvar.empty()) return condition;
+    return _bindings.find(qvar)->second.get();
+}
+
+SimplePredicate* BooleanQueryProcessor::get_predicate(const Qvar& qvar) {
+    std::map<Qvar, PredicatePtr>::iterator it = _predicates.find(qvar);
+
+    if(it != _predicates.end()) {
+        return it->second.get();
+    } else {
+        return _wildcard_pred.get();
+    }
+}
+
+} // namespace impl
+} // namespace simple
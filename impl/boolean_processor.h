@@ -0,0 +1,112 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <string>
+#include "simple/solver.h"
+#include "simple/predicate.h"
+#include "simple/query.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+
+/*
+ * BooleanQueryProcessor answers Select BOOLEAN queries by searching for
+ * a single assignment of the query variables that satisfies all clauses.
+ *
+ * The search is depth first. At each step the clause with the fewest
+ * unbound query variables is picked, and its candidates are bound one
+ * at a time. A candidate is taken from the predicate of its query
+ * variable and checked against the clause with validate(), has_left()
+ * or has_right(), so no clause ever has its result set solved. The 
+ * search stops at the first witness, so a true query does not pay for
+ * computing the complete result set of every clause the way the linker
+ * does.
+ *
+ * Since a failing search can take exponential time, it gives up after
+ * a fixed number of bindings and lets the caller fall back to the
+ * linker based evaluation.
+ */
+class BooleanQueryProcessor {
+  public:
+    BooleanQueryProcessor(
+            const std::map<Qvar, PredicatePtr>& predicates,
+            PredicatePtr wildcard_pred,
+            int max_bindings = 10000);
+
+    /*
+     * Search for a witness of the clauses. Returns false if the search
+     * budget is exhausted before the answer is known, otherwise the
+     * answer is stored in result.
+     */
+    bool solve(const ClauseSet& clauses, bool& result);
+
+  private:
+    /*
+     * A clause with its terms unpacked. Exactly one of the condition,
+     * the query variable or the wildcard flag is set for each side.
+     */
+    struct BooleanClause {
+        QuerySolver     *solver;
+        SimpleCondition *left_condition;
+        SimpleCondition *right_condition;
+        Qvar            left_qvar;
+        Qvar            right_qvar;
+        bool            left_wildcard;
+        bool            right_wildcard;
+    };
+
+    BooleanClause unpack_clause(PqlClause *clause);
+
+    bool search(size_t remaining);
+
+    bool solve_bound_clause(const BooleanClause& clause);
+
+    bool bind_left(size_t index, size_t remaining);
+    bool bind_right(size_t index, size_t remaining);
+    bool bind_same(size_t index, size_t remaining);
+    bool bind_either(size_t index, size_t remaining);
+
+    bool try_binding(const Qvar& qvar, const ConditionPtr& condition,
+            size_t index, bool solved, size_t remaining);
+
+    int count_unbound(const BooleanClause& clause);
+    bool is_free(const Qvar& qvar);
+    SimpleCondition* get_side(SimpleCondition *condition, const Qvar& qvar);
+
+    SimplePredicate* get_predicate(const Qvar& qvar);
+
+    std::map<Qvar, PredicatePtr>    _predicates;
+    PredicatePtr                    _wildcard_pred;
+
+    std::vector<BooleanClause>      _clauses;
+    std::vector<bool>               _solved;
+    std::map<Qvar, ConditionPtr>    _bindings;
+
+    int     _max_bindings;
+    int     _bindings_tried;
+    bool    _exhausted;
+};
+
+} // namespace impl
+} // namespace simple
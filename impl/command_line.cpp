@@ -17,31 +17,47 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <iostream>
 #include <fstream>
 #include <iterator>
 #include <algorithm>
 #include <stdexcept>
 #include "simple/spa.h"
+#include "simple/util/memo_cache.h"
 #include "impl/parse_error.h"
 
 using std::cout;
 using std::cin;
 using std::endl;
 using simple::parser::IncompleteParseError;
+using simple::util::MemoCacheBudget;
 
 bool file_exists(const std::string& filename)
 {
   std::ifstream ifile(filename);
-  return ifile != NULL;
+  return ifile.good();
 }
 
 int main(int argc, const char* argv[]) {
     if(argc < 2) {
         cout << "Please supply filename as first argument." << endl;
+        return 0;
     }
 
     std::string filename(argv[1]);
+    bool print_cache_stats = false;
+
+    for(int i = 2; i < argc; ++i) {
+        std::string arg(argv[i]);
+
+        if(arg == "--cache-limit" && i + 1 < argc) {
+            MemoCacheBudget::global().set_limit(
+                (size_t) atoi(argv[++i]) << 20);
+        } else if(arg == "--cache-stats") {
+            print_cache_stats = true;
+        }
+    }
 
     if(!file_exists(filename)) {
         cout << "Unable to open file " << filename << endl;
@@ -62,7 +78,7 @@ int main(int argc, const char* argv[]) {
 
     while(true) {
         std::string input;
-        getline(cin, input);
+        if(!getline(cin, input)) break;
         line += input;
 
         try {
@@ -90,5 +106,10 @@ int main(int argc, const char* argv[]) {
         }
     }
 
+    cout << endl;
+    if(print_cache_stats) {
+        MemoCacheBudget::global().print_stats(cout);
+    }
+
     return 0;
 }
@@ -28,10 +28,14 @@
 #include "impl/parser/parser.h"
 #include "impl/parser/pql_parser.h"
 #include "impl/parser/iterator_tokenizer.h"
+#include "impl/parser/incremental_parser.h"
 
 #include "impl/linker.h"
 #include "impl/selector.h"
 #include "impl/processor.h"
+#include "impl/boolean_processor.h"
+#include "impl/query_rewriter.h"
+#include "impl/query_components.h"
 #include "impl/solver_table.h"
 #include "impl/predicate_table.h"
 
@@ -45,13 +49,40 @@ using namespace simple::parser;
 class SimplePqlFrontEnd {
   public:
     template <typename Iterator>
-    SimplePqlFrontEnd(Iterator begin, Iterator end)
+    SimplePqlFrontEnd(Iterator begin, Iterator end) :
+        _parser(new IncrementalParser(std::string(begin, end)))
     {
-        parse_source(begin, end);
-        
-        _solver_table = create_solver_table(_ast);
+        load_program();
+    }
+
+    /*
+     * Reload the program from a new version of its source. Only the 
+     * procedures that changed are parsed again, and their new bodies
+     * replace the old ones in place. The solvers then patch what they
+     * indexed for those procedures, see ProgramSolvers, and the 
+     * predicates are collected again. A source that fails to parse
+     * leaves the front end as it was. Returns false if nothing changed.
+     */
+    template <typename Iterator>
+    bool reload_source(Iterator begin, Iterator end)
+    {
+        if(!_parser->update(std::string(begin, end))) return false;
 
-        populate_predicates();
+        if(_parser->is_new_program()) {
+            load_program();
+        } else {
+            update_program();
+        }
+
+        return true;
+    }
+
+    /*
+     * The new statement line of each statement kept by the last reload,
+     * indexed by its old statement line.
+     */
+    const std::map<int, int>& get_line_mapping() {
+        return _parser->get_line_mapping();
     }
 
     template <typename Iterator>
@@ -65,39 +96,101 @@ class SimplePqlFrontEnd {
         PqlQuerySet query = parser.parse_query();
         query.predicates["*"] = _wildcard_pred;
 
-        std::shared_ptr<QueryLinker> linker(
-            new SimpleQueryLinker(query.predicates, _wildcard_pred->global_set()));
+        QueryRewriter rewriter(_solver_table);
+        bool satisfiable = rewriter.rewrite(query);
 
-        QueryProcessor processor(linker, query.predicates, _wildcard_pred);
+        std::shared_ptr<ComponentQueryLinker> linker(new ComponentQueryLinker(
+            query.predicates, _wildcard_pred->global_set()));
 
-        for(ClauseSet::iterator it = query.clauses.begin();
-            it != query.clauses.end(); ++it)
-        {
-            processor.solve_clause(it->get());
+        if(!satisfiable || !solve_components(query, linker.get())) {
+            linker->invalidate_state();
         }
 
-        return format_result(&query, linker.get());
+        return format_result(&query, linker.get(), _domain.get());
     }
   
   protected:
-    template <typename SourceIterator>
-    void parse_source(SourceIterator begin, SourceIterator end) 
-    {
-        SimpleParser parser(
-            new IteratorTokenizer<SourceIterator>(begin, end));
+    /*
+     * Solve each connected component of the query on its own. A component
+     * without selected query variables only has to have a solution, so 
+     * it is first tried as a boolean query that stops at the first one.
+     * The linkers of the selected components are handed to the component
+     * linker. Returns false if a component has no solution.
+     */
+    bool solve_components(PqlQuerySet& query, ComponentQueryLinker *linker) {
+        std::vector<QueryComponent> components = split_query_components(query);
+
+        for(std::vector<QueryComponent>::iterator it = components.begin();
+            it != components.end(); ++it)
+        {
+            if(!it->selected) {
+                BooleanQueryProcessor boolean_processor(
+                    query.predicates, _wildcard_pred);
+
+                bool result;
+                if(boolean_processor.solve(it->clauses, result)) {
+                    if(!result) return false;
+                    continue;
+                }
+            }
+
+            std::shared_ptr<QueryLinker> component_linker(new SimpleQueryLinker(
+                query.predicates, _wildcard_pred->global_set()));
 
-        _ast = parser.parse_program();
-        _line_table = parser.get_statement_line_table();
+            QueryProcessor processor(component_linker, 
+                query.predicates, _wildcard_pred);
+
+            for(ClauseSet::iterator clause = it->clauses.begin();
+                clause != it->clauses.end(); ++clause)
+            {
+                processor.solve_clause(clause->get());
+            }
+
+            if(!component_linker->is_valid_state()) return false;
+
+            if(it->selected) linker->add_component(*it, component_linker);
+        }
+
+        return true;
+    }
+
+    /*
+     * Build the solvers and predicates of the program held by the parser.
+     */
+    void load_program() {
+        _ast = _parser->get_ast();
+        _line_table = _parser->get_statement_line_table();
+        _solvers.reset(new ProgramSolvers(_ast));
+        _solver_table = _solvers->get_solver_table();
+
+        load_predicates();
+    }
+
+    /*
+     * Patch the solvers for the procedures the parser replaced.
+     */
+    void update_program() {
+        _line_table = _parser->get_statement_line_table();
+        _solvers->update_procs(_parser->get_changed_procs(), 
+            _parser->get_old_bodies());
+        _solver_table = _solvers->get_solver_table();
+
+        load_predicates();
     }
 
-    void populate_predicates() {
-        _pred_table = create_predicate_table(_ast);
+    void load_predicates() {
+        _domain.reset(new PredicateDomain(_ast));
+        _pred_table = create_predicate_table(_domain);
         _wildcard_pred = _pred_table["wildcard"];
     }
 
   private:
+    std::unique_ptr<IncrementalParser> _parser;
+
     SimpleRoot      _ast;
+    std::unique_ptr<ProgramSolvers> _solvers;
     SolverTable     _solver_table;
+    std::shared_ptr<PredicateDomain> _domain;
     PredicateTable  _pred_table;
     LineTable       _line_table;
     PredicatePtr    _wildcard_pred;
@@ -16,6 +16,7 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include "impl/linker.h"
 
 namespace simple {
@@ -37,20 +38,149 @@ SimpleQueryLinker::SimpleQueryLinker(
     }
 }
 
+int SimpleQueryLinker::find_qvar(const std::string& qvar) const {
+    auto it = _qvar_ids.find(qvar);
+    return it != _qvar_ids.end() ? it->second : -1;
+}
+
+int SimpleQueryLinker::add_qvar(
+    const std::string& qvar, const ConditionSet& conditions) 
+{
+    int id = find_qvar(qvar);
+    if(id != -1) return id;
+
+    id = _qvars.size();
+    _qvars.push_back(QvarState(qvar, conditions));
+    _qvar_ids[qvar] = id;
+
+    return id;
+}
+
+int SimpleQueryLinker::find_links(int qvar1, int qvar2) const {
+    const std::vector<int>& links = _qvars[qvar1].links;
+
+    for(auto it = links.begin(); it != links.end(); ++it) {
+        if(_links[*it].neighbour == qvar2) return *it;
+    }
+
+    return -1;
+}
+
+int SimpleQueryLinker::add_links(int qvar1, int qvar2) {
+    int id = find_links(qvar1, qvar2);
+    if(id != -1) return id;
+
+    id = _links.size();
+
+    _links.push_back(QvarLinks(qvar1, qvar2, _qvars[qvar1].domain.size()));
+    _links.push_back(QvarLinks(qvar2, qvar1, _qvars[qvar2].domain.size()));
+    _links[id].reverse = id + 1;
+    _links[id + 1].reverse = id;
+
+    _qvars[qvar1].links.push_back(id);
+    _qvars[qvar2].links.push_back(id + 1);
+
+    return id;
+}
+
+int SimpleQueryLinker::find_condition(
+    int qvar, const ConditionPtr& condition) const
+{
+    const std::vector<ConditionPtr>& domain = _qvars[qvar].domain;
+
+    auto it = std::lower_bound(domain.begin(), domain.end(), condition);
+    if(it == domain.end() || *it != condition) return -1;
+
+    return it - domain.begin();
+}
+
+const ConditionSet& SimpleQueryLinker::get_condition_set(int qvar) {
+    QvarState& state = _qvars[qvar];
+
+    if(state.conditions_changed) {
+        std::set<ConditionPtr> conditions;
+
+        for(size_t i = 0; i < state.domain.size(); ++i) {
+            if(state.alive[i]) conditions.insert(conditions.end(), state.domain[i]);
+        }
+
+        state.conditions = ConditionSet(std::move(conditions));
+        state.conditions_changed = false;
+    }
+
+    return state.conditions;
+}
+
+void SimpleQueryLinker::link_conditions(
+    int links_id, int condition1, int condition2)
+{
+    QvarLinks& links = _links[links_id];
+    QvarLinks& reverse = _links[links.reverse];
+
+    links.supports[condition1].push_back(condition2);
+    ++links.counters[condition1];
+
+    reverse.supports[condition2].push_back(condition1);
+    ++reverse.counters[condition2];
+}
+
+bool SimpleQueryLinker::is_linked(
+    int links_id, int condition1, int condition2) const
+{
+    const QvarLinks& links = _links[links_id];
+    const std::vector<int>& supports = links.supports[condition1];
+
+    return _qvars[links.qvar].alive[condition1] && 
+        _qvars[links.neighbour].alive[condition2] &&
+        std::find(supports.begin(), supports.end(), condition2) != supports.end();
+}
+
+/*
+ * Remove a link in both directions. The counters only count the links
+ * between live conditions, since the death of either end has already 
+ * taken the link off the counter of the other.
+ */
+void SimpleQueryLinker::unlink_conditions(
+    int links_id, int condition1, int condition2)
+{
+    if(!is_linked(links_id, condition1, condition2)) return;
+
+    QvarLinks& links = _links[links_id];
+    QvarLinks& reverse = _links[links.reverse];
+
+    std::vector<int>& supports1 = links.supports[condition1];
+    *std::find(supports1.begin(), supports1.end(), condition2) = supports1.back();
+    supports1.pop_back();
+
+    std::vector<int>& supports2 = reverse.supports[condition2];
+    *std::find(supports2.begin(), supports2.end(), condition1) = supports2.back();
+    supports2.pop_back();
+
+    if(--links.counters[condition1] == 0) queue_removal(links.qvar, condition1);
+    if(--reverse.counters[condition2] == 0) queue_removal(reverse.qvar, condition2);
+}
+
 bool SimpleQueryLinker::is_initialized(const std::string& qvar) {
-    return _qvar_table.count(qvar) > 0;
+    return find_qvar(qvar) != -1;
 }
 
 bool SimpleQueryLinker::has_condition(
     const std::string& qvar, const ConditionPtr& condition) 
 {
-    return _qvar_table[qvar].has_element(condition);
+    int id = find_qvar(qvar);
+    if(id == -1) return false;
+
+    int condition_id = find_condition(id, condition);
+    return condition_id != -1 && _qvars[id].alive[condition_id];
 }
 
 bool SimpleQueryLinker::has_link(
     const std::string& qvar1, const std::string& qvar2)
 {
-    return _qvar_link_table[qvar1].count(qvar2) > 0;
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+
+    return id1 != -1 && id2 != -1 && find_links(id1, id2) != -1;
 }
 
 /*
@@ -62,32 +192,43 @@ bool SimpleQueryLinker::add_link(
     const std::string& qvar1, const std::string& qvar2, 
     const ConditionPtr& condition1, const ConditionPtr& condition2)
 {
-    if(has_condition(qvar1, condition1) && has_condition(qvar2, condition2)) {
-        _condition_link_table[QVarPair(qvar1, qvar2)][condition1].insert(condition2);
-        _condition_link_table[QVarPair(qvar2, qvar1)][condition2].insert(condition1);
+    if(!has_condition(qvar1, condition1) || !has_condition(qvar2, condition2)) {
+        return false;
+    }
 
-        return true;
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    int links_id = add_links(id1, id2);
 
-    } else {
-        return false;
+    int condition_id1 = find_condition(id1, condition1);
+    int condition_id2 = find_condition(id2, condition2);
+
+    if(!is_linked(links_id, condition_id1, condition_id2)) {
+        link_conditions(links_id, condition_id1, condition_id2);
     }
+
+    return true;
 }
 
 void SimpleQueryLinker::update_results(
     const std::string& qvar, const ConditionSet& new_set)
 {
-    if(!is_initialized(qvar)) {
-        _qvar_table[qvar] = new_set;
+    int id = find_qvar(qvar);
+
+    if(id == -1) {
+        add_qvar(qvar, new_set);
         return;
     }
 
-    ConditionSet difference = _qvar_table[qvar].difference_with(new_set);
-
-    if(difference.is_empty()) return;
+    QvarState& state = _qvars[id];
 
-    for(auto it = difference.begin(); it != difference.end(); ++it) {
-        remove_condition(qvar, *it);
+    for(size_t i = 0; i < state.domain.size(); ++i) {
+        if(state.alive[i] && !new_set.has_element(state.domain[i])) {
+            queue_removal(id, i);
+        }
     }
+
+    propagate_removals();
 }
 
 void SimpleQueryLinker::init_qvar(
@@ -96,43 +237,74 @@ void SimpleQueryLinker::init_qvar(
     update_results(qvar, new_set);
 }
 
+/*
+ * The first links between two query variables remove every condition
+ * left without a link. Later links between them can only break the
+ * links already there.
+ */
 void SimpleQueryLinker::update_links(
     const std::string& qvar1, const std::string& qvar2, 
     const std::set<ConditionPair>& links)
 {
-    if(!is_initialized(qvar1)) _qvar_table[qvar1] = _global_set;
-    if(!is_initialized(qvar2)) _qvar_table[qvar2] = _global_set;
+    int id1 = add_qvar(qvar1, _global_set);
+    int id2 = add_qvar(qvar2, _global_set);
+
+    int links_id = find_links(id1, id2);
+
+    if(links_id != -1) {
+        const QvarLinks& qvar_links = _links[links_id];
+        const QvarState& state1 = _qvars[id1];
+        const QvarState& state2 = _qvars[id2];
 
-    if(has_link(qvar1, qvar2)) {
-        std::set<ConditionPair> old_links = get_links_as_tuples(qvar1, qvar2);
+        std::vector< std::pair<int, int> > broken;
 
-        for(auto it=old_links.begin(); it!=old_links.end(); ++it) {
-            ConditionPair old_link = *it;
+        for(size_t i = 0; i < state1.domain.size(); ++i) {
+            if(!state1.alive[i]) continue;
 
-            if(links.count(old_link) == 0) {
-                break_both_links(qvar1, qvar2, old_link.first, old_link.second);
+            const std::vector<int>& supports = qvar_links.supports[i];
+
+            for(auto it = supports.begin(); it != supports.end(); ++it) {
+                if(!state2.alive[*it]) continue;
+
+                ConditionPair link(state1.domain[i], state2.domain[*it]);
+                if(links.count(link) == 0) broken.push_back(std::make_pair(i, *it));
             }
         }
 
+        for(auto it = broken.begin(); it != broken.end(); ++it) {
+            unlink_conditions(links_id, it->first, it->second);
+        }
+
+        propagate_removals();
+
     } else {
-        ConditionSet new_set1;
-        ConditionSet new_set2;
+        links_id = add_links(id1, id2);
 
         for(auto it = links.begin(); it != links.end(); ++it) {
-            ConditionPtr condition1 = it->first;
-            ConditionPtr condition2 = it->second;
+            int condition1 = find_condition(id1, it->first);
+            int condition2 = find_condition(id2, it->second);
 
-            if(add_link(qvar1, qvar2, condition1, condition2)) {
-                new_set1.insert(condition1);
-                new_set2.insert(condition2);
+            if(condition1 == -1 || !_qvars[id1].alive[condition1] ||
+               condition2 == -1 || !_qvars[id2].alive[condition2]) 
+            {
+                continue;
             }
+
+            link_conditions(links_id, condition1, condition2);
         }
 
-        update_results(qvar1, new_set1);
-        update_results(qvar2, new_set2);
+        const QvarLinks& qvar_links = _links[links_id];
+        const QvarLinks& reverse = _links[qvar_links.reverse];
 
-        _qvar_link_table[qvar1].insert(qvar2);
-        _qvar_link_table[qvar2].insert(qvar1);
+        for(size_t i = 0; i < qvar_links.counters.size(); ++i) {
+            if(qvar_links.counters[i] == 0) queue_removal(id1, i);
+        }
+
+        for(size_t i = 0; i < reverse.counters.size(); ++i) {
+            if(reverse.counters[i] == 0) queue_removal(id2, i);
+        }
+
+        propagate_removals();
     }
 }
 
@@ -142,39 +314,30 @@ bool SimpleQueryLinker::validate_condition_pair(
     const ConditionPtr& condition1, 
     const ConditionPtr& condition2)
 {
-    QVarPair qvar_pair(qvar1, qvar2);
-    ConditionPair condition_pair(condition1, condition2);
-
-    std::pair<QVarPair, ConditionPair> key(qvar_pair, condition_pair);
-
-    // if(_valid_pair_cache.count(key) > 0) return true;
-    // if(_invalid_pair_cache.count(key) > 0) return false;
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    if(id1 == -1 || id2 == -1) return false;
 
-    ConditionSet links = cached_get_indirect_links(qvar1, qvar2, condition1);
+    int condition_id1 = find_condition(id1, condition1);
+    int condition_id2 = find_condition(id2, condition2);
+    if(condition_id1 == -1 || condition_id2 == -1) return false;
 
-    if(links.has_element(condition2)) {
-        _valid_pair_cache.insert(key);
-
-        return true;
-    } else {
-        _invalid_pair_cache.insert(key);
-
-        return false;
-    }
+    return has_indirect_link(id1, id2, condition_id1, condition_id2, 
+        std::vector<bool>(_qvars.size(), false));
 }
 
 bool SimpleQueryLinker::validate_tuple(
     const Qvar& qvar1, 
     const ConditionPtr& condition1,
     const QvarList& rest_qvars,
-    ConditionTuplePtr tuple) 
+    const ConditionPtr *row) 
 {
     for(auto q_it = rest_qvars.begin(); q_it != rest_qvars.end(); 
-        ++q_it, tuple=tuple->next()) 
+        ++q_it, ++row) 
     {
         const Qvar& qvar2 = *q_it;
 
-        ConditionPtr condition2 = tuple->get_condition();
+        const ConditionPtr& condition2 = *row;
 
         if(qvar1 == qvar2 && condition1 != condition2) return false;
 
@@ -188,147 +351,174 @@ bool SimpleQueryLinker::validate_tuple(
     return true;
 }
 
-TupleSet SimpleQueryLinker::make_tuples(const std::vector<std::string>& qvars) {
-    auto qit = qvars.begin();
-    Qvar qvar = *qit++; // current qvar
-
-    QvarList rest_qvars(qit, qvars.end());
-
-    // current qvar conditions
-    ConditionSet conditions = get_conditions(qvar);
-    TupleSet result;
-
-    if(rest_qvars.empty()) {
-        for(auto it = conditions.begin(); it != conditions.end(); ++it) {
-            ConditionTuplePtr new_tuple(new SimpleConditionTuple(*it));
-
-            result.insert(new_tuple);
-        }
+/*
+ * The tuples are built from the last query variable backwards. Each
+ * condition of a query variable is put in front of every tuple of the
+ * query variables after it that it agrees with.
+ */
+TupleTable SimpleQueryLinker::make_tuple_table(
+    const std::vector<std::string>& qvars) 
+{
+    TupleTable tuples(0);
+    tuples.add_row(NULL);
 
-        return result;
-    }
+    for(size_t i = qvars.size(); i > 0; --i) {
+        const Qvar& qvar = qvars[i - 1];
+        QvarList rest_qvars(qvars.begin() + i, qvars.end());
 
-    TupleSet rest_tuples = make_tuples(rest_qvars);
+        ConditionSet conditions = get_conditions(qvar);
 
-    for(auto cit=conditions.begin(); cit!=conditions.end(); ++cit) {
-        const ConditionPtr& condition = *cit;
+        TupleTable result(rest_qvars.size() + 1);
 
-        for(auto rit=rest_tuples.begin(); rit!=rest_tuples.end(); ++rit) {
-            ConditionTuplePtr tuple = *rit;
+        for(auto cit=conditions.begin(); cit!=conditions.end(); ++cit) {
+            const ConditionPtr& condition = *cit;
 
-            if(!validate_tuple(qvar, condition, rest_qvars, tuple)) continue;
+            for(size_t r = 0; r < tuples.size(); ++r) {
+                const ConditionPtr *rest = tuples.row(r);
 
-            ConditionTuplePtr new_tuple(new SimpleConditionTuple(condition, tuple));
+                if(!validate_tuple(qvar, condition, rest_qvars, rest)) continue;
 
-            result.insert(new_tuple);
+                result.add_row(condition, rest);
+            }
         }
+
+        tuples = std::move(result);
     }
 
-    return result;
+    tuples.sort_unique();
+    return tuples;
 }
 
 void SimpleQueryLinker::remove_condition(
     const std::string& qvar, const ConditionPtr& condition)
 {
-    ConditionSet& qvar_values = _qvar_table[qvar];
-    const std::set<std::string>& qvar_links = _qvar_link_table[qvar];
+    int id = find_qvar(qvar);
+    if(id == -1) return;
 
-    if(!qvar_values.has_element(condition)) return;
+    int condition_id = find_condition(id, condition);
+    if(condition_id == -1) return;
 
-    qvar_values.remove(condition);
+    queue_removal(id, condition_id);
+    propagate_removals();
+}
+
+/*
+ * Remove a condition from a query variable and queue it, so that its
+ * supports are updated by propagate_removals().
+ */
+void SimpleQueryLinker::queue_removal(int qvar, int condition) {
+    QvarState& state = _qvars[qvar];
+
+    if(!state.alive[condition]) return;
+
+    state.alive[condition] = false;
+    state.conditions_changed = true;
 
     /*
      * If it is a removal of the last condition in a qvar and
      * makes it empty, the whole PQL is then fall into an invalid state.
      */
-    if(qvar_values.is_empty()) {
+    if(--state.alive_count == 0) {
         invalidate_state();
     }
 
-    /*
-     * Iterate through the query variables that have linkage with this query variable
-     */
-    for(auto qit = qvar_links.begin(); qit != qvar_links.end(); ++qit) {
-        std::string current_link = *qit;
-
-        // clear the current link table and move that to local variable
-        ConditionSet linked_set = std::move(
-            _condition_link_table[QVarPair(qvar, current_link)][condition]);
-
-        // Debug: just to be sure it is emptied
-        _condition_link_table[QVarPair(qvar, current_link)][condition].clear();
-
-        if(linked_set.is_empty()) {
-            continue;
-        }
-
-        /*
-         * Iterate through the conditions in the iterated query variable that
-         * are linked to this condition.
-         */
-        for(ConditionSet::iterator cit = linked_set.begin();
-            cit != linked_set.end(); ++cit)
-        {
-            ConditionPtr current_condition = *cit;
+    _removals.push_back(std::make_pair(qvar, condition));
+}
 
-            break_link(current_link, qvar, current_condition, condition);
+/*
+ * Take the queued conditions off the counters of their supports until
+ * no more conditions are removed. A condition whose counter in any one
+ * neighbour drops to zero is removed as well. Each link is counted off
+ * at most once in each direction, so a cascade of removals is linear in
+ * the number of links it removes.
+ */
+void SimpleQueryLinker::propagate_removals() {
+    while(!_removals.empty()) {
+        int qvar = _removals.back().first;
+        int condition = _removals.back().second;
+        _removals.pop_back();
+
+        const std::vector<int>& qvar_links = _qvars[qvar].links;
+
+        for(auto lit = qvar_links.begin(); lit != qvar_links.end(); ++lit) {
+            const std::vector<int>& supports = _links[*lit].supports[condition];
+            QvarLinks& reverse = _links[_links[*lit].reverse];
+
+            for(auto it = supports.begin(); it != supports.end(); ++it) {
+                if(--reverse.counters[*it] == 0) {
+                    queue_removal(reverse.qvar, *it);
+                }
+            }
         }
     }
 }
 
 /*
- * Simple breaking of the link of condition1 in qvar with condition2.
- * if condition1 does not have any other link in qvar, return true 
- * to indicate that the break is complete.
+ * Break the link between condition1 in qvar1 and condition2 in qvar2, 
+ * and remove either condition if that was its last link to the other
+ * query variable.
  */
 void SimpleQueryLinker::break_link(
     const std::string& qvar1, const std::string& qvar2,
     const ConditionPtr& condition1, const ConditionPtr& condition2)
 {
-    ConditionSet& set1 = _condition_link_table[QVarPair(qvar1, qvar2)][condition1];
-    set1.remove(condition2);
-
-    if(set1.is_empty()) {
-        /*
-         * If there is no other condition link in condition1 to
-         * other conditions in qvar2, then condition1 is 
-         * invalidated and needs to be removed as well.
-         */
-        remove_condition(qvar1, condition1);
-    }
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    if(id1 == -1 || id2 == -1) return;
+
+    int links_id = find_links(id1, id2);
+    if(links_id == -1) return;
+
+    int condition_id1 = find_condition(id1, condition1);
+    int condition_id2 = find_condition(id2, condition2);
+    if(condition_id1 == -1 || condition_id2 == -1) return;
+
+    unlink_conditions(links_id, condition_id1, condition_id2);
+    propagate_removals();
 }
 
+/*
+ * Links are kept in both directions, so breaking one direction breaks
+ * both.
+ */
 void SimpleQueryLinker::break_both_links(
     const std::string& qvar1, const std::string& qvar2,
     const ConditionPtr& condition1, const ConditionPtr& condition2)
 {
     break_link(qvar1, qvar2, condition1, condition2);
-    break_link(qvar2, qvar1, condition2, condition1);
 }
 
 ConditionSet SimpleQueryLinker::get_linked_conditions(
     const std::string& qvar1, const std::string& qvar2,
     const ConditionPtr& condition1) 
 {
-    if(_condition_link_table[QVarPair(qvar1, qvar2)].count(condition1) > 0) {
-        return _condition_link_table[QVarPair(qvar1, qvar2)][condition1];
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    if(id1 == -1 || id2 == -1) return ConditionSet();
 
-    } else {
+    int links_id = find_links(id1, id2);
+    if(links_id == -1) return ConditionSet();
+
+    int condition_id1 = find_condition(id1, condition1);
+    if(condition_id1 == -1 || !_qvars[id1].alive[condition_id1]) {
         return ConditionSet();
     }
+
+    const QvarState& state2 = _qvars[id2];
+    const std::vector<int>& supports = _links[links_id].supports[condition_id1];
+
+    ConditionSet result;
+    for(auto it = supports.begin(); it != supports.end(); ++it) {
+        if(state2.alive[*it]) result.insert(state2.domain[*it]);
+    }
+
+    return result;
 }
+
 bool SimpleQueryLinker::cached_has_indirect_links(
     const std::string& qvar1, const std::string& qvar2)
 {
     return has_indirect_links(qvar1, qvar2);
-
-    QVarPair key(qvar1, qvar2);
-    if(_has_indirect_links_cache.count(key)) return _has_indirect_links_cache[key];
-
-    bool result = has_indirect_links(qvar1, qvar2);
-    _has_indirect_links_cache[key] = result;
-
-    return result;
 }
 
 ConditionSet SimpleQueryLinker::cached_get_indirect_links(
@@ -336,13 +526,17 @@ ConditionSet SimpleQueryLinker::cached_get_indirect_links(
     const ConditionPtr& condition1)
 {
     return get_indirect_links(qvar1, qvar2, condition1);
+}
 
-    std::pair<QVarPair, ConditionPtr> key(QVarPair(qvar1, qvar2), condition1);
+std::vector<bool> SimpleQueryLinker::make_visited_qvars(
+    const std::set<std::string>& visited_qvars)
+{
+    std::vector<bool> result(_qvars.size(), false);
 
-    if(_indirect_links_cache.count(key)) return _indirect_links_cache[key];
-    
-    ConditionSet result = get_indirect_links(qvar1, qvar2, condition1);
-    _indirect_links_cache[key] = result;
+    for(auto it = visited_qvars.begin(); it != visited_qvars.end(); ++it) {
+        int id = find_qvar(*it);
+        if(id != -1) result[id] = true;
+    }
 
     return result;
 }
@@ -351,16 +545,26 @@ bool SimpleQueryLinker::has_indirect_links(
     const std::string& qvar1, const std::string& qvar2,
     std::set<std::string> visited_qvars)
 {
-    if(has_link(qvar1, qvar2)) return true;
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    if(id1 == -1 || id2 == -1) return false;
+
+    return has_indirect_links(id1, id2, make_visited_qvars(visited_qvars));
+}
+
+bool SimpleQueryLinker::has_indirect_links(
+    int qvar1, int qvar2, std::vector<bool> visited_qvars)
+{
+    if(find_links(qvar1, qvar2) != -1) return true;
 
-    const std::set<std::string>& qvar1_links = _qvar_link_table[qvar1];
+    const std::vector<int>& qvar1_links = _qvars[qvar1].links;
 
-    for(auto qit = qvar1_links.begin(); qit != qvar1_links.end(); ++qit) {
-        std::string mid_qvar = *qit;
+    for(auto lit = qvar1_links.begin(); lit != qvar1_links.end(); ++lit) {
+        int mid_qvar = _links[*lit].neighbour;
 
-        if(visited_qvars.count(mid_qvar) != 0) continue;
+        if(visited_qvars[mid_qvar]) continue;
 
-        visited_qvars.insert(mid_qvar);
+        visited_qvars[mid_qvar] = true;
 
         if(has_indirect_links(mid_qvar, qvar2, visited_qvars)) {
             return true;
@@ -375,60 +579,150 @@ ConditionSet SimpleQueryLinker::get_indirect_links(
     const ConditionPtr& condition1, 
     std::set<std::string> visited_qvars)
 {
-    if(has_link(qvar1, qvar2)) {
-        return get_linked_conditions(qvar1, qvar2, condition1);
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    if(id1 == -1 || id2 == -1) return ConditionSet();
+
+    int condition_id1 = find_condition(id1, condition1);
+    if(condition_id1 == -1) return ConditionSet();
+
+    const QvarState& state2 = _qvars[id2];
+    std::vector<bool> found(state2.domain.size(), false);
+
+    collect_indirect_links(id1, id2, condition_id1, 
+        make_visited_qvars(visited_qvars), found);
+
+    std::set<ConditionPtr> result;
+    for(size_t i = 0; i < found.size(); ++i) {
+        if(found[i]) result.insert(result.end(), state2.domain[i]);
     }
 
-    ConditionSet result;
+    return ConditionSet(std::move(result));
+}
+
+/*
+ * Mark the conditions of qvar2 reachable from condition1 of qvar1
+ * through live links, going through the query variables not yet
+ * visited when there is no direct link.
+ */
+void SimpleQueryLinker::collect_indirect_links(
+    int qvar1, int qvar2, int condition1, 
+    std::vector<bool> visited_qvars, std::vector<bool>& result)
+{
+    if(!_qvars[qvar1].alive[condition1]) return;
+
+    int links_id = find_links(qvar1, qvar2);
 
-    const std::set<std::string>& qvar1_links = _qvar_link_table[qvar1];
+    if(links_id != -1) {
+        const std::vector<int>& supports = _links[links_id].supports[condition1];
+        const std::vector<bool>& alive = _qvars[qvar2].alive;
 
-    for(auto qit = qvar1_links.begin(); qit != qvar1_links.end(); ++qit) {
-        std::string mid_qvar = *qit;
+        for(auto it = supports.begin(); it != supports.end(); ++it) {
+            if(alive[*it]) result[*it] = true;
+        }
 
-        if(visited_qvars.count(mid_qvar) != 0) continue;
+        return;
+    }
 
-        visited_qvars.insert(mid_qvar);
+    const std::vector<int>& qvar1_links = _qvars[qvar1].links;
 
-        ConditionSet direct_links = get_linked_conditions(
-            qvar1, mid_qvar, condition1);
+    for(auto lit = qvar1_links.begin(); lit != qvar1_links.end(); ++lit) {
+        const QvarLinks& links = _links[*lit];
+        int mid_qvar = links.neighbour;
 
-        for(auto cit = direct_links.begin();
-            cit != direct_links.end(); ++cit)
-        {
-            result.union_with(get_indirect_links(mid_qvar, qvar2,
-                *cit, visited_qvars));
+        if(visited_qvars[mid_qvar]) continue;
+
+        visited_qvars[mid_qvar] = true;
+
+        const std::vector<int>& supports = links.supports[condition1];
+
+        for(auto it = supports.begin(); it != supports.end(); ++it) {
+            collect_indirect_links(mid_qvar, qvar2, *it, visited_qvars, result);
         }
     }
-    
-    return result;
+}
+
+/*
+ * Whether condition2 of qvar2 is among the conditions marked by 
+ * collect_indirect_links(), stopping at the first path found.
+ */
+bool SimpleQueryLinker::has_indirect_link(
+    int qvar1, int qvar2, int condition1, int condition2,
+    std::vector<bool> visited_qvars)
+{
+    if(!_qvars[qvar1].alive[condition1]) return false;
+
+    int links_id = find_links(qvar1, qvar2);
+    if(links_id != -1) return is_linked(links_id, condition1, condition2);
+
+    const std::vector<int>& qvar1_links = _qvars[qvar1].links;
+
+    for(auto lit = qvar1_links.begin(); lit != qvar1_links.end(); ++lit) {
+        const QvarLinks& links = _links[*lit];
+        int mid_qvar = links.neighbour;
+
+        if(visited_qvars[mid_qvar]) continue;
+
+        visited_qvars[mid_qvar] = true;
+
+        const std::vector<int>& supports = links.supports[condition1];
+
+        for(auto it = supports.begin(); it != supports.end(); ++it) {
+            if(has_indirect_link(mid_qvar, qvar2, *it, condition2, visited_qvars)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
 }
 
 bool SimpleQueryLinker::validate(
     const std::string& qvar1, const std::string& qvar2, 
     const ConditionPtr& condition1, const ConditionPtr& condition2)
 {
-    if(has_link(qvar1, qvar2)) {
-        return get_linked_conditions(qvar1, qvar2, condition1)
-            .has_element(condition2);
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    if(id1 == -1 || id2 == -1) return false;
 
-     } else {
-         return false;
-     }
-}
+    int links_id = find_links(id1, id2);
+    if(links_id == -1) return false;
 
-ConditionSet SimpleQueryLinker::get_conditions(const std::string& qvar) {
-    if(is_initialized(qvar)) return _qvar_table[qvar];
+    int condition_id1 = find_condition(id1, condition1);
+    int condition_id2 = find_condition(id2, condition2);
 
-    _qvar_table[qvar] = _global_set;
+    return condition_id1 != -1 && condition_id2 != -1 &&
+        is_linked(links_id, condition_id1, condition_id2);
+}
 
-    return _global_set;
+ConditionSet SimpleQueryLinker::get_conditions(const std::string& qvar) {
+    return get_condition_set(add_qvar(qvar, _global_set));
 }
 
 std::map<ConditionPtr, ConditionSet> SimpleQueryLinker::get_links(
     const std::string& qvar1, const std::string& qvar2)
 {
-    return _condition_link_table[QVarPair(qvar1, qvar2)];
+    std::map<ConditionPtr, ConditionSet> result;
+
+    int id1 = find_qvar(qvar1);
+    int id2 = find_qvar(qvar2);
+    if(id1 == -1 || id2 == -1) return result;
+
+    int links_id = find_links(id1, id2);
+    if(links_id == -1) return result;
+
+    const QvarState& state1 = _qvars[id1];
+
+    for(size_t i = 0; i < state1.domain.size(); ++i) {
+        if(!state1.alive[i]) continue;
+
+        ConditionSet linked = get_linked_conditions(
+            qvar1, qvar2, state1.domain[i]);
+
+        if(!linked.is_empty()) result[state1.domain[i]] = linked;
+    }
+
+    return result;
 }
 
 std::set<ConditionPair> SimpleQueryLinker::get_links_as_tuples(
@@ -436,19 +730,16 @@ std::set<ConditionPair> SimpleQueryLinker::get_links_as_tuples(
 {
     std::set<ConditionPair> result;
 
-    const std::map<ConditionPtr, ConditionSet>& link_table = 
-        _condition_link_table[QVarPair(qvar1, qvar2)];
+    std::map<ConditionPtr, ConditionSet> link_table = get_links(qvar1, qvar2);
 
     for(auto it=link_table.begin(); it!=link_table.end(); ++it) {
-        ConditionPtr condition1 = it->first;
+        const ConditionPtr& condition1 = it->first;
         const ConditionSet& condition2_set = it->second;
 
         for(auto it2=condition2_set.begin(); 
             it2!=condition2_set.end(); ++it2)
         {
-            ConditionPtr condition2 = *it2;
-
-            result.insert(ConditionPair(condition1, condition2));
+            result.insert(ConditionPair(condition1, *it2));
         }
     }
 
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include <string>
 #include <utility>
 #include "simple/linker.h"
@@ -53,9 +54,9 @@ class SimpleQueryLinker : public QueryLinker {
     bool validate_tuple(const Qvar& qvar1, 
         const ConditionPtr& condition1,
         const QvarList& rest_qvars,
-        ConditionTuplePtr tuple);
+        const ConditionPtr *row);
 
-    TupleSet make_tuples(const std::vector<std::string>& variables);
+    TupleTable make_tuple_table(const std::vector<std::string>& variables);
 
     bool add_link(const std::string& qvar1, const std::string& qvar2, 
         const ConditionPtr& condition1, const ConditionPtr& condition2);
@@ -115,29 +116,104 @@ class SimpleQueryLinker : public QueryLinker {
     void invalidate_state();
     
   private:
-    std::set< std::pair<QVarPair, ConditionPair> >
-    _valid_pair_cache;
+    /*
+     * The links from the conditions of one query variable to those of
+     * a neighbour, by the local IDs of the conditions on each side. The
+     * supports of a condition are the conditions of the neighbour it is
+     * linked to, and its counter is the number of them still alive.
+     * The lists keep the supports that died, which are only skipped, so
+     * that a removal never has to search a list. The reverse links are
+     * indexed by the reverse ID.
+     */
+    struct QvarLinks {
+        QvarLinks(int qvar, int neighbour, size_t size) :
+            qvar(qvar), neighbour(neighbour), reverse(-1),
+            supports(size), counters(size, 0)
+        { }
 
-    std::set< std::pair<QVarPair, ConditionPair> >
-    _invalid_pair_cache;
+        int qvar;
+        int neighbour;
+        int reverse;
 
-    std::map< QVarPair, bool > 
-    _has_indirect_links_cache;
-    
-    std::map< std::pair<QVarPair, ConditionPtr>,  ConditionSet> 
-    _indirect_links_cache;
+        std::vector< std::vector<int> > supports;
+        std::vector<int>                counters;
+    };
 
-    std::map< QVarPair, std::map<ConditionPtr, ConditionSet> >
-    _condition_link_table;
+    /*
+     * The conditions of a query variable get dense local IDs, in set
+     * order, when the variable is initialized. Conditions are only
+     * removed after that, so a removal clears the alive flag of its ID,
+     * and the condition set is rebuilt from the flags when asked for.
+     */
+    struct QvarState {
+        QvarState(const std::string& name, const ConditionSet& conditions) :
+            name(name), domain(conditions.begin(), conditions.end()),
+            alive(domain.size(), true), alive_count(domain.size()),
+            conditions(conditions), conditions_changed(false)
+        { }
 
-    std::map< std::string, std::set<std::string> >
-    _qvar_link_table;
-    
-    std::map< std::string, ConditionSet > 
-    _qvar_table;
+        std::string                 name;
+        std::vector<ConditionPtr>   domain;
+        std::vector<bool>           alive;
+        size_t                      alive_count;
+
+        ConditionSet                conditions;
+        bool                        conditions_changed;
+
+        std::vector<int>            links;
+    };
+
+    /*
+     * The ID of a query variable, or -1 if it is not initialized.
+     */
+    int find_qvar(const std::string& qvar) const;
+    int add_qvar(const std::string& qvar, const ConditionSet& conditions);
+
+    /*
+     * The ID of the links from qvar1 to qvar2, or -1 if they are not
+     * linked.
+     */
+    int find_links(int qvar1, int qvar2) const;
+    int add_links(int qvar1, int qvar2);
 
-    std::map< std::string, bool >
-    _initialize_table;
+    /*
+     * The local ID of a condition in a query variable, or -1 if it is 
+     * not one of its conditions.
+     */
+    int find_condition(int qvar, const ConditionPtr& condition) const;
+    const ConditionSet& get_condition_set(int qvar);
+
+    /*
+     * Link two conditions by their local IDs, in both directions.
+     */
+    void link_conditions(int links_id, int condition1, int condition2);
+    bool is_linked(int links_id, int condition1, int condition2) const;
+    void unlink_conditions(int links_id, int condition1, int condition2);
+
+    void queue_removal(int qvar, int condition);
+    void propagate_removals();
+
+    bool has_indirect_links(int qvar1, int qvar2, 
+        std::vector<bool> visited_qvars);
+
+    void collect_indirect_links(int qvar1, int qvar2, int condition1, 
+        std::vector<bool> visited_qvars, std::vector<bool>& result);
+
+    bool has_indirect_link(int qvar1, int qvar2, 
+        int condition1, int condition2, std::vector<bool> visited_qvars);
+
+    std::vector<bool> make_visited_qvars(
+        const std::set<std::string>& visited_qvars);
+
+    std::map<std::string, int>  _qvar_ids;
+    std::vector<QvarState>      _qvars;
+    std::vector<QvarLinks>      _links;
+
+    /*
+     * The query variables and local IDs of the removed conditions whose
+     * supports are not yet updated.
+     */
+    std::vector< std::pair<int, int> > _removals;
 
     bool _valid_state;
 
@@ -0,0 +1,345 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cctype>
+#include <memory>
+#include "impl/parser/incremental_parser.h"
+#include "impl/parser/parser.h"
+#include "impl/parser/iterator_tokenizer.h"
+#include "simple/util/ast_utils.h"
+
+namespace simple {
+namespace parser {
+
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::util;
+
+typedef IteratorTokenizer<std::string::const_iterator> StringTokenizer;
+
+static void skip_spaces(const std::string& source, size_t& pos, int& line) {
+    while(pos < source.size() && isspace(source[pos])) {
+        if(source[pos] == '\n') ++line;
+        ++pos;
+    }
+}
+
+static std::string read_identifier(const std::string& source, size_t& pos) {
+    size_t start = pos;
+    while(pos < source.size() && (isalnum(source[pos]) || source[pos] == '_')) {
+        ++pos;
+    }
+
+    return source.substr(start, pos - start);
+}
+
+bool split_procedures(const std::string& source, std::vector<ProcSource>& result) {
+    size_t pos = 0;
+    int line = 1;
+
+    skip_spaces(source, pos, line);
+
+    while(pos < source.size()) {
+        ProcSource proc;
+        proc.source_line = line;
+
+        size_t start = pos;
+        if(read_identifier(source, pos) != "procedure") return false;
+
+        skip_spaces(source, pos, line);
+        proc.name = read_identifier(source, pos);
+        if(proc.name.empty()) return false;
+
+        skip_spaces(source, pos, line);
+        if(pos == source.size() || source[pos] != '{') return false;
+
+        int depth = 0;
+        for(; pos < source.size(); ++pos) {
+            if(source[pos] == '\n') {
+                ++line;
+            } else if(source[pos] == '{') {
+                ++depth;
+            } else if(source[pos] == '}' && --depth == 0) {
+                ++pos;
+                break;
+            }
+        }
+
+        if(depth != 0) return false;
+
+        proc.text = source.substr(start, pos - start);
+        result.push_back(proc);
+
+        skip_spaces(source, pos, line);
+    }
+
+    return true;
+}
+
+/*
+ * Every statement of a parsed program is one of the Simple*Ast classes.
+ */
+static SimpleStatementAst* to_simple_statement(StatementAst *statement) {
+    if(AssignmentAst *assign = statement_cast<AssignmentAst>(statement)) {
+        return static_cast<SimpleAssignmentAst*>(assign);
+
+    } else if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+        return static_cast<SimpleWhileAst*>(loop);
+
+    } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+        return static_cast<SimpleIfAst*>(condition);
+
+    } else {
+        return static_cast<SimpleCallAst*>(statement_cast<CallAst>(statement));
+    }
+}
+
+/*
+ * Move a statement list parsed into a temporary procedure over to the
+ * procedure that takes it as its body.
+ */
+static void adopt_statements(StatementAst *statement, 
+    ProcAst *proc, ProcAst *parsed_proc)
+{
+    while(statement != NULL) {
+        to_simple_statement(statement)->set_proc(proc);
+
+        if(CallAst *call = statement_cast<CallAst>(statement)) {
+            if(call->get_proc_called() == parsed_proc) {
+                static_cast<SimpleCallAst*>(call)->set_proc_called(proc);
+            }
+
+        } else if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            adopt_statements(loop->get_body(), proc, parsed_proc);
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            adopt_statements(condition->get_then_branch(), proc, parsed_proc);
+            adopt_statements(condition->get_else_branch(), proc, parsed_proc);
+        }
+
+        statement = statement->next();
+    }
+}
+
+/*
+ * Number the statements of a list in the order the parser does, which
+ * is each statement before the statements nested in it.
+ */
+static void renumber_statements(StatementAst *statement, bool kept,
+    int source_offset, int& statement_line,
+    LineTable& line_table, std::map<int, int>& line_mapping)
+{
+    while(statement != NULL) {
+        SimpleStatementAst *simple_statement = to_simple_statement(statement);
+
+        if(kept) line_mapping[statement->get_statement_line()] = statement_line;
+
+        simple_statement->set_statement_line(statement_line);
+        simple_statement->set_source_line(
+            statement->get_source_line() + source_offset);
+        line_table[statement_line] = statement;
+        ++statement_line;
+
+        if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            renumber_statements(loop->get_body(), kept, source_offset, 
+                statement_line, line_table, line_mapping);
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            renumber_statements(condition->get_then_branch(), kept, source_offset, 
+                statement_line, line_table, line_mapping);
+            renumber_statements(condition->get_else_branch(), kept, source_offset, 
+                statement_line, line_table, line_mapping);
+        }
+
+        statement = statement->next();
+    }
+}
+
+IncrementalParser::IncrementalParser(const std::string& source) {
+    parse_program(source);
+}
+
+SimpleRoot IncrementalParser::get_ast() {
+    return _ast;
+}
+
+const LineTable& IncrementalParser::get_statement_line_table() {
+    return _line_table;
+}
+
+const std::map<int, int>& IncrementalParser::get_line_mapping() {
+    return _line_mapping;
+}
+
+const std::set<ProcAst*>& IncrementalParser::get_changed_procs() {
+    return _changed_procs;
+}
+
+bool IncrementalParser::is_new_program() {
+    return _new_program;
+}
+
+std::vector<StatementAst*> IncrementalParser::get_old_bodies() {
+    std::vector<StatementAst*> result;
+    for(size_t i = 0; i < _old_bodies.size(); ++i) {
+        result.push_back(_old_bodies[i].get());
+    }
+
+    return result;
+}
+
+/*
+ * Parse the whole source as a new program. Nothing is changed if the
+ * parser throws.
+ */
+void IncrementalParser::parse_program(const std::string& source) {
+    SimpleParser parser(new StringTokenizer(source.begin(), source.end()));
+    SimpleRoot ast = parser.parse_program();
+
+    std::vector<ProcSource> sources;
+    if(!split_procedures(source, sources)) sources.clear();
+
+    _ast = ast;
+    _sources.swap(sources);
+    _line_table = parser.get_statement_line_table();
+
+    _new_program = true;
+    _line_mapping.clear();
+    _changed_procs.clear();
+    _old_bodies.clear();
+
+    for(SimpleRoot::iterator it = _ast.begin(); it != _ast.end(); ++it) {
+        _changed_procs.insert(*it);
+    }
+}
+
+bool IncrementalParser::update(const std::string& source) {
+    std::vector<ProcSource> sources;
+    bool same_procs = split_procedures(source, sources) && 
+        sources.size() == _sources.size();
+
+    bool changed = false;
+    for(size_t i = 0; same_procs && i < sources.size(); ++i) {
+        same_procs = sources[i].name == _sources[i].name;
+        changed = changed || sources[i].text != _sources[i].text ||
+            sources[i].source_line != _sources[i].source_line;
+    }
+
+    if(same_procs && !changed) return false;
+
+    if(!same_procs || !parse_changed_procs(sources)) {
+        parse_program(source);
+        return true;
+    }
+
+    renumber(sources);
+    _sources.swap(sources);
+
+    return true;
+}
+
+/*
+ * Parse every procedure whose text changed against the procedures of
+ * the program, and only replace their bodies once all of them parsed,
+ * so that a procedure that fails to parse leaves the program as it was.
+ * The old bodies are kept alive until the next update, since the 
+ * indexes built on them are patched after this update.
+ */
+bool IncrementalParser::parse_changed_procs(const std::vector<ProcSource>& sources) {
+    std::map<std::string, SimpleProcAst*> procs_table;
+    for(SimpleRoot::iterator it = _ast.begin(); it != _ast.end(); ++it) {
+        procs_table[(*it)->get_name()] = static_cast<SimpleProcAst*>(*it);
+    }
+
+    std::vector< std::shared_ptr<SimpleProcAst> > parsed_procs;
+    std::vector<SimpleProcAst*> procs;
+
+    for(size_t i = 0; i < sources.size(); ++i) {
+        if(sources[i].text == _sources[i].text) continue;
+
+        std::map<std::string, SimpleProcAst*> other_procs(procs_table);
+        other_procs.erase(sources[i].name);
+
+        const std::string& text = sources[i].text;
+
+        try {
+            SimpleParser parser(new StringTokenizer(text.begin(), text.end()), 
+                other_procs);
+
+            std::shared_ptr<SimpleProcAst> proc(parser.parse_proc());
+            parser.current_token_as<EOFToken>();
+
+            if(parser.get_procs_table().size() != procs_table.size()) {
+                return false;
+            }
+
+            parsed_procs.push_back(proc);
+            procs.push_back(procs_table[sources[i].name]);
+
+        } catch(ParseError&) {
+            return false;
+        }
+    }
+
+    _new_program = false;
+    _changed_procs.clear();
+    _old_bodies.clear();
+
+    for(size_t i = 0; i < procs.size(); ++i) {
+        _old_bodies.push_back(std::shared_ptr<StatementAst>(
+            procs[i]->release_statement()));
+
+        StatementAst *body = parsed_procs[i]->release_statement();
+        procs[i]->set_first_statement(body);
+        adopt_statements(body, procs[i], parsed_procs[i].get());
+
+        _changed_procs.insert(procs[i]);
+    }
+
+    return true;
+}
+
+/*
+ * Number the statements of all procedures again in source order. The
+ * statements of the procedures that were kept are shifted by the lines
+ * their procedure moved by, and the statements that were parsed again
+ * by the line their procedure starts on.
+ */
+void IncrementalParser::renumber(const std::vector<ProcSource>& sources) {
+    LineTable line_table;
+    std::map<int, int> line_mapping;
+    int statement_line = 1;
+
+    for(size_t i = 0; i < sources.size(); ++i) {
+        ProcAst *proc = _ast.get_proc(sources[i].name);
+        bool kept = _changed_procs.count(proc) == 0;
+
+        int source_offset = kept ? 
+            sources[i].source_line - _sources[i].source_line :
+            sources[i].source_line - 1;
+
+        renumber_statements(proc->get_statement(), kept, source_offset, 
+            statement_line, line_table, line_mapping);
+    }
+
+    _line_table.swap(line_table);
+    _line_mapping.swap(line_mapping);
+}
+
+} // namespace parser
+} // namespace simple
@@ -0,0 +1,123 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <set>
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include "simple/ast.h"
+#include "impl/ast.h"
+
+namespace simple {
+namespace parser {
+
+using namespace simple;
+using namespace simple::impl;
+
+/*
+ * The source text of one procedure, from its "procedure" keyword to its
+ * closing brace, and the source line it starts on.
+ */
+struct ProcSource {
+    std::string name;
+    std::string text;
+    int         source_line;
+};
+
+/*
+ * Split a source into the texts of its procedures. Returns false if the
+ * source is not a sequence of procedures with balanced braces, in which
+ * case it is left to the parser to report the error.
+ */
+bool split_procedures(const std::string& source, std::vector<ProcSource>& result);
+
+/*
+ * IncrementalParser keeps a parsed program together with the source text
+ * of each procedure, so that a new version of the source can be applied
+ * at procedure granularity.
+ *
+ * Only the procedures whose text changed are parsed again. Once all of
+ * them parsed, each new body is moved into the existing procedure AST,
+ * so calls into it from the unchanged procedures stay valid. The 
+ * statements of the unchanged procedures are kept as they are and only
+ * renumbered, and the mapping from their old to their new statement 
+ * lines is recorded.
+ *
+ * If procedures are added, removed or reordered, or a changed procedure
+ * calls a procedure that does not exist, the whole source is parsed
+ * again as a new program. A source that fails to parse leaves the
+ * program unchanged.
+ */
+class IncrementalParser {
+  public:
+    IncrementalParser(const std::string& source);
+
+    /*
+     * Apply a new version of the source. Returns false if no procedure 
+     * changed or moved, in which case the program is left as it is.
+     */
+    bool update(const std::string& source);
+
+    SimpleRoot get_ast();
+    const LineTable& get_statement_line_table();
+
+    /*
+     * The new statement line of every statement kept by the last update,
+     * indexed by its old statement line.
+     */
+    const std::map<int, int>& get_line_mapping();
+
+    /*
+     * The procedures parsed again by the last update. After a full parse
+     * this is every procedure.
+     */
+    const std::set<ProcAst*>& get_changed_procs();
+
+    /*
+     * Whether the last update parsed the whole source as a new program,
+     * instead of replacing the bodies of the changed procedures.
+     */
+    bool is_new_program();
+
+    /*
+     * The bodies replaced by the last update. They stay alive until the
+     * next update, so that the indexes built on them can be patched.
+     */
+    std::vector<StatementAst*> get_old_bodies();
+
+  private:
+    void parse_program(const std::string& source);
+    bool parse_changed_procs(const std::vector<ProcSource>& sources);
+    void renumber(const std::vector<ProcSource>& sources);
+
+    SimpleRoot                  _ast;
+    std::vector<ProcSource>     _sources;
+    LineTable                   _line_table;
+
+    bool                        _new_program;
+    std::map<int, int>          _line_mapping;
+    std::set<ProcAst*>          _changed_procs;
+
+    std::vector< std::shared_ptr<StatementAst> > _old_bodies;
+};
+
+} // namespace parser
+} // namespace simple
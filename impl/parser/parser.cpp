@@ -32,6 +32,16 @@ SimpleParser::SimpleParser(SimpleTokenizer *tokenizer) :
     next_token();
 }
 
+SimpleParser::SimpleParser(SimpleTokenizer *tokenizer,
+    const std::map<std::string, SimpleProcAst*>& procs_table) :
+    _procs_table(procs_table),
+    _source_line(1),
+    _statement_line(1),
+    _tokenizer(tokenizer)
+{ 
+    next_token();
+}
+
 SimpleRoot SimpleParser::parse_program() {
     while(!current_token_is<EOFToken>()) {
         _procs.push_back(parse_proc());
@@ -40,6 +40,13 @@ class SimpleParser {
   public:
     SimpleParser(SimpleTokenizer *tokenizer);
 
+    /*
+     * Resolve procedure names against procedures that are already
+     * parsed, for parsing a single procedure of a loaded program.
+     */
+    SimpleParser(SimpleTokenizer *tokenizer,
+        const std::map<std::string, SimpleProcAst*>& procs_table);
+
     SimpleRoot parse_program();
 
     ExprAst* parse_expr();
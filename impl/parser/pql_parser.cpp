@@ -16,6 +16,7 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <sstream>
 #include <utility>
 #include <algorithm>
 #include <functional> 
@@ -555,10 +556,13 @@ PredicatePtr SimplePqlParser::get_predicate(const std::string& name) {
 }
 
 StatementAst* SimplePqlParser::get_statement(int line) {
-    if(_line_table.count(line) == 0) {
-        throw ParseError("No statement found at line " + line);
+    LineTable::const_iterator it = _line_table.find(line);
+    if(it == _line_table.end()) {
+        std::ostringstream message;
+        message << "No statement found at line " << line;
+        throw ParseError(message.str());
     }
-    return _line_table[line];
+    return it->second;
 }
 
 std::string SimplePqlParser::string_trim(std::string str) {
@@ -167,6 +167,32 @@ void PredicateGenerator<Predicate>::filter_statement_list(StatementAst *statemen
     }
 }
 
+BitSetPredicate::BitSetPredicate(std::shared_ptr<PredicateDomain> domain,
+        PredicateDomain::EntityKind kind, const std::string& name) :
+    _domain(domain), _entities(domain->get_entities(kind)),
+    _global_set(domain->to_condition_set(_entities)), _name(name)
+{ }
+
+const ConditionSet& BitSetPredicate::global_set() {
+    return _global_set;
+}
+
+void BitSetPredicate::filter(ConditionSet& conditions) {
+    BitSet ids = _domain->to_bit_set(conditions);
+    ids.intersect_with(_entities);
+
+    conditions = _domain->to_condition_set(ids);
+}
+
+bool BitSetPredicate::validate(ConditionPtr condition) {
+    size_t id;
+    return _domain->find_id(condition, id) && _entities.test(id);
+}
+
+std::string BitSetPredicate::get_predicate_name() {
+    return _name;
+}
+
 WildCardPredicate::WildCardPredicate() { }
 
 std::string WildCardPredicate::get_name() {
@@ -395,6 +421,26 @@ template class PredicateGenerator<PlusPredicate>;
 template class PredicateGenerator<TimesPredicate>;
 template class PredicateGenerator<OperatorPredicate>;
 
+bool get_predicate_condition_type(SimplePredicate *pred, ConditionType& type) {
+    std::string name = pred->get_predicate_name();
+
+    if(name == "statement" || name == "assign" || name == "if" || 
+       name == "while" || name == "call") 
+    {
+        type = StatementCT;
+    } else if(name == "procedure") {
+        type = ProcCT;
+    } else if(name == "variable") {
+        type = VariableCT;
+    } else if(name == "constant") {
+        type = ConstantCT;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
 
 } // namespace impl
 } // namespace simple
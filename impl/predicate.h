@@ -23,6 +23,7 @@
 #include "simple/condition_set.h"
 #include "simple/predicate.h"
 #include "impl/condition.h"
+#include "impl/predicate_domain.h"
 
 namespace simple {
 namespace impl {
@@ -62,6 +63,30 @@ class PredicateGenerator :
     std::unique_ptr<Predicate> _pred;
 };
 
+/*
+ * A predicate that accepts the entities of one kind in a predicate 
+ * domain, stored as a bit set of their IDs. Validating a condition is
+ * a lookup of its ID, and filtering is an intersection of bit sets.
+ */
+class BitSetPredicate : public SimplePredicate {
+  public:
+    BitSetPredicate(std::shared_ptr<PredicateDomain> domain,
+        PredicateDomain::EntityKind kind, const std::string& name);
+
+    const ConditionSet& global_set();
+
+    void filter(ConditionSet& conditions);
+    bool validate(ConditionPtr condition);
+
+    std::string get_predicate_name();
+
+  private:
+    std::shared_ptr<PredicateDomain>    _domain;
+    const BitSet&                       _entities;
+    ConditionSet                        _global_set;
+    std::string                         _name;
+};
+
 /*
  * A predicate that accepts everything.
  */
@@ -256,5 +281,12 @@ bool PlusPredicate::evaluate<OperatorCondition>(OperatorCondition *op);
 template <>
 bool TimesPredicate::evaluate<OperatorCondition>(OperatorCondition *op);
 
+/*
+ * Find the condition type of the conditions accepted by a predicate from
+ * its name. Returns false if the predicate may accept conditions of more
+ * than one type.
+ */
+bool get_predicate_condition_type(SimplePredicate *pred, ConditionType& type);
+
 }
 }
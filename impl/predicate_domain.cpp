@@ -0,0 +1,238 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "impl/predicate_domain.h"
+#include "impl/condition.h"
+#include "simple/util/expr_util.h"
+#include "simple/util/condition_utils.h"
+#include "simple/util/ast_utils.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+PredicateDomain::PredicateDomain(SimpleRoot ast) : 
+    _kind_ids(EntityKindCount)
+{
+    for(SimpleRoot::iterator it = ast.begin(); it != ast.end(); ++it) {
+        add_entity(new SimpleProcCondition(*it), ProcEK);
+        index_statement_list((*it)->get_statement());
+    }
+
+    std::vector<size_t>& calls = _kind_ids[CallEK];
+    for(size_t i = 0; i < calls.size(); ++i) {
+        CallAst *call = statement_cast<CallAst>(condition_cast<StatementCondition>(
+            _conditions[calls[i]].get())->get_statement_ast());
+
+        size_t proc_id;
+        if(call->get_proc_called() != NULL && 
+           find_id(new SimpleProcCondition(call->get_proc_called()), proc_id)) 
+        {
+            _called_procs.insert(calls[i], proc_id);
+        }
+    }
+
+    std::vector<size_t>& operators = _kind_ids[OperatorEK];
+    for(size_t i = 0; i < operators.size(); ++i) {
+        switch(condition_cast<OperatorCondition>(
+            _conditions[operators[i]].get())->get_operator()) 
+        {
+            case '+':
+                _kind_ids[PlusEK].push_back(operators[i]);
+                break;
+            case '-':
+                _kind_ids[MinusEK].push_back(operators[i]);
+                break;
+            case '*':
+                _kind_ids[TimesEK].push_back(operators[i]);
+                break;
+            default:
+                break;
+        }
+    }
+
+    for(size_t id = 0; id < _conditions.size(); ++id) {
+        _kind_ids[WildcardEK].push_back(id);
+    }
+
+    _entities.assign(EntityKindCount, BitSet(_conditions.size()));
+
+    for(size_t kind = 0; kind < _kind_ids.size(); ++kind) {
+        std::vector<size_t>& ids = _kind_ids[kind];
+        for(size_t i = 0; i < ids.size(); ++i) {
+            _entities[kind].set(ids[i]);
+        }
+    }
+
+    _kind_ids.clear();
+}
+
+size_t PredicateDomain::size() const {
+    return _conditions.size();
+}
+
+const BitSet& PredicateDomain::get_entities(EntityKind kind) const {
+    return _entities[kind];
+}
+
+bool PredicateDomain::find_id(const ConditionPtr& condition, size_t& id) const {
+    const size_t *found = _ids.find(condition);
+    if(found == NULL) return false;
+
+    id = *found;
+    return true;
+}
+
+ConditionPtr PredicateDomain::get_condition(size_t id) const {
+    return _conditions[id];
+}
+
+const std::string& PredicateDomain::get_name(size_t id) const {
+    return _names[id];
+}
+
+void PredicateDomain::append_name(
+    const ConditionPtr& condition, std::string& buffer) const
+{
+    size_t id;
+    if(find_id(condition, id) && !_names[id].empty()) {
+        buffer += _names[id];
+    } else {
+        buffer += condition_to_string(condition.get());
+    }
+}
+
+bool PredicateDomain::find_called_proc(size_t call_id, size_t& proc_id) const {
+    const size_t *found = _called_procs.find(call_id);
+    if(found == NULL) return false;
+
+    proc_id = *found;
+    return true;
+}
+
+BitSet PredicateDomain::to_bit_set(const ConditionSet& conditions) const {
+    BitSet result(_conditions.size());
+
+    for(ConditionSet::iterator it = conditions.begin(); 
+        it != conditions.end(); ++it)
+    {
+        size_t id;
+        if(find_id(*it, id)) result.set(id);
+    }
+
+    return result;
+}
+
+ConditionSet PredicateDomain::to_condition_set(const BitSet& ids) const {
+    std::set<ConditionPtr> result;
+
+    for(size_t id = ids.next(0); id < ids.size(); id = ids.next(id + 1)) {
+        result.insert(result.end(), _conditions[id]);
+    }
+
+    return ConditionSet(std::move(result));
+}
+
+void PredicateDomain::visit_assignment(AssignmentAst *assign) {
+    add_statement(assign, AssignEK);
+    add_entity(new SimpleVariableCondition(*assign->get_variable()), VariableEK);
+
+    assign->get_expr()->accept_expr_visitor(this);
+}
+
+void PredicateDomain::visit_if(IfAst *condition) {
+    add_statement(condition, IfEK);
+    add_entity(new SimpleVariableCondition(*condition->get_variable()), VariableEK);
+
+    index_statement_list(condition->get_then_branch());
+    index_statement_list(condition->get_else_branch());
+}
+
+void PredicateDomain::visit_while(WhileAst *loop) {
+    add_statement(loop, WhileEK);
+    add_entity(new SimpleVariableCondition(*loop->get_variable()), VariableEK);
+
+    index_statement_list(loop->get_body());
+}
+
+void PredicateDomain::visit_call(CallAst *call) {
+    add_statement(call, CallEK);
+}
+
+void PredicateDomain::visit_variable(VariableAst *var) {
+    index_expr(var);
+    add_entity(new SimpleVariableCondition(*var->get_variable()), VariableEK);
+}
+
+void PredicateDomain::visit_const(ConstAst *constant) {
+    index_expr(constant);
+    add_entity(new SimpleConstantCondition(*constant->get_constant()), ConstantEK);
+}
+
+void PredicateDomain::visit_binary_op(BinaryOpAst *bin) {
+    index_expr(bin);
+    add_entity(new SimpleOperatorCondition(bin->get_op()), OperatorEK);
+
+    bin->get_lhs()->accept_expr_visitor(this);
+    bin->get_rhs()->accept_expr_visitor(this);
+}
+
+void PredicateDomain::index_statement_list(StatementAst *statement) {
+    while(statement != NULL) {
+        statement->accept_statement_visitor(this);
+        statement = statement->next();
+    }
+}
+
+/*
+ * Every subexpression is a pattern. The pattern conditions own their
+ * expressions, so the subexpression is cloned.
+ */
+void PredicateDomain::index_expr(ExprAst *expr) {
+    add_entity(new SimplePatternCondition(clone_expr(expr)), PatternEK);
+}
+
+void PredicateDomain::add_statement(StatementAst *statement, EntityKind kind) {
+    size_t id = add_entity(new SimpleStatementCondition(statement), kind);
+    _kind_ids[StatementEK].push_back(id);
+}
+
+/*
+ * Get the ID of an entity, adding it to the domain if it is new. A 
+ * variable or constant that is already in the domain keeps its ID.
+ */
+size_t PredicateDomain::add_entity(SimpleCondition *condition, EntityKind kind) {
+    ConditionPtr entity(condition);
+
+    const size_t *found = _ids.find(entity);
+    if(found != NULL) return *found;
+
+    size_t id = _conditions.size();
+    _conditions.push_back(entity);
+    _names.push_back(kind == PatternEK ? 
+        std::string() : condition_to_string(condition));
+    _ids.insert(entity, id);
+    _kind_ids[kind].push_back(id);
+
+    return id;
+}
+
+} // namespace impl
+} // namespace simple
@@ -0,0 +1,131 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "simple/ast.h"
+#include "simple/condition.h"
+#include "simple/condition_set.h"
+#include "simple/util/bit_set.h"
+#include "simple/util/relation_index.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * PredicateDomain numbers the procedures, statements, variables,
+ * constants, expressions and operators of a program with dense IDs in
+ * a single pass over the AST, and keeps one condition for each of them
+ * that all predicates share. The entities of each kind are a bit set 
+ * over these IDs, and the wildcard kind has every ID.
+ */
+class PredicateDomain : public StatementVisitor, public ExprVisitor {
+  public:
+    enum EntityKind {
+        ProcEK,
+        StatementEK,
+        AssignEK,
+        WhileEK,
+        IfEK,
+        CallEK,
+        VariableEK,
+        ConstantEK,
+        PatternEK,
+        OperatorEK,
+        PlusEK,
+        MinusEK,
+        TimesEK,
+        WildcardEK,
+        EntityKindCount
+    };
+
+    PredicateDomain(SimpleRoot ast);
+
+    size_t size() const;
+
+    const BitSet& get_entities(EntityKind kind) const;
+
+    /*
+     * Get the ID of a condition. Returns false if it is not in the 
+     * domain.
+     */
+    bool find_id(const ConditionPtr& condition, size_t& id) const;
+
+    ConditionPtr get_condition(size_t id) const;
+
+    /*
+     * The rendered name of an entity, which is its statement line, name
+     * or value, rendered once when the domain is built. Expressions are
+     * not rendered and have an empty name.
+     */
+    const std::string& get_name(size_t id) const;
+
+    /*
+     * Append the rendered name of a condition to a buffer. A condition
+     * without a rendered name is printed.
+     */
+    void append_name(const ConditionPtr& condition, std::string& buffer) const;
+
+    /*
+     * Get the ID of the procedure called by a call statement. Returns
+     * false if the entity is not a call to a procedure in the domain.
+     */
+    bool find_called_proc(size_t call_id, size_t& proc_id) const;
+
+    /*
+     * Convert between condition sets and bit sets of IDs. Conditions
+     * that are not in the domain are dropped.
+     */
+    BitSet to_bit_set(const ConditionSet& conditions) const;
+    ConditionSet to_condition_set(const BitSet& ids) const;
+
+    void visit_assignment(AssignmentAst *assign);
+    void visit_if(IfAst *condition);
+    void visit_while(WhileAst *loop);
+    void visit_call(CallAst *call);
+
+    void visit_variable(VariableAst *var);
+    void visit_const(ConstAst *val);
+    void visit_binary_op(BinaryOpAst *bin);
+
+  private:
+    void index_statement_list(StatementAst *statement);
+    void index_expr(ExprAst *expr);
+    void add_statement(StatementAst *statement, EntityKind kind);
+    size_t add_entity(SimpleCondition *condition, EntityKind kind);
+
+    std::vector<ConditionPtr>           _conditions;
+    std::vector<std::string>            _names;
+    HashIndex<ConditionPtr, size_t>     _ids;
+    HashIndex<size_t, size_t>           _called_procs;
+
+    /*
+     * The IDs of each kind are only collected during the pass, since
+     * the size of the bit sets is not known until it is done.
+     */
+    std::vector< std::vector<size_t> >  _kind_ids;
+    std::vector<BitSet>                 _entities;
+};
+
+} // namespace impl
+} // namespace simple
@@ -8,21 +8,39 @@ namespace impl {
 using namespace simple;
 
 PredicateTable create_predicate_table(SimpleRoot ast) {
+    return create_predicate_table(
+        std::shared_ptr<PredicateDomain>(new PredicateDomain(ast)));
+}
+
+PredicateTable create_predicate_table(std::shared_ptr<PredicateDomain> domain) {
     PredicateTable pred_table;
 
-    pred_table["wildcard"] = PredicatePtr(new SimpleWildCardPredicate(ast));
-    pred_table["procedure"] = PredicatePtr(new SimpleProcPredicate(ast));
-    pred_table["statement"] = PredicatePtr(new SimpleStatementPredicate(ast));
-    pred_table["assign"] = PredicatePtr(new SimpleAssignmentPredicate(ast));
-    pred_table["while"] = PredicatePtr(new SimpleWhilePredicate(ast));
-    pred_table["if"] = PredicatePtr(new SimpleIfPredicate(ast));
-    pred_table["call"] = PredicatePtr(new SimpleCallPredicate(ast));
-    pred_table["var"] = PredicatePtr(new SimpleVariablePredicate(ast));
-    pred_table["const"] = PredicatePtr(new SimpleConstantPredicate(ast));
-    pred_table["operator"] = PredicatePtr(new SimpleOperatorPredicate(ast));
-    pred_table["minus"] = PredicatePtr(new SimpleMinusPredicate(ast));
-    pred_table["plus"] = PredicatePtr(new SimplePlusPredicate(ast));
-    pred_table["times"] = PredicatePtr(new SimpleTimesPredicate(ast));
+    pred_table["wildcard"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::WildcardEK, WildCardPredicate::get_name()));
+    pred_table["procedure"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::ProcEK, ProcPredicate::get_name()));
+    pred_table["statement"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::StatementEK, StatementPredicate::get_name()));
+    pred_table["assign"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::AssignEK, AssignPredicate::get_name()));
+    pred_table["while"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::WhileEK, WhilePredicate::get_name()));
+    pred_table["if"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::IfEK, IfPredicate::get_name()));
+    pred_table["call"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::CallEK, CallPredicate::get_name()));
+    pred_table["var"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::VariableEK, VariablePredicate::get_name()));
+    pred_table["const"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::ConstantEK, ConstantPredicate::get_name()));
+    pred_table["operator"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::OperatorEK, OperatorPredicate::get_name()));
+    pred_table["minus"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::MinusEK, MinusPredicate::get_name()));
+    pred_table["plus"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::PlusEK, PlusPredicate::get_name()));
+    pred_table["times"] = PredicatePtr(new BitSetPredicate(
+        domain, PredicateDomain::TimesEK, TimesPredicate::get_name()));
 
     return pred_table;
 }
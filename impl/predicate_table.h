@@ -1,7 +1,9 @@
 
 #pragma once
 
+#include <memory>
 #include "simple/predicate.h"
+#include "impl/predicate_domain.h"
 
 namespace simple {
 namespace impl {
@@ -10,5 +12,10 @@ using namespace simple;
 
 PredicateTable create_predicate_table(SimpleRoot ast);
 
+/*
+ * Create the predicate table over an existing predicate domain.
+ */
+PredicateTable create_predicate_table(std::shared_ptr<PredicateDomain> domain);
+
 }
 }
\ No newline at end of file
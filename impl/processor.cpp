@@ -17,6 +17,7 @@
  */
 
 #include "impl/processor.h"
+#include "impl/predicate.h"
 #include "simple/util/set_utils.h"
 
 namespace simple {
@@ -29,9 +30,21 @@ QueryProcessor::QueryProcessor(
         const std::shared_ptr<QueryLinker>& linker,
         std::map<Qvar, PredicatePtr> predicates,
         PredicatePtr wildcard_pred) :
-    _linker(linker), _wildcard_pred(wildcard_pred)
+    _linker(linker), _predicates(predicates), _wildcard_pred(wildcard_pred)
 { }
 
+/*
+ * Find the condition type of a query variable from its predicate. 
+ * Returns false if the query variable has no predicate or its predicate
+ * may hold conditions of more than one type.
+ */
+bool QueryProcessor::get_qvar_type(const std::string& qvar, ConditionType& type) {
+    std::map<std::string, PredicatePtr>::iterator it = _predicates.find(qvar);
+    if(it == _predicates.end()) return false;
+
+    return get_predicate_condition_type(it->second.get(), type);
+}
+
 class SolveClauseVisitorTraits {
   public:
     typedef bool            ResultType;
@@ -82,11 +95,24 @@ void QueryProcessor::solve_clause<PqlVariableTerm, PqlVariableTerm>(
         ConditionSet conditions = get_qvar(qvar1);
         ConditionSet new_conditions;
 
-        for(ConditionSet::iterator cit = conditions.begin();
-                cit != conditions.end(); ++cit)
-        {
-            if(solver->validate(*cit, *cit)) {
-                new_conditions.insert(*cit);
+        ConditionType type;
+        if(get_qvar_type(qvar1, type)) {
+            TypedValidator validator = solver->get_validator(type, type);
+
+            for(ConditionSet::iterator cit = conditions.begin();
+                    cit != conditions.end(); ++cit)
+            {
+                if(validator.validate(*cit, *cit)) {
+                    new_conditions.insert(*cit);
+                }
+            }
+        } else {
+            for(ConditionSet::iterator cit = conditions.begin();
+                    cit != conditions.end(); ++cit)
+            {
+                if(solver->validate(*cit, *cit)) {
+                    new_conditions.insert(*cit);
+                }
             }
         }
         _linker->update_results(qvar1, new_conditions);
@@ -97,25 +123,9 @@ void QueryProcessor::solve_clause<PqlVariableTerm, PqlVariableTerm>(
         std::set<ConditionPair> links;
 
         if(conditions1.get_size() <= conditions2.get_size()) {
-            for(auto it = conditions1.begin(); it != conditions1.end(); ++it) {
-                ConditionPtr left = *it;
-                ConditionSet right_result = solver->solve_right(left);
-                right_result.intersect_with(conditions2);
-
-                for(auto it2=right_result.begin(); it2 != right_result.end(); ++it2) {
-                    links.insert(ConditionPair(left, *it2));
-                }
-            }
+            links = solver->solve_right_batch(conditions1, conditions2);
         } else {
-            for(auto it = conditions2.begin(); it != conditions2.end(); ++it) {
-                ConditionPtr right = *it;
-                ConditionSet left_result = solver->solve_left(right);
-                left_result.intersect_with(conditions1);
-
-                for(auto it2=left_result.begin(); it2 != left_result.end(); ++it2) {
-                    links.insert(ConditionPair(*it2, right));
-                }
-            }
+            links = solver->solve_left_batch(conditions2, conditions1);
         }
 
         _linker->update_links(qvar1, qvar2, links);
@@ -131,16 +141,9 @@ void QueryProcessor::solve_clause<PqlWildcardTerm, PqlWildcardTerm>(
         QuerySolver *solver,
         PqlWildcardTerm *term1, PqlWildcardTerm *term2)
 {
-    ConditionSet left = _wildcard_pred->global_set();
-    for(ConditionSet::iterator it = left.begin();
-            it != left.end(); ++it)
-    {
-        if(!solver->solve_left(*it).is_empty()) {
-            return;
-        }
+    if(!solver->is_nonempty(_wildcard_pred->global_set())) {
+        _linker->invalidate_state();
     }
-
-    _linker->invalidate_state();
 }
 
 /*
@@ -180,11 +183,25 @@ void QueryProcessor::solve_clause<PqlVariableTerm, PqlWildcardTerm>(
     ConditionSet left_conditions = get_qvar(qvar);
 
     ConditionSet new_left;
-    for(ConditionSet::iterator cit = left_conditions.begin();
-            cit != left_conditions.end(); ++cit)
-    {
-        if(!solver->solve_right(*cit).is_empty()) {
-            new_left.insert(*cit);
+
+    ConditionType type;
+    if(get_qvar_type(qvar, type)) {
+        TypedExistenceCheck has_right = solver->get_right_check(type);
+
+        for(ConditionSet::iterator cit = left_conditions.begin();
+                cit != left_conditions.end(); ++cit)
+        {
+            if(has_right.check(*cit)) {
+                new_left.insert(*cit);
+            }
+        }
+    } else {
+        for(ConditionSet::iterator cit = left_conditions.begin();
+                cit != left_conditions.end(); ++cit)
+        {
+            if(solver->has_right(*cit)) {
+                new_left.insert(*cit);
+            }
         }
     }
 
@@ -203,11 +220,25 @@ void QueryProcessor::solve_clause<PqlWildcardTerm, PqlVariableTerm>(
     ConditionSet right_conditions = get_qvar(qvar);
 
     ConditionSet new_right;
-    for(ConditionSet::iterator cit = right_conditions.begin();
-            cit != right_conditions.end(); ++cit)
-    {
-        if(!solver->solve_left(*cit).is_empty()) {
-            new_right.insert(*cit);
+
+    ConditionType type;
+    if(get_qvar_type(qvar, type)) {
+        TypedExistenceCheck has_left = solver->get_left_check(type);
+
+        for(ConditionSet::iterator cit = right_conditions.begin();
+                cit != right_conditions.end(); ++cit)
+        {
+            if(has_left.check(*cit)) {
+                new_right.insert(*cit);
+            }
+        }
+    } else {
+        for(ConditionSet::iterator cit = right_conditions.begin();
+                cit != right_conditions.end(); ++cit)
+        {
+            if(solver->has_left(*cit)) {
+                new_right.insert(*cit);
+            }
         }
     }
 
@@ -222,7 +253,7 @@ void QueryProcessor::solve_clause<PqlConditionTerm, PqlWildcardTerm>(
         QuerySolver *solver,
         PqlConditionTerm *term1, PqlWildcardTerm *term2)
 {
-    if(solver->solve_right(term1->get_condition()).is_empty()) {
+    if(!solver->has_right(term1->get_condition())) {
         _linker->invalidate_state();
     }
 }
@@ -235,7 +266,7 @@ void QueryProcessor::solve_clause<PqlWildcardTerm, PqlConditionTerm>(
         QuerySolver *solver,
         PqlWildcardTerm *term1, PqlConditionTerm *term2)
 {
-    if(solver->solve_left(term2->get_condition()).is_empty()) {
+    if(!solver->has_left(term2->get_condition())) {
         _linker->invalidate_state();
     }
 }
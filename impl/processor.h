@@ -49,6 +49,8 @@ class QueryProcessor {
 
     SimplePredicate* get_predicate(const std::string& qvar);
 
+    bool get_qvar_type(const std::string& qvar, ConditionType& type);
+
   private:
     std::shared_ptr<QueryLinker>        _linker;
     std::map<std::string, PredicatePtr> _predicates;
@@ -69,8 +71,9 @@ void QueryProcessor::solve_clause<PqlConditionTerm, PqlConditionTerm>(
  * Solver(qvar, qvar)
  *
  * This is a solve both query variable query. It is the most complicated
- * among all. The only correct way to solve this is go through all
- * possible combinations and validate the combinations.
+ * among all. The smaller side is passed as a batch to the solver
+ * together with the other side as the domain, and the solver returns
+ * all linked condition pairs at once.
  */
 template <>
 void QueryProcessor::solve_clause<PqlVariableTerm, PqlVariableTerm>(
@@ -80,9 +83,9 @@ void QueryProcessor::solve_clause<PqlVariableTerm, PqlVariableTerm>(
 /*
  * Solver(_, _)
  *
- * The way to solve this both wildcard term clause is not clear at 
- * the moment. For now the query is validated if there is at least 
- * one possible condition pair that match the solver.
+ * The query is validated if there is at least one possible condition
+ * pair that match the solver. Call Solver->is_nonempty() with all 
+ * conditions in the program.
  */
 template <>
 void QueryProcessor::solve_clause<PqlWildcardTerm, PqlWildcardTerm>(
@@ -113,9 +116,8 @@ void QueryProcessor::solve_clause<PqlConditionTerm, PqlVariableTerm>(
  * Solver(qvar, _)
  *
  * This is to find all possible left conditions that have results at
- * the right. Call Solver->solve_right() on all possible conditions in
- * left qvar and if the result condition set is non-empty, keep that
- * condition.
+ * the right. Call Solver->has_right() on all possible conditions in
+ * left qvar and keep the conditions that have a result.
  */
 template <>
 void QueryProcessor::solve_clause<PqlVariableTerm, PqlWildcardTerm>(
@@ -126,9 +128,8 @@ void QueryProcessor::solve_clause<PqlVariableTerm, PqlWildcardTerm>(
  * Solver(_, qvar)
  *
  * This is to find all possible right conditions that have results at
- * the left. Call Solver->solve_left() on all possible conditions in
- * right qvar and if the result condition set is non-empty, keep that
- * condition.
+ * the left. Call Solver->has_left() on all possible conditions in
+ * right qvar and keep the conditions that have a result.
  */
 template <>
 void QueryProcessor::solve_clause<PqlWildcardTerm, PqlVariableTerm>(
@@ -138,8 +139,7 @@ void QueryProcessor::solve_clause<PqlWildcardTerm, PqlVariableTerm>(
 /*
  * Solver(condition, _)
  *
- * This is also a validate query. Call Solver->solve_right() and see
- * if the returned condition set is non-empty.
+ * This is also a validate query. Call Solver->has_right().
  */
 template <>
 void QueryProcessor::solve_clause<PqlConditionTerm, PqlWildcardTerm>(
@@ -149,8 +149,7 @@ void QueryProcessor::solve_clause<PqlConditionTerm, PqlWildcardTerm>(
 /*
  * Solver(_, condition)
  *
- * This is also a validate query. Call Solver->solve_left() and see
- * if the returned condition set is non-empty.
+ * This is also a validate query. Call Solver->has_left().
  */
 template <>
 void QueryProcessor::solve_clause<PqlWildcardTerm, PqlConditionTerm>(
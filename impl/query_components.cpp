@@ -0,0 +1,285 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "impl/query_components.h"
+#include "impl/linker.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+
+/*
+ * Collect the query variable of a PQL term, if any.
+ */
+class ComponentTermVisitor : public PqlTermVisitor {
+  public:
+    ComponentTermVisitor(std::vector<Qvar>& qvars) : _qvars(qvars) { }
+
+    void visit_condition_term(PqlConditionTerm *term) { }
+
+    void visit_variable_term(PqlVariableTerm *term) {
+        _qvars.push_back(term->get_query_variable());
+    }
+
+    void visit_wildcard_term(PqlWildcardTerm *term) { }
+
+  private:
+    std::vector<Qvar>& _qvars;
+};
+
+class SelectedQvarVisitor : public PqlSelectorVisitor {
+  public:
+    void visit_single_var(PqlSingleVarSelector *selector) {
+        qvars.insert(selector->get_qvar_name());
+    }
+
+    void visit_boolean(PqlBooleanSelector *selector) { }
+
+    void visit_tuple(PqlTupleSelector *selector) {
+        std::vector<std::string> tuples = selector->get_tuples();
+        qvars.insert(tuples.begin(), tuples.end());
+    }
+
+    std::set<Qvar> qvars;
+};
+
+std::set<Qvar> get_selected_qvars(PqlQuerySet& query) {
+    SelectedQvarVisitor visitor;
+    query.selector->accept_pql_selector_visitor(&visitor);
+
+    return visitor.qvars;
+}
+
+static Qvar find_root(std::map<Qvar, Qvar>& parents, const Qvar& qvar) {
+    Qvar root = qvar;
+    while(parents[root] != root) root = parents[root];
+
+    Qvar current = qvar;
+    while(current != root) {
+        Qvar next = parents[current];
+        parents[current] = root;
+        current = next;
+    }
+
+    return root;
+}
+
+std::vector<QueryComponent> split_query_components(PqlQuerySet& query) {
+    std::map<Qvar, Qvar> parents;
+    std::vector< std::vector<Qvar> > clause_qvars;
+
+    for(ClauseSet::iterator it = query.clauses.begin();
+        it != query.clauses.end(); ++it)
+    {
+        std::vector<Qvar> qvars;
+        ComponentTermVisitor visitor(qvars);
+        (*it)->get_left_term()->accept_pql_term_visitor(&visitor);
+        (*it)->get_right_term()->accept_pql_term_visitor(&visitor);
+
+        for(size_t i = 0; i < qvars.size(); ++i) {
+            if(parents.count(qvars[i]) == 0) parents[qvars[i]] = qvars[i];
+        }
+
+        if(qvars.size() == 2) {
+            Qvar root1 = find_root(parents, qvars[0]);
+            Qvar root2 = find_root(parents, qvars[1]);
+            if(root1 != root2) parents[root1] = root2;
+        }
+
+        clause_qvars.push_back(qvars);
+    }
+
+    std::vector<QueryComponent> components;
+    std::map<Qvar, int> component_index;
+    int ground_component = -1;
+
+    ClauseSet::iterator clause = query.clauses.begin();
+    for(size_t i = 0; i < clause_qvars.size(); ++i, ++clause) {
+        int index;
+
+        if(clause_qvars[i].empty()) {
+            if(ground_component == -1) {
+                ground_component = components.size();
+                components.push_back(QueryComponent());
+            }
+            index = ground_component;
+        } else {
+            Qvar root = find_root(parents, clause_qvars[i][0]);
+            std::map<Qvar, int>::iterator found = component_index.find(root);
+
+            if(found == component_index.end()) {
+                index = components.size();
+                component_index[root] = index;
+                components.push_back(QueryComponent());
+            } else {
+                index = found->second;
+            }
+        }
+
+        QueryComponent& component = components[index];
+        component.clauses.insert(*clause);
+        component.qvars.insert(clause_qvars[i].begin(), clause_qvars[i].end());
+    }
+
+    std::set<Qvar> selected = get_selected_qvars(query);
+
+    for(size_t i = 0; i < components.size(); ++i) {
+        std::set<Qvar>& qvars = components[i].qvars;
+
+        for(std::set<Qvar>::iterator it = qvars.begin(); it != qvars.end(); ++it) {
+            if(selected.count(*it) > 0) components[i].selected = true;
+        }
+    }
+
+    return components;
+}
+
+ComponentQueryLinker::ComponentQueryLinker(
+        std::map<Qvar, PredicatePtr> pred_table, ConditionSet global_set) :
+    _free_linker(new SimpleQueryLinker(pred_table, global_set)), _valid(true)
+{ }
+
+void ComponentQueryLinker::add_component(const QueryComponent& component,
+    std::shared_ptr<QueryLinker> linker)
+{
+    for(std::set<Qvar>::const_iterator it = component.qvars.begin();
+        it != component.qvars.end(); ++it)
+    {
+        _linkers[*it] = linker;
+    }
+}
+
+QueryLinker* ComponentQueryLinker::get_linker(const Qvar& qvar) {
+    std::map<Qvar, std::shared_ptr<QueryLinker> >::iterator it = 
+        _linkers.find(qvar);
+
+    if(it != _linkers.end()) {
+        return it->second.get();
+    } else {
+        return _free_linker.get();
+    }
+}
+
+void ComponentQueryLinker::update_links(
+    const std::string& qvar1, const std::string& qvar2, 
+    const std::set<ConditionPair>& links)
+{
+    get_linker(qvar1)->update_links(qvar1, qvar2, links);
+}
+
+void ComponentQueryLinker::update_results(
+    const std::string& qvar, const ConditionSet& conditions)
+{
+    get_linker(qvar)->update_results(qvar, conditions);
+}
+
+/*
+ * The tuples of each linker are made for its own query variables, and
+ * then every combination of one tuple from each linker is put together
+ * in the order of the selected query variables.
+ */
+TupleTable ComponentQueryLinker::make_tuple_table(const std::vector<Qvar>& qvars) {
+    std::vector<QueryLinker*> linkers;
+    std::vector< std::vector<Qvar> > linker_qvars;
+    std::vector< std::pair<size_t, size_t> > columns;
+
+    for(std::vector<Qvar>::const_iterator it = qvars.begin(); 
+        it != qvars.end(); ++it)
+    {
+        QueryLinker *linker = get_linker(*it);
+
+        size_t group = 0;
+        while(group < linkers.size() && linkers[group] != linker) ++group;
+
+        if(group == linkers.size()) {
+            linkers.push_back(linker);
+            linker_qvars.push_back(std::vector<Qvar>());
+        }
+
+        columns.push_back(std::make_pair(group, linker_qvars[group].size()));
+        linker_qvars[group].push_back(*it);
+    }
+
+    if(linkers.size() == 1) return linkers[0]->make_tuple_table(qvars);
+
+    std::vector<TupleTable> group_tuples;
+    size_t product = 1;
+
+    for(size_t group = 0; group < linkers.size(); ++group) {
+        group_tuples.push_back(
+            linkers[group]->make_tuple_table(linker_qvars[group]));
+        product *= group_tuples.back().size();
+    }
+
+    TupleTable result(qvars.size());
+    if(product == 0) return result;
+
+    result.reserve(product);
+
+    std::vector<const TupleTable*> tables;
+    for(size_t group = 0; group < group_tuples.size(); ++group) {
+        tables.push_back(&group_tuples[group]);
+    }
+
+    std::vector<size_t> choices(linkers.size(), 0);
+
+    while(true) {
+        result.add_joined_row(tables, choices, columns);
+
+        size_t group = 0;
+        while(group < linkers.size() && 
+            ++choices[group] == tables[group]->size()) 
+        {
+            choices[group] = 0;
+            ++group;
+        }
+
+        if(group == linkers.size()) break;
+    }
+
+    result.sort_unique();
+    return result;
+}
+
+bool ComponentQueryLinker::is_valid_state() {
+    if(!_valid || !_free_linker->is_valid_state()) return false;
+
+    for(std::map<Qvar, std::shared_ptr<QueryLinker> >::iterator it = 
+        _linkers.begin(); it != _linkers.end(); ++it)
+    {
+        if(!it->second->is_valid_state()) return false;
+    }
+
+    return true;
+}
+
+void ComponentQueryLinker::invalidate_state() {
+    _valid = false;
+}
+
+bool ComponentQueryLinker::is_initialized(const std::string& qvar) {
+    return get_linker(qvar)->is_initialized(qvar);
+}
+
+ConditionSet ComponentQueryLinker::get_conditions(const std::string& qvar) {
+    return get_linker(qvar)->get_conditions(qvar);
+}
+
+} // namespace impl
+} // namespace simple
@@ -0,0 +1,101 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <vector>
+#include <memory>
+#include "simple/linker.h"
+#include "simple/query.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+
+/*
+ * A connected component of the query variable graph of a query, where
+ * two query variables are connected if a clause mentions both. Clauses
+ * without query variables form a component of their own. A component is
+ * selected if the selector mentions one of its query variables.
+ */
+struct QueryComponent {
+    QueryComponent() : selected(false) { }
+
+    std::set<Qvar>  qvars;
+    ClauseSet       clauses;
+    bool            selected;
+};
+
+/*
+ * Split the clauses of a query into its connected components. Selected
+ * query variables not mentioned by any clause are in no component.
+ */
+std::vector<QueryComponent> split_query_components(PqlQuerySet& query);
+
+/*
+ * Get the query variables mentioned by the selector of a query.
+ */
+std::set<Qvar> get_selected_qvars(PqlQuerySet& query);
+
+/*
+ * ComponentQueryLinker combines the linkers of the selected components
+ * of a query, each solved on its own. Since the components share no
+ * query variables, the tuples of query variables from several 
+ * components are the product of the tuples from each component, and it
+ * is only built here when the result is formatted. Query variables in
+ * no component are held by a linker of their own.
+ */
+class ComponentQueryLinker : public QueryLinker {
+  public:
+    ComponentQueryLinker(
+        std::map<Qvar, PredicatePtr> pred_table, 
+        ConditionSet global_set);
+
+    /*
+     * Hand the query variables of a solved component over to its linker.
+     */
+    void add_component(const QueryComponent& component,
+        std::shared_ptr<QueryLinker> linker);
+
+    void update_links(
+        const std::string& qvar1, const std::string& qvar2, 
+        const std::set<ConditionPair>& links);
+
+    void update_results(const std::string& qvar, const ConditionSet& conditions);
+
+    TupleTable make_tuple_table(const std::vector<Qvar>& qvars);
+
+    bool is_valid_state();
+    void invalidate_state();
+
+    bool is_initialized(const std::string& qvar);
+    ConditionSet get_conditions(const std::string& qvar);
+
+  private:
+    QueryLinker* get_linker(const Qvar& qvar);
+
+    std::map<Qvar, std::shared_ptr<QueryLinker> >   _linkers;
+    std::shared_ptr<QueryLinker>                    _free_linker;
+    bool                                            _valid;
+};
+
+} // namespace impl
+} // namespace simple
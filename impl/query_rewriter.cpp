@@ -0,0 +1,327 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "impl/query_rewriter.h"
+#include "impl/query.h"
+#include "impl/predicate.h"
+#include "impl/condition.h"
+#include "simple/util/condition_utils.h"
+#include "simple/util/query_utils.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * Read a single PQL term into its condition or query variable term, or
+ * mark it as a wildcard.
+ */
+class RewriteTermVisitor : public PqlTermVisitor {
+  public:
+    RewriteTermVisitor(PqlTerm *term) : 
+        condition_term(NULL), variable_term(NULL), wildcard(false)
+    { 
+        term->accept_pql_term_visitor(this);
+    }
+
+    void visit_condition_term(PqlConditionTerm *term) {
+        condition_term = term;
+    }
+
+    void visit_variable_term(PqlVariableTerm *term) {
+        variable_term = term;
+    }
+
+    void visit_wildcard_term(PqlWildcardTerm *term) {
+        wildcard = true;
+    }
+
+    PqlTerm* copy_term() {
+        if(condition_term != NULL) {
+            return new SimplePqlConditionTerm(condition_term->get_condition());
+        } else if(variable_term != NULL) {
+            return new SimplePqlVariableTerm(
+                variable_term->get_query_variable());
+        } else {
+            return new SimplePqlWildcardTerm();
+        }
+    }
+
+    PqlConditionTerm    *condition_term;
+    PqlVariableTerm     *variable_term;
+    bool                wildcard;
+};
+
+/*
+ * The condition that a query variable of the given condition type is 
+ * equal to when a with clause equates it with the constant, or NULL if
+ * the equality does not pin the query variable down to one condition.
+ * A variable is equal to a procedure of the same name and a constant to
+ * the statement with its value as line.
+ */
+static ConditionPtr get_bound_condition(
+        ConditionType type, const ConditionPtr& constant)
+{
+    SimpleCondition *condition = constant.get();
+    ConditionType constant_type = get_condition_type(condition);
+
+    if(constant_type == type) return constant;
+
+    if(type == VariableCT && constant_type == ProcCT) {
+        return new SimpleVariableCondition(SimpleVariable(
+            condition_cast<ProcCondition>(condition)->get_proc_ast()->get_name()));
+    }
+
+    if(type == ConstantCT && constant_type == StatementCT) {
+        return new SimpleConstantCondition(
+            condition_cast<StatementCondition>(condition)->
+                get_statement_ast()->get_statement_line());
+    }
+
+    return ConditionPtr((SimpleCondition*) NULL);
+}
+
+QueryRewriter::QueryRewriter(const SolverTable& solver_table) {
+    for(SolverTable::const_iterator it = solver_table.begin();
+        it != solver_table.end(); ++it)
+    {
+        _solvers.insert(std::make_pair(it->second.get(), it->second));
+    }
+
+    SolverTable::const_iterator equal = solver_table.find("equal");
+    if(equal != solver_table.end()) _equal_solver = equal->second;
+
+    add_implication(solver_table, "follows", "ifollows");
+    add_implication(solver_table, "parent", "iparent");
+    add_implication(solver_table, "calls", "icalls");
+    add_implication(solver_table, "next", "inext");
+    add_implication(solver_table, "nextbip", "inextbip");
+    add_implication(solver_table, "affects", "iaffects");
+    add_implication(solver_table, "affectsbip", "iaffectsbip");
+    add_implication(solver_table, "contains", "icontains");
+}
+
+void QueryRewriter::add_implication(const SolverTable& solver_table,
+        const std::string& stronger, const std::string& weaker)
+{
+    SolverTable::const_iterator stronger_solver = solver_table.find(stronger);
+    SolverTable::const_iterator weaker_solver = solver_table.find(weaker);
+
+    if(stronger_solver == solver_table.end() || 
+       weaker_solver == solver_table.end()) 
+    {
+        return;
+    }
+
+    _implications.insert(std::make_pair(
+        stronger_solver->second.get(), weaker_solver->second.get()));
+}
+
+bool QueryRewriter::rewrite(PqlQuerySet& query) {
+    _bindings.clear();
+
+    if(!bind_qvars(query)) return false;
+
+    ClauseSet clauses;
+    if(!substitute_clauses(query, clauses)) return false;
+
+    remove_implied_clauses(clauses);
+
+    query.clauses.swap(clauses);
+    return true;
+}
+
+bool QueryRewriter::bind_qvars(PqlQuerySet& query) {
+    for(ClauseSet::iterator it = query.clauses.begin();
+        it != query.clauses.end(); ++it)
+    {
+        Qvar qvar;
+        ConditionPtr condition = get_binding(it->get(), query, qvar);
+        if(condition.get() == NULL) continue;
+
+        if(!query.predicates[qvar]->validate(condition)) return false;
+
+        std::map<Qvar, ConditionPtr>::iterator bound = _bindings.find(qvar);
+
+        if(bound == _bindings.end()) {
+            _bindings.insert(std::make_pair(qvar, condition));
+        } else if(!is_same_condition(bound->second.get(), condition.get())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Get the query variable and condition bound by a with clause, or NULL
+ * if the clause does not bind a query variable.
+ */
+ConditionPtr QueryRewriter::get_binding(PqlClause *clause, 
+        const PqlQuerySet& query, Qvar& qvar)
+{
+    ConditionPtr none((SimpleCondition*) NULL);
+
+    if(_equal_solver.get() == NULL || 
+       clause->get_solver() != _equal_solver.get()) 
+    {
+        return none;
+    }
+
+    RewriteTermVisitor left(clause->get_left_term());
+    RewriteTermVisitor right(clause->get_right_term());
+
+    PqlConditionTerm *constant;
+
+    if(left.variable_term != NULL && right.condition_term != NULL) {
+        qvar = left.variable_term->get_query_variable();
+        constant = right.condition_term;
+    } else if(left.condition_term != NULL && right.variable_term != NULL) {
+        qvar = right.variable_term->get_query_variable();
+        constant = left.condition_term;
+    } else {
+        return none;
+    }
+
+    std::map<Qvar, PredicatePtr>::const_iterator pred = 
+        query.predicates.find(qvar);
+    if(pred == query.predicates.end()) return none;
+
+    ConditionType type;
+    if(!get_predicate_condition_type(pred->second.get(), type)) return none;
+
+    return get_bound_condition(type, constant->get_condition());
+}
+
+/*
+ * Get a condition term for a bound query variable term, or NULL if the
+ * term is not a bound query variable.
+ */
+PqlTerm* QueryRewriter::substitute_term(PqlTerm *term) {
+    RewriteTermVisitor visitor(term);
+    if(visitor.variable_term == NULL) return NULL;
+
+    std::map<Qvar, ConditionPtr>::iterator bound = 
+        _bindings.find(visitor.variable_term->get_query_variable());
+    if(bound == _bindings.end()) return NULL;
+
+    return new SimplePqlConditionTerm(bound->second);
+}
+
+bool QueryRewriter::substitute_clauses(
+        const PqlQuerySet& query, ClauseSet& result)
+{
+    for(ClauseSet::const_iterator it = query.clauses.begin();
+        it != query.clauses.end(); ++it)
+    {
+        PqlClause *clause = it->get();
+
+        Qvar qvar;
+        if(get_binding(clause, query, qvar).get() != NULL) continue;
+
+        std::map<QuerySolver*, SolverPtr>::iterator solver = 
+            _solvers.find(clause->get_solver());
+
+        PqlTerm *left = substitute_term(clause->get_left_term());
+        PqlTerm *right = substitute_term(clause->get_right_term());
+
+        if(solver == _solvers.end() || (left == NULL && right == NULL)) {
+            delete left;
+            delete right;
+            result.insert(*it);
+            continue;
+        }
+
+        RewriteTermVisitor left_visitor(clause->get_left_term());
+        RewriteTermVisitor right_visitor(clause->get_right_term());
+
+        if(left == NULL) left = left_visitor.copy_term();
+        if(right == NULL) right = right_visitor.copy_term();
+
+        ClausePtr substituted(new SimplePqlClause(solver->second, left, right));
+
+        RewriteTermVisitor new_left(left);
+        RewriteTermVisitor new_right(right);
+
+        if(new_left.condition_term != NULL && new_right.condition_term != NULL) {
+            if(!clause->get_solver()->validate(
+                new_left.condition_term->get_condition(),
+                new_right.condition_term->get_condition()))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        result.insert(substituted);
+    }
+
+    for(std::map<Qvar, ConditionPtr>::iterator it = _bindings.begin();
+        it != _bindings.end(); ++it)
+    {
+        result.insert(ClausePtr(new SimplePqlClause(_equal_solver,
+            new SimplePqlVariableTerm(it->first), 
+            new SimplePqlConditionTerm(it->second))));
+    }
+
+    return true;
+}
+
+void QueryRewriter::remove_implied_clauses(ClauseSet& clauses) {
+    for(ClauseSet::iterator it = clauses.begin(); it != clauses.end(); ) {
+        bool implied = false;
+
+        for(ClauseSet::iterator other = clauses.begin(); 
+            other != clauses.end() && !implied; ++other)
+        {
+            implied = other != it && is_implied_by(it->get(), other->get());
+        }
+
+        if(implied) {
+            clauses.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/*
+ * A clause is implied by another clause if the relation of the other 
+ * clause implies its relation, and each of its terms is either the same
+ * as the other term or a wildcard.
+ */
+bool QueryRewriter::is_implied_by(PqlClause *clause, PqlClause *other) {
+    if(clause->get_solver() != other->get_solver() &&
+       _implications.count(std::make_pair(
+            other->get_solver(), clause->get_solver())) == 0)
+    {
+        return false;
+    }
+
+    return covers_term(clause->get_left_term(), other->get_left_term()) &&
+        covers_term(clause->get_right_term(), other->get_right_term());
+}
+
+bool QueryRewriter::covers_term(PqlTerm *term, PqlTerm *other) {
+    return RewriteTermVisitor(term).wildcard || is_same_term(term, other);
+}
+
+} // namespace impl
+} // namespace simple
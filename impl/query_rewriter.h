@@ -0,0 +1,92 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <utility>
+#include "simple/solver.h"
+#include "simple/predicate.h"
+#include "simple/query.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+
+/*
+ * QueryRewriter simplifies the clauses of a parsed query before any of
+ * them is solved.
+ *
+ * A with clause equating a query variable with a constant binds the
+ * query variable, and the constant is substituted for it in every other
+ * clause. This turns them into the cheaper clause forms with condition
+ * terms, and clauses left with two conditions are checked right away.
+ * Each bound query variable keeps a single with clause restricting it 
+ * to its constant. A substituted clause is solved from the side of the
+ * constant, so this is only sound for solvers whose solve_left and 
+ * solve_right agree on every pair.
+ *
+ * A clause implied by another clause, such as Follows*(s, _) next to
+ * Follows(s, s2), is then dropped.
+ *
+ * The query has no result if a query variable is bound to two different
+ * constants, to a constant its predicate does not accept, or if a clause
+ * with two conditions does not hold.
+ */
+class QueryRewriter {
+  public:
+    QueryRewriter(const SolverTable& solver_table);
+
+    /*
+     * Rewrite the clauses of the query in place. Returns false if the 
+     * query is found to have no result, in which case the clauses are
+     * left unchanged.
+     */
+    bool rewrite(PqlQuerySet& query);
+
+  private:
+    bool bind_qvars(PqlQuerySet& query);
+    ConditionPtr get_binding(PqlClause *clause, 
+            const PqlQuerySet& query, Qvar& qvar);
+
+    PqlTerm* substitute_term(PqlTerm *term);
+    bool substitute_clauses(const PqlQuerySet& query, ClauseSet& result);
+
+    void remove_implied_clauses(ClauseSet& clauses);
+    bool is_implied_by(PqlClause *clause, PqlClause *other);
+    bool covers_term(PqlTerm *term, PqlTerm *other);
+
+    void add_implication(const SolverTable& solver_table,
+            const std::string& stronger, const std::string& weaker);
+
+    std::map<QuerySolver*, SolverPtr>   _solvers;
+    SolverPtr                           _equal_solver;
+
+    /*
+     * Pairs of solvers where a pair of conditions satisfying the first
+     * relation also satisfies the second.
+     */
+    std::set< std::pair<QuerySolver*, QuerySolver*> > _implications;
+
+    std::map<Qvar, ConditionPtr>        _bindings;
+};
+
+} // namespace impl
+} // namespace simple
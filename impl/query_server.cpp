@@ -0,0 +1,286 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include "impl/query_server.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+
+ThreadPool::ThreadPool(int thread_count) : _stopping(false) {
+    for(int i = 0; i < thread_count; ++i) {
+        _threads.push_back(std::thread(&ThreadPool::run, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _ready.notify_all();
+
+    for(auto it = _threads.begin(); it != _threads.end(); ++it) {
+        it->join();
+    }
+}
+
+void ThreadPool::submit(const std::function<void()>& task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(task);
+    }
+    _ready.notify_one();
+}
+
+void ThreadPool::run() {
+    while(true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while(_tasks.empty() && !_stopping) _ready.wait(lock);
+
+            if(_tasks.empty()) return;
+
+            task = _tasks.front();
+            _tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+long long elapsed_micros(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - start).count();
+}
+
+std::string read_file(const std::string& filename) {
+    std::ifstream source(filename);
+    if(!source) {
+        throw std::runtime_error("Unable to open file " + filename);
+    }
+
+    return std::string(std::istreambuf_iterator<char>(source),
+        std::istreambuf_iterator<char>());
+}
+
+std::string read_name(std::istream& args) {
+    std::string name;
+    if(!(args >> name)) {
+        throw std::runtime_error("Missing program name");
+    }
+    return name;
+}
+
+std::string read_rest(std::istream& args) {
+    std::string rest;
+    std::getline(args >> std::ws, rest);
+    return rest;
+}
+
+} // namespace
+
+QueryServer::QueryServer(int thread_count) : _pool(thread_count) { }
+
+std::string QueryServer::handle_request(const std::string& request) {
+    Clock::time_point start = Clock::now();
+
+    std::istringstream args(request);
+    std::string command;
+    args >> command;
+
+    std::string status = "OK";
+    std::string body;
+
+    try {
+        body = dispatch(command, args);
+    } catch(std::exception& e) {
+        status = "ERROR";
+        body = e.what();
+    }
+
+    std::ostringstream response;
+    response << status << " " << elapsed_micros(start) << "us";
+    if(!body.empty()) response << " " << body;
+
+    return response.str();
+}
+
+std::future<std::string> QueryServer::submit(const std::string& request) {
+    std::shared_ptr< std::packaged_task<std::string()> > task(
+        new std::packaged_task<std::string()>(
+            std::bind(&QueryServer::handle_request, this, request)));
+
+    _pool.submit([task]() { (*task)(); });
+    return task->get_future();
+}
+
+std::string QueryServer::dispatch(const std::string& command, std::istream& args) {
+    if(command == "QUERY") {
+        std::string name = read_name(args);
+        return query_program(name, read_rest(args));
+
+    } else if(command == "LOAD") {
+        std::string name = read_name(args);
+        return load_program(name, read_rest(args));
+
+    } else if(command == "RELOAD") {
+        return reload_program(read_name(args));
+
+    } else if(command == "DROP") {
+        return drop_program(read_name(args));
+
+    } else if(command == "LIST") {
+        return list_programs();
+
+    } else if(command == "STATS") {
+        return get_stats(read_name(args));
+
+    } else {
+        throw std::runtime_error("Unknown command " + command);
+    }
+}
+
+/*
+ * The program is parsed before taking the table lock, so that loading a
+ * large program does not hold up requests on the other programs.
+ */
+std::string QueryServer::load_program(
+    const std::string& name, const std::string& filename) 
+{
+    std::string source = read_file(filename);
+
+    ProgramPtr program(new Program(filename, 
+        new SimplePqlFrontEnd(source.begin(), source.end())));
+
+    std::lock_guard<std::mutex> lock(_programs_mutex);
+    _programs[name] = program;
+
+    return "loaded " + name;
+}
+
+std::string QueryServer::reload_program(const std::string& name) {
+    ProgramPtr program = find_program(name);
+
+    std::lock_guard<std::mutex> lock(program->mutex);
+    std::string source = read_file(program->filename);
+
+    if(program->frontend->reload_source(source.begin(), source.end())) {
+        return "reloaded " + name;
+    } else {
+        return "unchanged " + name;
+    }
+}
+
+/*
+ * Requests already running on the program keep it alive until they
+ * finish.
+ */
+std::string QueryServer::drop_program(const std::string& name) {
+    std::lock_guard<std::mutex> lock(_programs_mutex);
+
+    if(_programs.erase(name) == 0) {
+        throw std::runtime_error("No program named " + name);
+    }
+
+    return "dropped " + name;
+}
+
+std::string QueryServer::list_programs() {
+    std::lock_guard<std::mutex> lock(_programs_mutex);
+
+    std::string result;
+    for(auto it = _programs.begin(); it != _programs.end(); ++it) {
+        if(!result.empty()) result += ", ";
+        result += it->first;
+    }
+
+    return result;
+}
+
+std::string QueryServer::get_stats(const std::string& name) {
+    ProgramPtr program = find_program(name);
+
+    std::lock_guard<std::mutex> lock(program->mutex);
+
+    long long average = program->query_count == 0 ? 0 :
+        program->total_latency / program->query_count;
+
+    std::ostringstream result;
+    result << "queries=" << program->query_count
+           << " total=" << program->total_latency << "us"
+           << " average=" << average << "us"
+           << " max=" << program->max_latency << "us";
+
+    return result.str();
+}
+
+/*
+ * The recorded latency includes the time spent waiting for the other
+ * requests on the same program.
+ */
+std::string QueryServer::query_program(
+    const std::string& name, const std::string& query) 
+{
+    Clock::time_point start = Clock::now();
+    ProgramPtr program = find_program(name);
+
+    std::lock_guard<std::mutex> lock(program->mutex);
+
+    std::vector<std::string> result = program->frontend->process_query(
+        query.begin(), query.end());
+
+    long long latency = elapsed_micros(start);
+    ++program->query_count;
+    program->total_latency += latency;
+    if(latency > program->max_latency) program->max_latency = latency;
+
+    std::string output;
+    for(auto it = result.begin(); it != result.end(); ++it) {
+        if(it != result.begin()) output += ", ";
+        output += *it;
+    }
+
+    return output;
+}
+
+QueryServer::ProgramPtr QueryServer::find_program(const std::string& name) {
+    std::lock_guard<std::mutex> lock(_programs_mutex);
+
+    auto it = _programs.find(name);
+    if(it == _programs.end()) {
+        throw std::runtime_error("No program named " + name);
+    }
+
+    return it->second;
+}
+
+} // namespace impl
+} // namespace simple
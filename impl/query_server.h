@@ -0,0 +1,132 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <future>
+#include <functional>
+#include <condition_variable>
+#include "impl/frontend.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+
+/*
+ * A fixed number of worker threads taking tasks from a shared queue.
+ * The destructor runs the tasks still queued before joining.
+ */
+class ThreadPool {
+  public:
+    ThreadPool(int thread_count);
+    ~ThreadPool();
+
+    void submit(const std::function<void()>& task);
+
+  private:
+    void run();
+
+    std::vector<std::thread>            _threads;
+    std::deque< std::function<void()> > _tasks;
+    std::mutex                          _mutex;
+    std::condition_variable             _ready;
+    bool                                _stopping;
+};
+
+/*
+ * QueryServer keeps a set of named programs in memory and answers
+ * requests on them, one request per line:
+ *
+ *   LOAD <name> <file>      parse a source file as program <name>
+ *   RELOAD <name>           parse the file of <name> again incrementally
+ *   DROP <name>             unload <name>
+ *   LIST                    the names of the loaded programs
+ *   STATS <name>            query count and latency of <name>
+ *   QUERY <name> <pql>      evaluate a PQL query on <name>
+ *
+ * Each response is a single line starting with OK or ERROR and the
+ * latency of the request in microseconds, followed by the result.
+ *
+ * The solvers of a program cache their results and are not thread 
+ * safe, so requests on the same program are serialized while requests
+ * on different programs run concurrently. The caches stay warm across
+ * requests until the program is reloaded or dropped.
+ */
+class QueryServer {
+  public:
+    QueryServer(int thread_count);
+
+    /*
+     * Handle a request on the calling thread. Safe to call concurrently.
+     */
+    std::string handle_request(const std::string& request);
+
+    /*
+     * Handle a request on the thread pool.
+     */
+    std::future<std::string> submit(const std::string& request);
+
+  private:
+    struct Program {
+        Program(const std::string& filename, SimplePqlFrontEnd *frontend) :
+            filename(filename), frontend(frontend),
+            query_count(0), total_latency(0), max_latency(0)
+        { }
+
+        std::string                         filename;
+        std::unique_ptr<SimplePqlFrontEnd>  frontend;
+        std::mutex                          mutex;
+
+        int         query_count;
+        long long   total_latency;
+        long long   max_latency;
+    };
+
+    typedef std::shared_ptr<Program> ProgramPtr;
+
+    std::string dispatch(const std::string& command, std::istream& args);
+
+    std::string load_program(const std::string& name, const std::string& filename);
+    std::string reload_program(const std::string& name);
+    std::string drop_program(const std::string& name);
+    std::string list_programs();
+    std::string get_stats(const std::string& name);
+    std::string query_program(const std::string& name, const std::string& query);
+
+    ProgramPtr find_program(const std::string& name);
+
+    std::map<std::string, ProgramPtr>   _programs;
+    std::mutex                          _programs_mutex;
+
+    /*
+     * Declared last so that queued requests finish before the programs 
+     * are destroyed.
+     */
+    ThreadPool _pool;
+};
+
+} // namespace impl
+} // namespace simple
@@ -19,7 +19,7 @@
 #include "impl/selector.h"
 #include "simple/util/condition_utils.h"
 #include "simple/util/ast_utils.h"
-#include <algorithm>
+#include "simple/util/bit_set.h"
 
 namespace simple {
 namespace impl {
@@ -36,11 +36,13 @@ enum SelectType {
 
 template <typename Selector>
 std::vector<std::string> format_selector(
-    Selector *selector, PqlQuerySet *query, QueryLinker *linker);
+    Selector *selector, PqlQuerySet *query, QueryLinker *linker,
+    const PredicateDomain *domain);
 
 template <>
 std::vector<std::string> format_selector<PqlSingleVarSelector>(
-    PqlSingleVarSelector *var_selector, PqlQuerySet *query, QueryLinker *linker)
+    PqlSingleVarSelector *var_selector, PqlQuerySet *query, QueryLinker *linker,
+    const PredicateDomain *domain)
 {
     Qvar qvar = var_selector->get_qvar_name();
     ConditionSet conditions = linker->get_conditions(qvar);
@@ -87,46 +89,52 @@ std::vector<std::string> format_selector<PqlSingleVarSelector>(
             //continue on
     }
 
-    for(ConditionSet::iterator it = conditions.begin(); 
-            it != conditions.end(); ++it)
+    result.reserve(conditions.get_size());
+
+    /*
+     * The procedure names of call statements are deduplicated by the
+     * IDs of the called procedures.
+     */
+    if(var_selector->get_select_type() == ProcName && 
+       pred->get_predicate_name() == "call") 
     {
-        switch(var_selector->get_select_type())
+        BitSet procs(domain->size());
+
+        for(ConditionSet::iterator it = conditions.begin(); 
+                it != conditions.end(); ++it)
         {
-            case StmtNum:
-            case VarName:
-            case Value:
-            case Default:
-                result.push_back(condition_to_string(*it));
-                break;
-            
-            case ProcName:
-                if (pred->get_predicate_name() == "procedure") {
-                    result.push_back(condition_to_string(*it));
-                
-                } else if (pred->get_predicate_name() == "call") {
-                    StatementCondition *state_cond = condition_cast<StatementCondition>(*it);
-                    
-                    CallAst *call_statement = statement_cast<CallAst>(state_cond->get_statement_ast());
-                    
-                    if(std::find(result.begin(), result.end(), call_statement->get_proc_called()->get_name()) == result.end()) {
-                        result.push_back(call_statement->get_proc_called()->get_name());
-                    } 
-                    
-                }
-                break;
-            default:
-                break;
-                //continue
+            size_t call_id, proc_id;
+            if(!domain->find_id(*it, call_id) || 
+               !domain->find_called_proc(call_id, proc_id) ||
+               procs.test(proc_id)) 
+            {
+                continue;
+            }
+
+            procs.set(proc_id);
+            result.push_back(domain->get_name(proc_id));
         }
-       // result.push_back(condition_to_string(*it));
-    };
+
+        return result;
+    }
+
+    std::string buffer;
+
+    for(ConditionSet::iterator it = conditions.begin(); 
+            it != conditions.end(); ++it)
+    {
+        buffer.clear();
+        domain->append_name(*it, buffer);
+        result.push_back(buffer);
+    }
 
     return result;
 }
 
 template <>
 std::vector<std::string> format_selector<PqlBooleanSelector>(
-    PqlBooleanSelector *selector, PqlQuerySet *query, QueryLinker *linker)
+    PqlBooleanSelector *selector, PqlQuerySet *query, QueryLinker *linker,
+    const PredicateDomain *domain)
 {
     std::vector<std::string> result;
 
@@ -139,12 +147,17 @@ std::vector<std::string> format_selector<PqlBooleanSelector>(
     return result;
 }
 
+/*
+ * Each tuple is rendered into the same buffer by appending the rendered
+ * names of its conditions.
+ */
 template <>
 std::vector<std::string> format_selector<PqlTupleSelector>(
-    PqlTupleSelector *selector, PqlQuerySet *query, QueryLinker *linker)
+    PqlTupleSelector *selector, PqlQuerySet *query, QueryLinker *linker,
+    const PredicateDomain *domain)
 {
     std::vector<std::string> selected_qvars = selector->get_tuples();
-    TupleSet tuples = linker->make_tuples(selected_qvars);
+    TupleTable tuples = linker->make_tuple_table(selected_qvars);
 
     std::vector<std::string> result;
   
@@ -152,8 +165,19 @@ std::vector<std::string> format_selector<PqlTupleSelector>(
 		  return result;
 	  }
   
-    for(auto it=tuples.begin(); it!=tuples.end(); ++it) {
-        result.push_back(tuple_to_string(*it));
+    result.reserve(tuples.size());
+    std::string buffer;
+
+    for(size_t i = 0; i < tuples.size(); ++i) {
+        const ConditionPtr *row = tuples.row(i);
+        buffer.clear();
+
+        for(size_t column = 0; column < tuples.arity(); ++column) {
+            if(column > 0) buffer += ' ';
+            domain->append_name(row[column], buffer);
+        }
+
+        result.push_back(buffer);
     }
 
     return result;
@@ -161,23 +185,24 @@ std::vector<std::string> format_selector<PqlTupleSelector>(
 
 class ResultFormatterVisitor : public PqlSelectorVisitor {
   public:
-    ResultFormatterVisitor(PqlQuerySet *query, QueryLinker *linker) : 
-      _query(query), _linker(linker)
+    ResultFormatterVisitor(PqlQuerySet *query, QueryLinker *linker,
+        const PredicateDomain *domain) : 
+      _query(query), _linker(linker), _domain(domain)
     { }
 
     void visit_single_var(PqlSingleVarSelector *selector) {
         _result = format_selector<PqlSingleVarSelector>(
-            selector, _query, _linker);
+            selector, _query, _linker, _domain);
     }
 
     void visit_boolean(PqlBooleanSelector *selector) {
         _result = format_selector<PqlBooleanSelector>(
-            selector, _query, _linker);
+            selector, _query, _linker, _domain);
     }
 
     void visit_tuple(PqlTupleSelector *selector) {
         _result = format_selector<PqlTupleSelector>(
-            selector, _query, _linker);
+            selector, _query, _linker, _domain);
     }
 
     std::vector<std::string> return_result() {
@@ -188,15 +213,16 @@ class ResultFormatterVisitor : public PqlSelectorVisitor {
   private:
     PqlQuerySet *_query;
     QueryLinker *_linker;
+    const PredicateDomain *_domain;
     std::vector<std::string> _result;
 };
 
 std::vector<std::string> format_result(
-    PqlQuerySet *query, QueryLinker *linker)
+    PqlQuerySet *query, QueryLinker *linker, const PredicateDomain *domain)
 {
     PqlSelector *selector = query->selector.get();
 
-    ResultFormatterVisitor visitor(query, linker);
+    ResultFormatterVisitor visitor(query, linker, domain);
     selector->accept_pql_selector_visitor(&visitor);
     
     return visitor.return_result();
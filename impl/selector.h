@@ -22,14 +22,19 @@
 #include <string>
 #include "simple/query.h"
 #include "simple/linker.h"
+#include "impl/predicate_domain.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
 
+/*
+ * Format the result of a solved query with the names rendered by the
+ * predicate domain of the program.
+ */
 std::vector<std::string> format_result(
-    PqlQuerySet *query, QueryLinker *linker);
+    PqlQuerySet *query, QueryLinker *linker, const PredicateDomain *domain);
 
 }
 }
\ No newline at end of file
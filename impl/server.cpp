@@ -0,0 +1,240 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <future>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <functional>
+#include <condition_variable>
+
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+
+#include "impl/query_server.h"
+
+using namespace std;
+using simple::impl::QueryServer;
+
+/*
+ * Serve one client. Queries are read and submitted to the thread pool
+ * as they arrive, and a writer thread sends the responses back in the
+ * order of their requests. Any other request waits for the queries 
+ * before it, and the requests after it wait for it, so that a client
+ * always sees its own loads and drops. QUIT or the end of input ends
+ * the session.
+ */
+void serve_client(QueryServer& server,
+    function<bool(string&)> read_line,
+    function<void(const string&)> write_line)
+{
+    deque< shared_future<string> > pending;
+    vector< shared_future<string> > running;
+    mutex pending_mutex;
+    condition_variable pending_ready;
+    bool done = false;
+
+    thread writer([&]() {
+        while(true) {
+            shared_future<string> response;
+
+            {
+                unique_lock<mutex> lock(pending_mutex);
+                while(pending.empty() && !done) pending_ready.wait(lock);
+
+                if(pending.empty()) return;
+
+                response = move(pending.front());
+                pending.pop_front();
+            }
+
+            write_line(response.get());
+        }
+    });
+
+    string line;
+    while(read_line(line)) {
+        if(!line.empty() && line[line.size()-1] == '\r') line.erase(line.size()-1);
+        if(line.empty()) continue;
+        if(line == "QUIT") break;
+
+        bool is_query = line.compare(0, 6, "QUERY ") == 0;
+
+        if(!is_query) {
+            for(auto it = running.begin(); it != running.end(); ++it) it->wait();
+            running.clear();
+        }
+
+        shared_future<string> response = server.submit(line).share();
+
+        if(is_query) {
+            running.push_back(response);
+        } else {
+            response.wait();
+        }
+
+        lock_guard<mutex> lock(pending_mutex);
+        pending.push_back(move(response));
+        pending_ready.notify_one();
+    }
+
+    {
+        lock_guard<mutex> lock(pending_mutex);
+        done = true;
+    }
+    pending_ready.notify_one();
+
+    writer.join();
+}
+
+/*
+ * Line reader over a socket.
+ */
+class SocketReader {
+  public:
+    SocketReader(int fd) : _fd(fd) { }
+
+    bool operator()(string& line) {
+        while(true) {
+            string::size_type pos = _buffer.find('\n');
+            if(pos != string::npos) {
+                line = _buffer.substr(0, pos);
+                _buffer.erase(0, pos + 1);
+                return true;
+            }
+
+            char chunk[4096];
+            ssize_t count = recv(_fd, chunk, sizeof(chunk), 0);
+            if(count <= 0) {
+                line.swap(_buffer);
+                _buffer.clear();
+                return !line.empty();
+            }
+
+            _buffer.append(chunk, count);
+        }
+    }
+
+  private:
+    int     _fd;
+    string  _buffer;
+};
+
+void write_socket(int fd, const string& response) {
+    string data = response + "\n";
+    const char *it = data.c_str();
+    size_t left = data.size();
+
+    while(left > 0) {
+        ssize_t count = send(fd, it, left, MSG_NOSIGNAL);
+        if(count <= 0) return;
+
+        it += count;
+        left -= count;
+    }
+}
+
+int serve_socket(QueryServer& server, const string& path) {
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listen_fd < 0) {
+        cerr << "Unable to create socket." << endl;
+        return 1;
+    }
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if(path.size() >= sizeof(address.sun_path)) {
+        cerr << "Socket path too long: " << path << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    unlink(path.c_str());
+    if(::bind(listen_fd, (sockaddr*) &address, sizeof(address)) < 0 ||
+       listen(listen_fd, 16) < 0) 
+    {
+        cerr << "Unable to listen on " << path << endl;
+        return 1;
+    }
+
+    while(true) {
+        int client_fd = accept(listen_fd, NULL, NULL);
+        if(client_fd < 0) continue;
+
+        thread([&server, client_fd]() {
+            serve_client(server, SocketReader(client_fd),
+                [client_fd](const string& response) {
+                    write_socket(client_fd, response);
+                });
+            close(client_fd);
+        }).detach();
+    }
+
+    return 0;
+}
+
+int main(int argc, const char* argv[]) {
+    string socket_path;
+    int thread_count = thread::hardware_concurrency();
+    vector<string> preload;
+
+    for(int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+
+        if(arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if(arg == "--threads" && i + 1 < argc) {
+            thread_count = atoi(argv[++i]);
+        } else if(arg.find('=') != string::npos) {
+            preload.push_back(arg);
+        } else {
+            cout << "Usage: server [--socket path] [--threads n] [name=source_file ...]" << endl;
+            return 0;
+        }
+    }
+
+    if(thread_count < 1) thread_count = 1;
+
+    QueryServer server(thread_count);
+
+    for(auto it = preload.begin(); it != preload.end(); ++it) {
+        string::size_type pos = it->find('=');
+        cerr << server.handle_request("LOAD " + it->substr(0, pos) + 
+            " " + it->substr(pos + 1)) << endl;
+    }
+
+    if(!socket_path.empty()) {
+        return serve_socket(server, socket_path);
+    }
+
+    ios_base::sync_with_stdio(false);
+
+    serve_client(server,
+        [](string& line) { return (bool) getline(cin, line); },
+        [](const string& response) { cout << response << endl; });
+
+    return 0;
+}
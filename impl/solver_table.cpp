@@ -3,6 +3,7 @@
 
 #include "impl/solvers/affects.h"
 #include "impl/solvers/iaffects.h"
+#include "impl/solvers/affects_bip.h"
 #include "impl/solvers/follows.h"
 #include "impl/solvers/ifollows.h"
 #include "impl/solvers/parent.h"
@@ -17,9 +18,10 @@
 #include "impl/solvers/modifies.h"
 #include "impl/solvers/sibling.h"
 #include "impl/solvers/uses.h"
-#include "impl/solvers/next.h"
+#include "impl/solvers/next_cached.h"
 #include "impl/solvers/next_bip.h"
 #include "impl/solvers/inext.h"
+#include "impl/solvers/inext_bip.h"
 
 #include "simple/util/solver_generator.h"
 
@@ -30,6 +32,38 @@ using namespace simple;
 using namespace simple::util;
 
 SolverTable create_solver_table(SimpleRoot ast) {
+    return ProgramSolvers(ast).get_solver_table();
+}
+
+ProgramSolvers::ProgramSolvers(SimpleRoot ast) : 
+    _ast(ast), 
+    _calls_solver(new CallSolver(ast)),
+    _modifies_solver(new ModifiesSolver(ast)),
+    _uses_solver(new UsesSolver(ast))
+{
+    create_solvers();
+}
+
+const SolverTable& ProgramSolvers::get_solver_table() {
+    return _solver_table;
+}
+
+void ProgramSolvers::update_procs(const std::set<ProcAst*>& changed_procs,
+    const std::vector<StatementAst*>& old_bodies)
+{
+    _calls_solver->update_procs(changed_procs);
+    _modifies_solver->update_procs(changed_procs, old_bodies, _calls_solver.get());
+    _uses_solver->update_procs(changed_procs, old_bodies, _calls_solver.get());
+
+    create_solvers();
+}
+
+/*
+ * Build the solver table around the solvers that are patched, which are
+ * wrapped again so that nothing their wrappers cached is kept.
+ */
+void ProgramSolvers::create_solvers() {
+    SimpleRoot ast = _ast;
     SolverTable solver_table;
 
     solver_table["follows"] = std::shared_ptr<QuerySolver>(
@@ -44,7 +78,7 @@ SolverTable create_solver_table(SimpleRoot ast) {
     solver_table["iparent"] = std::shared_ptr<QuerySolver>(
         new SimpleSolverGenerator<IParentSolver>(new IParentSolver(ast)));
 
-    std::shared_ptr<CallSolver> calls_solver(new CallSolver(ast));
+    std::shared_ptr<CallSolver> calls_solver = _calls_solver;
 
     solver_table["calls"] = std::shared_ptr<QuerySolver>(
         new SimpleSolverGenerator<CallSolver>(calls_solver));
@@ -62,49 +96,53 @@ SolverTable create_solver_table(SimpleRoot ast) {
     solver_table["iexpr"] = std::shared_ptr<QuerySolver>(
         new SimpleSolverGenerator<IExprSolver>(new IExprSolver(ast)));
 
-    std::shared_ptr<ModifiesSolver> modifies_solver(new ModifiesSolver(ast));
+    std::shared_ptr<ModifiesSolver> modifies_solver = _modifies_solver;
 
     solver_table["modifies"] = std::shared_ptr<QuerySolver>(
         new SimpleSolverGenerator<ModifiesSolver>(modifies_solver));
 
     solver_table["uses"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<UsesSolver>(new UsesSolver(ast)));
+        new SimpleSolverGenerator<UsesSolver>(_uses_solver));
 
-    std::shared_ptr<NextSolver> next_solver(new NextSolver(ast));
+    std::shared_ptr<CachedNextSolver> next_solver(new CachedNextSolver(ast));
+    const ControlFlowGraph *graph = next_solver->get_graph();
 
     std::shared_ptr<NextBipSolver> next_bip_solver(new NextBipSolver(
         ast, next_solver, calls_solver));
 
     solver_table["next"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<NextSolver>(next_solver));
+        new SimpleSolverGenerator<CachedNextSolver>(next_solver));
 
     solver_table["nextbip"] = std::shared_ptr<QuerySolver>(
         new SimpleSolverGenerator<NextBipSolver>(next_bip_solver));
 
     solver_table["inext"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<INextSolver>(new INextSolver(ast, next_solver)));
+        new SimpleSolverGenerator<INextSolver>(
+            new INextSolver(ast, next_solver, graph)));
 
     solver_table["inextbip"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<INextSolver>(new INextSolver(ast, next_bip_solver)));
+        new SimpleSolverGenerator<INextBipSolver>(new INextBipSolver(next_bip_solver)));
 
     solver_table["affects"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<AffectsSolver>(new AffectsSolver(next_solver, modifies_solver)));
+        new SimpleSolverGenerator<AffectsSolver>(
+            new AffectsSolver(next_solver, modifies_solver, graph)));
 
     solver_table["iaffects"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<IAffectsSolver>(new IAffectsSolver(next_solver, modifies_solver)));
+        new SimpleSolverGenerator<IAffectsSolver>(
+            new IAffectsSolver(next_solver, modifies_solver, graph)));
 
     solver_table["affectsbip"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<AffectsSolver>(new AffectsSolver(next_bip_solver, modifies_solver)));
+        new SimpleSolverGenerator<AffectsBipSolver>(new AffectsBipSolver(next_bip_solver, false)));
 
     solver_table["iaffectsbip"] = std::shared_ptr<QuerySolver>(
-        new SimpleSolverGenerator<IAffectsSolver>(new IAffectsSolver(next_bip_solver, modifies_solver)));
+        new SimpleSolverGenerator<AffectsBipSolver>(new AffectsBipSolver(next_bip_solver, true)));
 
     solver_table["contains"] = std::shared_ptr<QuerySolver>(new ContainsSolver(ast, false));
     solver_table["icontains"] = std::shared_ptr<QuerySolver>(new ContainsSolver(ast, true));
 
     solver_table["sibling"] = std::shared_ptr<QuerySolver>(new SiblingSolver(ast));
 
-    return solver_table;
+    _solver_table.swap(solver_table);
 }
 
 }
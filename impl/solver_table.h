@@ -1,6 +1,8 @@
-
 #pragma once
 
+#include <set>
+#include <vector>
+#include <memory>
 #include "simple/ast.h"
 #include "simple/solver.h"
 
@@ -9,7 +11,45 @@ namespace impl {
 
 using namespace simple;
 
+class CallSolver;
+class ModifiesSolver;
+class UsesSolver;
+
 SolverTable create_solver_table(SimpleRoot ast);
 
+/*
+ * ProgramSolvers builds the solver table of a program, and patches it
+ * when IncrementalParser replaces the bodies of some procedures in place.
+ *
+ * Follows, Parent and their transitive forms read the statements 
+ * directly, so they hold nothing to patch. Calls, Modifies and Uses
+ * patch their indexes for the changed procedures and their callers. 
+ * Every other solver indexes the control flow or the expressions of the
+ * whole program, and is built again, dropping its caches.
+ */
+class ProgramSolvers {
+  public:
+    ProgramSolvers(SimpleRoot ast);
+
+    const SolverTable& get_solver_table();
+
+    /*
+     * Patch the solvers after the bodies of changed_procs were replaced
+     * and every statement was renumbered. old_bodies are the replaced
+     * bodies, which must still be alive.
+     */
+    void update_procs(const std::set<ProcAst*>& changed_procs,
+        const std::vector<StatementAst*>& old_bodies);
+
+  private:
+    void create_solvers();
+
+    SimpleRoot                      _ast;
+    std::shared_ptr<CallSolver>     _calls_solver;
+    std::shared_ptr<ModifiesSolver> _modifies_solver;
+    std::shared_ptr<UsesSolver>     _uses_solver;
+    SolverTable                     _solver_table;
+};
+
+}
 }
-}
\ No newline at end of file
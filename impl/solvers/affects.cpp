@@ -1,5 +1,7 @@
 
 #include "simple/util/expr_util.h"
+#include "simple/util/ast_utils.h"
+#include "simple/util/condition_utils.h"
 #include "simple/util/set_convert.h"
 #include "impl/solvers/affects.h"
 #include "simple/util/statement_visitor_generator.h"
@@ -66,8 +68,13 @@ class SolveAffectingStatementsVisitorTraits {
 
 AffectsSolver::AffectsSolver(
     std::shared_ptr<NextBipQuerySolver> next_solver,
-    std::shared_ptr<ModifiesSolver> modifies_solver) :
-    _next_solver(next_solver), _modifies_solver(modifies_solver)
+    std::shared_ptr<ModifiesSolver> modifies_solver,
+    const ControlFlowGraph *graph,
+    const std::string& name) :
+    _next_solver(next_solver), _modifies_solver(modifies_solver), 
+    _graph(graph),
+    _affected_statements_cache(name + ".affected"),
+    _affecting_statements_cache(name + ".affecting")
 { }
 
 StackedStatementSet AffectsSolver::solve_affected_by_var_assignment(
@@ -104,7 +111,9 @@ StackedStatementSet AffectsSolver::solve_affecting_with_var_assignment(
 
 template <>
 StatementSet AffectsSolver::solve_affected_statements<StatementAst>(StatementAst *statement) {
-    if(_affected_statements_cache.count(statement) > 0) return _affected_statements_cache[statement];
+    std::shared_ptr<const StatementSet> cached = 
+        _affected_statements_cache.find(statement);
+    if(cached != NULL) return *cached;
 
     _visit_cache.clear();
 
@@ -114,7 +123,7 @@ StatementSet AffectsSolver::solve_affected_statements<StatementAst>(StatementAst
     statement->accept_statement_visitor(&visitor);
     StatementSet result = visitor.return_result();
 
-    _affected_statements_cache[statement] = result;
+    _affected_statements_cache.insert(statement, result);
     return result;
 }
 
@@ -149,7 +158,13 @@ StackedStatementSet AffectsSolver::solve_next_affected_by_var(
     StackedStatementSet result;
 
     for(auto it=next.begin(); it != next.end(); ++it) {
-        union_set(result, solve_affected_by_var<StatementAst>(var, it->first, it->second));
+        StatementAst *block_end = skip_block(var, it->first, true);
+
+        if(block_end == it->first) {
+            union_set(result, solve_affected_by_var<StatementAst>(var, it->first, it->second));
+        } else if(_visit_cache.insert(std::make_pair(var, *it)).second) {
+            union_set(result, solve_next_affected_by_var(var, block_end, it->second));
+        }
     }
 
     return result;
@@ -201,9 +216,7 @@ template <>
 StackedStatementSet AffectsSolver::solve_affected_by_var<CallAst>(
     SimpleVariable var, CallAst *statement, CallStack callstack)
 {
-    if(!_next_solver->is_bip() && _modifies_solver->get_vars_modified_by_proc(
-        statement->get_proc_called()).count(var) > 0)
-    {
+    if(is_killed_by_call(var, statement)) {
         return StackedStatementSet();
     }
     
@@ -212,7 +225,9 @@ StackedStatementSet AffectsSolver::solve_affected_by_var<CallAst>(
 
 template <>
 StatementSet AffectsSolver::solve_affecting_statements<StatementAst>(StatementAst *statement) {
-    if(_affecting_statements_cache.count(statement) > 0) return _affecting_statements_cache[statement];
+    std::shared_ptr<const StatementSet> cached = 
+        _affecting_statements_cache.find(statement);
+    if(cached != NULL) return *cached;
 
     _visit_cache.clear();
 
@@ -222,7 +237,7 @@ StatementSet AffectsSolver::solve_affecting_statements<StatementAst>(StatementAs
     statement->accept_statement_visitor(&visitor);
     StatementSet result = visitor.return_result();
 
-    _affecting_statements_cache[statement] = result;
+    _affecting_statements_cache.insert(statement, result);
     return result;
 }
 
@@ -246,7 +261,13 @@ StackedStatementSet AffectsSolver::solve_prev_affecting_with_var(
     
     StackedStatementSet result;
     for(auto it=prev.begin(); it != prev.end(); ++it) {
-        union_set(result, solve_affecting_with_var<StatementAst>(var, it->first, it->second));
+        StatementAst *block_begin = skip_block(var, it->first, false);
+
+        if(block_begin == it->first) {
+            union_set(result, solve_affecting_with_var<StatementAst>(var, it->first, it->second));
+        } else if(_visit_cache.insert(std::make_pair(var, *it)).second) {
+            union_set(result, solve_prev_affecting_with_var(var, block_begin, it->second));
+        }
     }
 
     return result;
@@ -298,15 +319,162 @@ template <>
 StackedStatementSet AffectsSolver::solve_affecting_with_var<CallAst>(
     SimpleVariable var, CallAst *statement, CallStack callstack)
 {
-    if(!_next_solver->is_bip() && _modifies_solver->get_vars_modified_by_proc(
-        statement->get_proc_called()).count(var) > 0)
-    {
+    if(is_killed_by_call(var, statement)) {
         return StackedStatementSet();
     }
 
     return solve_prev_affecting_with_var(var, statement, callstack);
 }
 
+/*
+ * Outside of BIP a call statement that modifies the variable stops
+ * the variable from reaching further. Within BIP the modification is
+ * found by walking through the called procedure instead.
+ */
+bool AffectsSolver::is_killed_by_call(const SimpleVariable& var, CallAst *call) {
+    return !_next_solver->is_bip() && _modifies_solver->get_vars_modified_by_proc(
+        call->get_proc_called()).count(var) > 0;
+}
+
+StatementAst* AffectsSolver::skip_block(const SimpleVariable& var,
+    StatementAst *statement, bool forward)
+{
+    if(_graph == NULL || _next_solver->is_bip()) return statement;
+
+    int id = _graph->get_id(statement);
+    if(id == -1) return statement;
+
+    int block = _graph->get_block(id);
+    int begin = _graph->get_block_begin(block);
+    int end = _graph->get_block_end(block);
+
+    if(id != (forward ? begin : end - 1)) return statement;
+
+    const ControlFlowGraph::BlockSummary& summary = 
+        _graph->get_block_summary(block);
+
+    if(summary.modified.count(var) > 0) return statement;
+    if(forward && summary.used.count(var) > 0) return statement;
+
+    for(auto it = summary.calls.begin(); it != summary.calls.end(); ++it) {
+        if(is_killed_by_call(var, *it)) return statement;
+    }
+
+    return _graph->get_statement(forward ? end - 1 : begin);
+}
+
+/*
+ * Short-circuiting version of solve_affected_statements(). Walk the
+ * control flow from the statement and stop at the first assignment
+ * that uses the modified variable.
+ */
+bool AffectsSolver::has_affected_statements(AssignmentAst *statement) {
+    std::shared_ptr<const StatementSet> cached = 
+        _affected_statements_cache.find(statement);
+    if(cached != NULL) return !cached->empty();
+
+    SimpleVariable var = *statement->get_variable();
+
+    StackedStatementSet visited;
+    StackedStatementSet worklist = _next_solver->solve_next_bip_statement(
+        statement, CallStack());
+
+    while(!worklist.empty()) {
+        StackedStatement current = *worklist.begin();
+        worklist.erase(worklist.begin());
+
+        if(!visited.insert(current).second) continue;
+
+        StatementAst *next = skip_block(var, current.first, true);
+        StatementType type = get_statement_type(next);
+
+        if(type == AssignST) {
+            AssignmentAst *assign = statement_cast<AssignmentAst>(next);
+
+            if(get_expr_vars(assign->get_expr()).count(var) > 0) return true;
+            if(*assign->get_variable() == var) continue;
+
+        } else if(type == CallST) {
+            if(is_killed_by_call(var, statement_cast<CallAst>(next))) continue;
+        }
+
+        union_set(worklist, _next_solver->solve_next_bip_statement(
+            next, current.second));
+    }
+
+    return false;
+}
+
+/*
+ * Short-circuiting version of solve_affecting_statements(). Walk the
+ * control flow backward for each used variable and stop at the first
+ * assignment that modifies it.
+ */
+bool AffectsSolver::has_affecting_statements(AssignmentAst *statement) {
+    std::shared_ptr<const StatementSet> cached = 
+        _affecting_statements_cache.find(statement);
+    if(cached != NULL) return !cached->empty();
+
+    VariableSet used_vars = get_expr_vars(statement->get_expr());
+
+    for(auto it = used_vars.begin(); it != used_vars.end(); ++it) {
+        const SimpleVariable& var = *it;
+
+        StackedStatementSet visited;
+        StackedStatementSet worklist = _next_solver->solve_prev_bip_statement(
+            statement, CallStack());
+
+        while(!worklist.empty()) {
+            StackedStatement current = *worklist.begin();
+            worklist.erase(worklist.begin());
+
+            if(!visited.insert(current).second) continue;
+
+            StatementAst *prev = skip_block(var, current.first, false);
+            StatementType type = get_statement_type(prev);
+
+            if(type == AssignST) {
+                AssignmentAst *assign = statement_cast<AssignmentAst>(prev);
+                if(*assign->get_variable() == var) return true;
+
+            } else if(type == CallST) {
+                if(is_killed_by_call(var, statement_cast<CallAst>(prev))) continue;
+            }
+
+            union_set(worklist, _next_solver->solve_prev_bip_statement(
+                prev, current.second));
+        }
+    }
+
+    return false;
+}
+
+template <>
+bool AffectsSolver::has_right<StatementAst>(StatementAst *statement) {
+    AssignmentAst *assign = statement_cast<AssignmentAst>(statement);
+    return assign != NULL && has_affected_statements(assign);
+}
+
+template <>
+bool AffectsSolver::has_left<StatementAst>(StatementAst *statement) {
+    AssignmentAst *assign = statement_cast<AssignmentAst>(statement);
+    return assign != NULL && has_affecting_statements(assign);
+}
+
+bool AffectsSolver::is_nonempty(const ConditionSet& universe) {
+    for(auto it = universe.begin(); it != universe.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+
+        if(condition != NULL && has_right<StatementAst>(
+            condition->get_statement_ast())) 
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool AffectsSolver::validate_affect(StatementAst *affecting, StatementAst *affected) {
     return solve_affected_statements<StatementAst>(affecting).count(affected) > 0;
 }
@@ -3,10 +3,15 @@
 
 #include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include "simple/solver.h"
 #include "simple/next.h"
 #include "impl/solvers/modifies.h"
+#include "impl/solvers/control_flow_graph.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/relation_index.h"
+#include "simple/util/memo_cache.h"
 
 namespace simple {
 namespace impl {
@@ -16,8 +21,15 @@ using namespace simple::util;
 
 class AffectsSolver {
   public:
+    /*
+     * With the control flow graph of the next solver, the walks skip the
+     * basic blocks that do not touch the variable they follow. The name
+     * prefixes the names of the result caches.
+     */
     AffectsSolver(std::shared_ptr<NextBipQuerySolver> next_solver,
-        std::shared_ptr<ModifiesSolver> modifies_solver);
+        std::shared_ptr<ModifiesSolver> modifies_solver,
+        const ControlFlowGraph *graph = NULL,
+        const std::string& name = "affects");
 
     virtual StackedStatementSet solve_affected_by_var_assignment(
         SimpleVariable var, AssignmentAst *statement, CallStack callstack);
@@ -55,13 +67,36 @@ class AffectsSolver {
     template <typename Condition>
     StackedStatementSet solve_affecting_with_var(
         SimpleVariable var, Condition *statement, CallStack callstack);
+
+    template <typename Condition>
+    bool has_right(Condition *condition);
+
+    template <typename Condition>
+    bool has_left(Condition *condition);
+
+    bool is_nonempty(const ConditionSet& universe);
+
+    bool has_affected_statements(AssignmentAst *statement);
+    bool has_affecting_statements(AssignmentAst *statement);
     
   protected:
+    bool is_killed_by_call(const SimpleVariable& var, CallAst *call);
+
+    /*
+     * The statement a walk following the variable continues from. If
+     * the statement starts a block in the direction of the walk, and no
+     * statement in the block uses, modifies or kills the variable, this
+     * is the other end of the block. Otherwise it is the statement.
+     */
+    StatementAst* skip_block(const SimpleVariable& var, 
+        StatementAst *statement, bool forward);
+
     std::shared_ptr<NextBipQuerySolver> _next_solver;
     std::shared_ptr<ModifiesSolver> _modifies_solver;
+    const ControlFlowGraph *_graph;
 
-    std::map< StatementAst*, StatementSet > _affected_statements_cache;
-    std::map< StatementAst*, StatementSet > _affecting_statements_cache;
+    MemoCache<StatementAst*, StatementSet> _affected_statements_cache;
+    MemoCache<StatementAst*, StatementSet> _affecting_statements_cache;
 
     std::set< std::pair<SimpleVariable, StackedStatement> > 
     _visit_cache;
@@ -92,6 +127,16 @@ ConditionSet AffectsSolver::solve_left(Condition *condition) {
     return ConditionSet(); // empty set
 }
 
+template <typename Condition>
+bool AffectsSolver::has_right(Condition *condition) {
+    return false;
+}
+
+template <typename Condition>
+bool AffectsSolver::has_left(Condition *condition) {
+    return false;
+}
+
 template <>
 StackedStatementSet AffectsSolver::solve_affected_by_var<StatementAst>(
     SimpleVariable var, StatementAst *statement, CallStack callstack);
@@ -143,5 +188,16 @@ template <>
 bool AffectsSolver::validate<StatementAst, StatementAst>(
     StatementAst *affecting, StatementAst *affected);
 
+template <>
+bool AffectsSolver::has_right<StatementAst>(StatementAst *statement);
+
+template <>
+bool AffectsSolver::has_left<StatementAst>(StatementAst *statement);
+
+template <>
+class SolverExistenceTraits<AffectsSolver> : 
+    public DirectSolverExistenceTraits<AffectsSolver> 
+{ };
+
 }
 }
\ No newline at end of file
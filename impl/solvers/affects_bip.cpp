@@ -0,0 +1,280 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "impl/solvers/affects_bip.h"
+#include "simple/util/ast_utils.h"
+#include "simple/util/expr_util.h"
+#include "simple/util/set_utils.h"
+#include "simple/util/set_convert.h"
+#include "simple/util/condition_utils.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+typedef NextBipGraph::DirectedGraph DirectedGraph;
+
+void AffectsBipSolver::Worklist::add(int node, const SimpleVariable& var) {
+    Fact fact(node, var);
+    if(visited.insert(fact).second) pending.push_back(fact);
+}
+
+AffectsBipSolver::AffectsBipSolver(
+    std::shared_ptr<NextBipSolver> next_bip_solver, bool transitive) :
+    _next_bip_solver(next_bip_solver), 
+    _graph(next_bip_solver->get_graph()),
+    _transitive(transitive),
+    _affected_cache(transitive ? "iaffects_bip.affected" : "affects_bip.affected"),
+    _affecting_cache(transitive ? "iaffects_bip.affecting" : "affects_bip.affecting")
+{ }
+
+const DirectedGraph& AffectsBipSolver::get_graph(Direction direction) {
+    if(direction == Forward) {
+        return _graph->get_forward_graph();
+    } else {
+        return _graph->get_backward_graph();
+    }
+}
+
+StatementSet AffectsBipSolver::solve_affected_statements(StatementAst *statement) {
+    std::shared_ptr<const StatementSet> cached = _affected_cache.find(statement);
+    if(cached != NULL) return *cached;
+
+    StatementSet result;
+    AssignmentAst *assign = statement_cast<AssignmentAst>(statement);
+    int node = _graph->get_node(statement);
+
+    if(assign != NULL && node != -1) {
+        VariableSet vars;
+        vars.insert(*assign->get_variable());
+
+        Worklist worklist;
+        VariableSet end_facts;
+
+        propagate_facts(Forward, node, vars, true, worklist, result);
+        solve_facts(Forward, worklist, -1, result, end_facts);
+    }
+
+    _affected_cache.insert(statement, result);
+    return result;
+}
+
+StatementSet AffectsBipSolver::solve_affecting_statements(StatementAst *statement) {
+    std::shared_ptr<const StatementSet> cached = _affecting_cache.find(statement);
+    if(cached != NULL) return *cached;
+
+    StatementSet result;
+    AssignmentAst *assign = statement_cast<AssignmentAst>(statement);
+    int node = _graph->get_node(statement);
+
+    if(assign != NULL && node != -1) {
+        VariableSet vars = get_expr_vars(assign->get_expr());
+
+        Worklist worklist;
+        VariableSet end_facts;
+
+        propagate_facts(Backward, node, vars, true, worklist, result);
+        solve_facts(Backward, worklist, -1, result, end_facts);
+    }
+
+    _affecting_cache.insert(statement, result);
+    return result;
+}
+
+/*
+ * The summary is stored before it is computed, so a recursive call
+ * sees it empty instead of looping forever.
+ */
+const AffectsBipSolver::ProcSummary& AffectsBipSolver::get_summary(
+    Direction direction, int proc, const SimpleVariable& var)
+{
+    SummaryTable& summaries = (direction == Forward) ?
+        _forward_summaries : _backward_summaries;
+
+    Fact key(proc, var);
+    const ProcSummary *cached = summaries.find(key);
+    if(cached != NULL) return *cached;
+
+    summaries.insert(key);
+    const DirectedGraph& graph = get_graph(direction);
+
+    Worklist worklist;
+    const std::vector<int>& start_nodes = graph.start_nodes[proc];
+
+    for(auto node = start_nodes.begin(); node != start_nodes.end(); ++node) {
+        worklist.add(*node, var);
+    }
+
+    StatementSet statements;
+    VariableSet end_facts;
+    solve_facts(direction, worklist, graph.end_nodes[proc], 
+        statements, end_facts);
+
+    /*
+     * The recursive calls may have moved the summary within the table,
+     * so it is looked up again.
+     */
+    ProcSummary& summary = *summaries.find(key);
+    summary.statements.swap(statements);
+    summary.end_facts.swap(end_facts);
+
+    return summary;
+}
+
+/*
+ * Run the worklist to a fixpoint. Facts reaching the end node are 
+ * collected instead of being propagated further. Without an end node,
+ * the facts leave the procedure through its return edges, which is 
+ * allowed when the call stack is empty.
+ */
+void AffectsBipSolver::solve_facts(Direction direction, Worklist& worklist,
+    int end_node, StatementSet& statements, VariableSet& end_facts)
+{
+    while(!worklist.pending.empty()) {
+        Fact fact = worklist.pending.back();
+        worklist.pending.pop_back();
+
+        if(fact.first == end_node) {
+            end_facts.insert(fact.second);
+            continue;
+        }
+
+        VariableSet vars = apply_facts(direction, 
+            fact.first, fact.second, statements);
+
+        propagate_facts(direction, fact.first, vars, end_node == -1,
+            worklist, statements);
+    }
+}
+
+/*
+ * Get the facts holding after a node, and add the node to the affected
+ * statements if it is an assignment that the fact reaches.
+ */
+VariableSet AffectsBipSolver::apply_facts(Direction direction, int node,
+    const SimpleVariable& var, StatementSet& statements)
+{
+    VariableSet result;
+    StatementAst *statement = _graph->get_statement(node);
+    AssignmentAst *assign = (statement != NULL) ? 
+        statement_cast<AssignmentAst>(statement) : NULL;
+
+    if(assign == NULL) {
+        result.insert(var);
+        return result;
+    }
+
+    SimpleVariable modified_var = *assign->get_variable();
+    VariableSet used_vars = get_expr_vars(assign->get_expr());
+
+    if(modified_var != var) result.insert(var);
+
+    if(direction == Forward && used_vars.count(var) > 0) {
+        statements.insert(assign);
+        if(_transitive) result.insert(modified_var);
+
+    } else if(direction == Backward && modified_var == var) {
+        statements.insert(assign);
+        if(_transitive) union_set(result, used_vars);
+    }
+
+    return result;
+}
+
+/*
+ * Propagate facts along the intraprocedural edges of a node. A call
+ * site is crossed through the summaries of the called procedure rather
+ * than its call and summary edges.
+ */
+void AffectsBipSolver::propagate_facts(Direction direction, int node,
+    const VariableSet& vars, bool follow_returns,
+    Worklist& worklist, StatementSet& statements)
+{
+    const DirectedGraph& graph = get_graph(direction);
+    const std::vector<NextBipGraph::Edge>& edges = graph.edges[node];
+    auto call_site = graph.call_sites.find(node);
+
+    for(auto var = vars.begin(); var != vars.end(); ++var) {
+        for(auto it = edges.begin(); it != edges.end(); ++it) {
+            if(it->type == NextBipGraph::IntraEdge ||
+               (it->type == NextBipGraph::ReturnEdge && follow_returns))
+            {
+                worklist.add(it->target, *var);
+            }
+        }
+
+        if(call_site == graph.call_sites.end()) continue;
+
+        const ProcSummary& summary = get_summary(
+            direction, call_site->second.proc, *var);
+
+        union_set(statements, summary.statements);
+
+        for(auto it = summary.end_facts.begin(); 
+            it != summary.end_facts.end(); ++it)
+        {
+            worklist.add(call_site->second.target, *it);
+        }
+    }
+}
+
+template <>
+ConditionSet AffectsBipSolver::solve_right<StatementAst>(StatementAst *statement) {
+    return statement_set_to_condition_set(solve_affected_statements(statement));
+}
+
+template <>
+ConditionSet AffectsBipSolver::solve_left<StatementAst>(StatementAst *statement) {
+    return statement_set_to_condition_set(solve_affecting_statements(statement));
+}
+
+template <>
+bool AffectsBipSolver::validate<StatementAst, StatementAst>(
+    StatementAst *affecting, StatementAst *affected)
+{
+    return solve_affected_statements(affecting).count(affected) > 0;
+}
+
+template <>
+bool AffectsBipSolver::has_right<StatementAst>(StatementAst *statement) {
+    return !solve_affected_statements(statement).empty();
+}
+
+template <>
+bool AffectsBipSolver::has_left<StatementAst>(StatementAst *statement) {
+    return !solve_affecting_statements(statement).empty();
+}
+
+bool AffectsBipSolver::is_nonempty(const ConditionSet& universe) {
+    for(auto it = universe.begin(); it != universe.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+
+        if(condition != NULL && has_right<StatementAst>(
+            condition->get_statement_ast())) 
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace impl
+} // namespace simple
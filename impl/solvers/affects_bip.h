@@ -0,0 +1,166 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <vector>
+#include <memory>
+#include <utility>
+#include "simple/solver.h"
+#include "simple/condition_set.h"
+#include "simple/ast.h"
+#include "impl/solvers/next_bip.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/relation_index.h"
+#include "simple/util/memo_cache.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * Solver for AffectsBip, or AffectsBip* if transitive is set.
+ *
+ * The data flow of a variable is propagated as facts on the nodes of
+ * NextBipGraph. A fact is a variable whose last assignment is being
+ * tracked. An assignment kills the fact of the variable it modifies and,
+ * for AffectsBip*, passes a fact on to its own modified variable going
+ * forward or to its used variables going backward.
+ *
+ * Call statements do not kill any fact. Instead, each procedure has a
+ * summary for every fact it is entered with, holding the statements
+ * affected inside the procedure and its callees, and the facts that
+ * reach its end node. The summary is computed once on first use, which
+ * computes the summaries of the called procedures first, and is then
+ * stitched in at every call site without walking the callee again.
+ *
+ * Going backward, the facts are propagated over the transpose of the
+ * forward graph. A backward summary starts at the exit node of the
+ * procedure, so solve_left always agrees with solve_right.
+ */
+class AffectsBipSolver {
+  public:
+    AffectsBipSolver(std::shared_ptr<NextBipSolver> next_bip_solver,
+        bool transitive);
+
+    StatementSet solve_affected_statements(StatementAst *statement);
+    StatementSet solve_affecting_statements(StatementAst *statement);
+
+    template <typename Condition>
+    ConditionSet solve_right(Condition *condition) {
+        return ConditionSet();
+    }
+
+    template <typename Condition>
+    ConditionSet solve_left(Condition *condition) {
+        return ConditionSet();
+    }
+
+    template <typename Condition1, typename Condition2>
+    bool validate(Condition1 *condition1, Condition2 *condition2) {
+        return false;
+    }
+
+    template <typename Condition>
+    bool has_right(Condition *condition) {
+        return false;
+    }
+
+    template <typename Condition>
+    bool has_left(Condition *condition) {
+        return false;
+    }
+
+    bool is_nonempty(const ConditionSet& universe);
+
+  private:
+    enum Direction {
+        Forward,
+        Backward
+    };
+
+    typedef std::pair<int, SimpleVariable> Fact;
+
+    struct Worklist {
+        void add(int node, const SimpleVariable& var);
+
+        std::set<Fact>      visited;
+        std::vector<Fact>   pending;
+    };
+
+    struct ProcSummary {
+        StatementSet    statements;
+        VariableSet     end_facts;
+    };
+
+    typedef MemoCache<StatementAst*, StatementSet> AffectsTable;
+    typedef HashIndex<Fact, ProcSummary>            SummaryTable;
+
+    const NextBipGraph::DirectedGraph& get_graph(Direction direction);
+
+    const ProcSummary& get_summary(Direction direction,
+        int proc, const SimpleVariable& var);
+
+    void solve_facts(Direction direction, Worklist& worklist, 
+        int end_node, StatementSet& statements, VariableSet& end_facts);
+
+    VariableSet apply_facts(Direction direction, int node,
+        const SimpleVariable& var, StatementSet& statements);
+
+    void propagate_facts(Direction direction, int node,
+        const VariableSet& vars, bool follow_returns,
+        Worklist& worklist, StatementSet& statements);
+
+    std::shared_ptr<NextBipSolver> _next_bip_solver;
+    NextBipGraph *_graph;
+    bool _transitive;
+
+    AffectsTable _affected_cache;
+    AffectsTable _affecting_cache;
+
+    SummaryTable _forward_summaries;
+    SummaryTable _backward_summaries;
+};
+
+template <>
+ConditionSet AffectsBipSolver::solve_right<StatementAst>(StatementAst *statement);
+
+template <>
+ConditionSet AffectsBipSolver::solve_left<StatementAst>(StatementAst *statement);
+
+template <>
+bool AffectsBipSolver::validate<StatementAst, StatementAst>(
+    StatementAst *affecting, StatementAst *affected);
+
+template <>
+bool AffectsBipSolver::has_right<StatementAst>(StatementAst *statement);
+
+template <>
+bool AffectsBipSolver::has_left<StatementAst>(StatementAst *statement);
+
+template <>
+class SolverExistenceTraits<AffectsBipSolver> : 
+    public DirectSolverExistenceTraits<AffectsBipSolver> 
+{ };
+
+} // namespace impl
+} // namespace simple
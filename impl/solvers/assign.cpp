@@ -20,7 +20,11 @@
 #include "impl/condition.h"
 #include "impl/solvers/modifies.h"
 #include "simple/util/set_convert.h"
+#include "simple/util/condition_domain.h"
+#include "simple/util/condition_utils.h"
 #include "simple/util/statement_visitor_generator.h"
+#include "simple/util/ast_utils.h"
+#include "simple/util/bit_set.h"
 
 namespace simple {
 namespace impl {
@@ -45,17 +49,21 @@ AssignmentSolver::AssignmentSolver(const SimpleRoot& ast,
     std::shared_ptr<VariableExtractor> variable_extractor) : 
     _ast(ast), _variable_extractor(variable_extractor)
 {
+    index_procs(CallGraph(_ast));
+
     for(SimpleRoot::iterator it = _ast.begin(); it != _ast.end(); ++it) {
-        index_variables<ProcAst>(*it);
+        index_statement_list((*it)->get_statement());
     }
+
+    _is_nonempty = !_right_condition_index.empty();
 }
 
 VariableSet AssignmentSolver::get_right_vars_from_statement(StatementAst *statement) {
-    return _left_statement_index[statement];
+    return _left_statement_index.get(statement);
 }
 
 VariableSet AssignmentSolver::get_right_vars_from_proc(ProcAst *proc) {
-    return _left_proc_index[proc];
+    return _left_proc_index.get(proc);
 }
 
 /*
@@ -63,7 +71,7 @@ VariableSet AssignmentSolver::get_right_vars_from_proc(ProcAst *proc) {
  */
 template <>
 ConditionSet AssignmentSolver::solve_left<SimpleVariable>(SimpleVariable *variable) {
-    return _right_condition_index[*variable];
+    return _right_condition_index.get(*variable);
 }
 
 /*
@@ -73,14 +81,14 @@ template <>
 bool AssignmentSolver::validate<StatementAst, SimpleVariable>(
         StatementAst *statement, SimpleVariable *var) 
 {
-    return _left_statement_index[statement].count(*var) > 0;
+    return _left_statement_index.get(statement).count(*var) > 0;
 }
 
 template <>
 bool AssignmentSolver::validate<ProcAst, SimpleVariable>(
         ProcAst *proc, SimpleVariable *var)
 {
-    return _left_proc_index[proc].count(*var) > 0;
+    return _left_proc_index.get(proc).count(*var) > 0;
 }
 
 /*
@@ -88,12 +96,86 @@ bool AssignmentSolver::validate<ProcAst, SimpleVariable>(
  */
 template <>
 ConditionSet AssignmentSolver::solve_right<StatementAst>(StatementAst *ast) {
-    return variable_set_to_condition_set(_left_statement_index[ast]);
+    return variable_set_to_condition_set(_left_statement_index.get(ast));
 }
 
 template <>
 ConditionSet AssignmentSolver::solve_right<ProcAst>(ProcAst *proc) {
-    return variable_set_to_condition_set(_left_proc_index[proc]);
+    return variable_set_to_condition_set(_left_proc_index.get(proc));
+}
+
+/*
+ * has_right(), has_left() and is_nonempty() definitions
+ */
+template <>
+bool AssignmentSolver::has_right<StatementAst>(StatementAst *ast) {
+    return !_left_statement_index.get(ast).empty();
+}
+
+template <>
+bool AssignmentSolver::has_right<ProcAst>(ProcAst *proc) {
+    return !_left_proc_index.get(proc).empty();
+}
+
+template <>
+bool AssignmentSolver::has_left<SimpleVariable>(SimpleVariable *variable) {
+    return !_right_condition_index.get(*variable).is_empty();
+}
+
+bool AssignmentSolver::is_nonempty(const ConditionSet& universe) {
+    return _is_nonempty;
+}
+
+/*
+ * solve_right_batch() and solve_left_batch() definitions
+ */
+std::set<ConditionPair> AssignmentSolver::solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+{
+    std::set<ConditionPair> result;
+    VariableDomain variables = make_variable_domain(right_domain);
+
+    for(auto it = lefts.begin(); it != lefts.end(); ++it) {
+        const VariableSet *left_vars = NULL;
+
+        if(StatementCondition *statement = condition_cast<StatementCondition>(*it)) {
+            left_vars = _left_statement_index.find(statement->get_statement_ast());
+
+        } else if(ProcCondition *proc = condition_cast<ProcCondition>(*it)) {
+            left_vars = _left_proc_index.find(proc->get_proc_ast());
+        }
+
+        if(left_vars == NULL) continue;
+
+        for(auto var = left_vars->begin(); var != left_vars->end(); ++var) {
+            insert_right_pair(result, *it, variables, *var);
+        }
+    }
+
+    return result;
+}
+
+std::set<ConditionPair> AssignmentSolver::solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain)
+{
+    std::set<ConditionPair> result;
+
+    for(auto it = rights.begin(); it != rights.end(); ++it) {
+        VariableCondition *variable = condition_cast<VariableCondition>(*it);
+        if(variable == NULL) continue;
+
+        const ConditionSet *found = _right_condition_index.find(*variable->get_variable());
+        if(found == NULL) continue;
+
+        const ConditionSet& lefts = *found;
+        for(auto left = lefts.begin(); left != lefts.end(); ++left) {
+            if(left_domain.has_element(*left)) {
+                result.insert(ConditionPair(*left, *it));
+            }
+        }
+    }
+
+    return result;
 }
 
 /*
@@ -101,12 +183,12 @@ ConditionSet AssignmentSolver::solve_right<ProcAst>(ProcAst *proc) {
  */
 
 void AssignmentSolver::index_statement_variables(StatementAst *statement, const VariableSet& variables) {
-    _left_statement_index[statement] = variables;
+    _left_statement_index.insert(statement, variables);
 
     ConditionPtr statement_condition(new SimpleStatementCondition(statement));
 
     for(auto it = variables.begin(); it != variables.end(); ++it) {
-        _right_condition_index[*it].insert(statement_condition);
+        _right_condition_index.insert(*it).insert(statement_condition);
     }
 }
 
@@ -122,18 +204,218 @@ VariableSet AssignmentSolver::index_statement_list(StatementAst *statement) {
     return result;
 }
 
-template <>
-VariableSet AssignmentSolver::index_variables<ProcAst>(ProcAst *proc) {
-    VariableSet result = index_statement_list(proc->get_statement());
+/*
+ * Compute the variables of every procedure once, bottom up over the
+ * condensed call graph. A procedure has the variables of its own
+ * statements and those of every procedure it calls, which are kept as 
+ * bitsets over dense variable IDs and OR-ed in per component. The 
+ * members of a recursive component share the same variables.
+ */
+void AssignmentSolver::index_procs(const CallGraph& graph) {
+    int proc_count = graph.get_proc_count();
+
+    std::vector<VariableSet> proc_variables(proc_count);
+    std::vector<SimpleVariable> variables;
+    HashIndex<SimpleVariable, int> variable_index;
+
+    for(int proc = 0; proc < proc_count; ++proc) {
+        collect_proc_variables(graph.get_proc(proc)->get_statement(), 
+            proc_variables[proc]);
 
-    _left_proc_index[proc] = result;
+        for(auto it = proc_variables[proc].begin(); 
+            it != proc_variables[proc].end(); ++it) 
+        {
+            if(variable_index.contains(*it)) continue;
 
-    ConditionPtr proc_condition(new SimpleProcCondition(proc));
-    for(auto it = result.begin(); it != result.end(); ++it) {
-        _right_condition_index[*it].insert(new SimpleProcCondition(proc));
+            variable_index.insert(*it, variables.size());
+            variables.push_back(*it);
+        }
     }
 
-    return result;
+    int component_count = graph.get_component_count();
+    std::vector<BitSet> rows(component_count, BitSet(variables.size()));
+
+    for(int component = 0; component < component_count; ++component) {
+        BitSet& row = rows[component];
+        const std::vector<int>& members = graph.get_members(component);
+
+        for(auto proc = members.begin(); proc != members.end(); ++proc) {
+            for(auto it = proc_variables[*proc].begin(); 
+                it != proc_variables[*proc].end(); ++it) 
+            {
+                row.set(variable_index.get(*it));
+            }
+
+            for(int edge = graph.get_callee_begin(*proc); 
+                edge < graph.get_callee_end(*proc); ++edge)
+            {
+                int callee_component = graph.get_component(graph.get_callee(edge));
+                if(callee_component != component) {
+                    row.union_with(rows[callee_component]);
+                }
+            }
+        }
+
+        VariableSet result;
+        for(size_t id = row.next(0); id < row.size(); id = row.next(id + 1)) {
+            result.insert(result.end(), variables[id]);
+        }
+
+        for(auto proc = members.begin(); proc != members.end(); ++proc) {
+            ProcAst *proc_ast = graph.get_proc(*proc);
+            _left_proc_index.insert(proc_ast, result);
+
+            ConditionPtr proc_condition(new SimpleProcCondition(proc_ast));
+            for(auto it = result.begin(); it != result.end(); ++it) {
+                _right_condition_index.insert(*it).insert(proc_condition);
+            }
+        }
+    }
+}
+
+/*
+ * Patch the index for the procedures whose bodies were replaced. The
+ * entries of the replaced statements are dropped while they still have
+ * their old lines, then every other entry is moved to its new line. The
+ * changed procedures and their callers lose their entries and get them
+ * computed again from their own statements and their callees, where a 
+ * callee that is not affected keeps the variables it has.
+ */
+void AssignmentSolver::update_procs(const std::set<ProcAst*>& changed_procs,
+    const std::vector<StatementAst*>& old_bodies, CallSolver *calls)
+{
+    std::set<StatementAst*> removed;
+    for(auto it = old_bodies.begin(); it != old_bodies.end(); ++it) {
+        unindex_statement_list(*it, &removed);
+    }
+
+    _left_statement_index.renumber(removed);
+
+    std::set<ProcAst*> procs;
+    std::vector<ProcAst*> pending(changed_procs.begin(), changed_procs.end());
+
+    while(!pending.empty()) {
+        ProcAst *proc = pending.back();
+        pending.pop_back();
+
+        if(!procs.insert(proc).second) continue;
+
+        ProcSet callers = calls->solve_calling_procs(proc);
+        pending.insert(pending.end(), callers.begin(), callers.end());
+    }
+
+    std::map<ProcAst*, VariableSet> proc_variables;
+
+    for(auto proc = procs.begin(); proc != procs.end(); ++proc) {
+        unindex_statement_list((*proc)->get_statement(), NULL);
+        unindex_condition(_left_proc_index.get(*proc), 
+            ConditionPtr(new SimpleProcCondition(*proc)));
+
+        collect_proc_variables((*proc)->get_statement(), proc_variables[*proc]);
+    }
+
+    /*
+     * Add the variables of the callees until none is added, which also
+     * settles recursive calls.
+     */
+    bool changed = true;
+    while(changed) {
+        changed = false;
+
+        for(auto it = proc_variables.begin(); it != proc_variables.end(); ++it) {
+            ProcSet callees = calls->solve_called_procs(it->first);
+
+            for(auto callee = callees.begin(); callee != callees.end(); ++callee) {
+                if(*callee == it->first) continue;
+
+                size_t size = it->second.size();
+                union_set(it->second, procs.count(*callee) > 0 ? 
+                    proc_variables[*callee] : _left_proc_index.get(*callee));
+
+                changed = changed || it->second.size() != size;
+            }
+        }
+    }
+
+    for(auto it = proc_variables.begin(); it != proc_variables.end(); ++it) {
+        _left_proc_index.insert(it->first, it->second);
+
+        ConditionPtr proc_condition(new SimpleProcCondition(it->first));
+        for(auto var = it->second.begin(); var != it->second.end(); ++var) {
+            _right_condition_index.insert(*var).insert(proc_condition);
+        }
+    }
+
+    for(auto proc = procs.begin(); proc != procs.end(); ++proc) {
+        index_statement_list((*proc)->get_statement());
+    }
+
+    _is_nonempty = false;
+    for(auto it = _right_condition_index.begin(); 
+        it != _right_condition_index.end(); ++it) 
+    {
+        if(!it->second.is_empty()) _is_nonempty = true;
+    }
+}
+
+/*
+ * Remove the statements of a list, and the statements nested in them,
+ * from the index of each variable they have, and collect them into
+ * removed if it is given.
+ */
+void AssignmentSolver::unindex_statement_list(
+        StatementAst *statement, std::set<StatementAst*> *removed) 
+{
+    while(statement != NULL) {
+        if(removed != NULL) removed->insert(statement);
+
+        unindex_condition(_left_statement_index.get(statement), 
+            ConditionPtr(new SimpleStatementCondition(statement)));
+
+        if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            unindex_statement_list(loop->get_body(), removed);
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            unindex_statement_list(condition->get_then_branch(), removed);
+            unindex_statement_list(condition->get_else_branch(), removed);
+        }
+
+        statement = statement->next();
+    }
+}
+
+void AssignmentSolver::unindex_condition(
+        const VariableSet& variables, const ConditionPtr& condition) 
+{
+    for(auto it = variables.begin(); it != variables.end(); ++it) {
+        ConditionSet *conditions = _right_condition_index.find(*it);
+        if(conditions != NULL) conditions->remove(condition);
+    }
+}
+
+/*
+ * Collect the variables of the statements in a list, without looking
+ * into the procedures they call.
+ */
+void AssignmentSolver::collect_proc_variables(
+        StatementAst *statement, VariableSet& result) 
+{
+    while(statement != NULL) {
+        if(AssignmentAst *assign = statement_cast<AssignmentAst>(statement)) {
+            union_set(result, _variable_extractor->extract_assignment(assign));
+
+        } else if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            union_set(result, _variable_extractor->extract_while(loop));
+            collect_proc_variables(loop->get_body(), result);
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            union_set(result, _variable_extractor->extract_if(condition));
+            collect_proc_variables(condition->get_then_branch(), result);
+            collect_proc_variables(condition->get_else_branch(), result);
+        }
+
+        statement = statement->next();
+    }
 }
 
 template <>
@@ -169,7 +451,7 @@ VariableSet AssignmentSolver::index_variables<IfAst>(IfAst *ast) {
 
 template <>
 VariableSet AssignmentSolver::index_variables<CallAst>(CallAst *ast) {
-    VariableSet result = index_variables<ProcAst>(ast->get_proc_called());
+    VariableSet result = _left_proc_index.get(ast->get_proc_called());
 
     index_statement_variables(ast, result);
 
@@ -20,12 +20,17 @@
 
 #include <map>
 #include <set>
+#include <vector>
 #include <memory>
 #include "simple/ast.h"
 #include "simple/condition.h"
 #include "simple/condition_set.h"
 #include "simple/solver.h"
 #include "simple/util/statement_visitor_generator.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/relation_index.h"
+#include "impl/solvers/call_graph.h"
+#include "impl/solvers/call.h"
 
 namespace simple {
 namespace impl {
@@ -58,19 +63,52 @@ class AssignmentSolver {
     template <typename Condition>
     ConditionSet solve_left(Condition *condition);
 
+    template <typename Condition>
+    bool has_right(Condition *condition);
+
+    template <typename Condition>
+    bool has_left(Condition *condition);
+
+    bool is_nonempty(const ConditionSet& universe);
+
+    std::set<ConditionPair> solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain);
+
+    std::set<ConditionPair> solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain);
+
     template <typename Condition>
     VariableSet index_variables(Condition *condition);
 
+    /*
+     * Update the index after the bodies of changed_procs were replaced
+     * by new statements and every statement was renumbered. old_bodies
+     * are the replaced bodies, and calls must already hold the calls of
+     * the new bodies. Only the changed procedures and the procedures
+     * that call them, directly or not, are indexed again. The entries of
+     * every other statement are kept and moved to its new line.
+     */
+    void update_procs(const std::set<ProcAst*>& changed_procs,
+        const std::vector<StatementAst*>& old_bodies, CallSolver *calls);
+
     ~AssignmentSolver() { }
 
   private:
     SimpleRoot _ast;
     std::shared_ptr<VariableExtractor> _variable_extractor;
+    bool _is_nonempty;
+
+    HashIndex<SimpleVariable, ConditionSet> _right_condition_index;
 
-    std::map<SimpleVariable, ConditionSet> _right_condition_index;
+    StatementIndex<VariableSet> _left_statement_index;
+    HashIndex<ProcAst*, VariableSet> _left_proc_index;
 
-    std::map<StatementAst*, VariableSet> _left_statement_index;
-    std::map<ProcAst*, VariableSet> _left_proc_index;
+    void index_procs(const CallGraph& graph);
+    void collect_proc_variables(StatementAst *statement, VariableSet& result);
+
+    void unindex_statement_list(StatementAst *statement, 
+        std::set<StatementAst*> *removed);
+    void unindex_condition(const VariableSet& variables, const ConditionPtr& condition);
 
     VariableSet index_statement_list(StatementAst *statement);
     void index_statement_variables(StatementAst *statement, const VariableSet& variables);
@@ -95,9 +133,19 @@ ConditionSet AssignmentSolver::solve_left(Condition *condition) {
     return ConditionSet(); // empty set
 }
 
+template <typename Condition>
+bool AssignmentSolver::has_right(Condition *condition) {
+    return false;
+}
+
+template <typename Condition>
+bool AssignmentSolver::has_left(Condition *condition) {
+    return false;
+}
+
 template <typename Condition>
 VariableSet AssignmentSolver::index_variables(Condition *condition) {
-    return ConditionSet();
+    return VariableSet();
 }
 
 template <>
@@ -118,7 +166,13 @@ template <>
 ConditionSet AssignmentSolver::solve_left<SimpleVariable>(SimpleVariable *variable);
 
 template <>
-VariableSet AssignmentSolver::index_variables<ProcAst>(ProcAst *proc);
+bool AssignmentSolver::has_right<StatementAst>(StatementAst *ast);
+
+template <>
+bool AssignmentSolver::has_right<ProcAst>(ProcAst *ast);
+
+template <>
+bool AssignmentSolver::has_left<SimpleVariable>(SimpleVariable *variable);
 
 template <>
 VariableSet AssignmentSolver::index_variables<AssignmentAst>(AssignmentAst *assign);
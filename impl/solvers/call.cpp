@@ -38,6 +38,48 @@ CallSolver::CallSolver(SimpleRoot ast) :
     }
 }
 
+bool CallSolver::is_nonempty(const ConditionSet& universe) {
+    for(ProcIndex::const_iterator it = _called_table.begin(); 
+        it != _called_table.end(); ++it) 
+    {
+        if(!it->second.empty()) return true;
+    }
+
+    return false;
+}
+
+void CallSolver::update_procs(const std::set<ProcAst*>& procs) {
+    for(std::set<ProcAst*>::const_iterator proc = procs.begin(); 
+        proc != procs.end(); ++proc)
+    {
+        ProcSet *callees = _called_table.find(*proc);
+        if(callees == NULL) continue;
+
+        for(ProcSet::iterator callee = callees->begin(); 
+            callee != callees->end(); ++callee)
+        {
+            _calling_table.insert(*callee).erase(*proc);
+
+            CallSet& calls = _calling_statements.insert(*callee);
+            for(CallSet::iterator call = calls.begin(); call != calls.end(); ) {
+                if((*call)->get_proc() == *proc) {
+                    calls.erase(call++);
+                } else {
+                    ++call;
+                }
+            }
+        }
+
+        callees->clear();
+    }
+
+    for(std::set<ProcAst*>::const_iterator proc = procs.begin(); 
+        proc != procs.end(); ++proc)
+    {
+        index_calls<ProcAst>(*proc);
+    }
+}
+
 template <>
 ConditionSet CallSolver::solve_right<ProcAst>(ProcAst *proc) {
     ProcSet result = solve_called_procs(proc);
@@ -57,15 +99,15 @@ bool CallSolver::validate<ProcAst, ProcAst>(ProcAst *proc1, ProcAst *proc2)
 }
 
 ProcSet CallSolver::solve_called_procs(ProcAst *calling_proc) {
-    return _called_table[calling_proc];
+    return _called_table.get(calling_proc);
 }
 
 ProcSet CallSolver::solve_calling_procs(ProcAst *called_proc) {
-    return _calling_table[called_proc];
+    return _calling_table.get(called_proc);
 }
 
 CallSet CallSolver::solve_calling_statements(ProcAst *called_proc) {
-    return _calling_statements[called_proc];
+    return _calling_statements.get(called_proc);
 }
 
 class IndexCallsVisitorTraits {
@@ -105,9 +147,9 @@ void CallSolver::index_calls<CallAst>(CallAst *call) {
     ProcAst *caller = call->get_proc();
     ProcAst *callee = call->get_proc_called();
 
-    _called_table[caller].insert(callee);
-    _calling_table[callee].insert(caller);
-    _calling_statements[callee].insert(call);
+    _called_table.insert(caller).insert(callee);
+    _calling_table.insert(callee).insert(caller);
+    _calling_statements.insert(callee).insert(call);
 }
 
 template <>
@@ -23,6 +23,8 @@
 #include "simple/ast.h"
 #include "simple/condition.h"
 #include "simple/solver.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/relation_index.h"
 
 namespace simple {
 namespace impl {
@@ -56,17 +58,25 @@ class CallSolver : public CallsQuerySolver {
         return false;
     }
 
+    bool is_nonempty(const ConditionSet& universe);
+
+    /*
+     * Index the calls of the procedures again after their bodies were
+     * replaced. The calls made by every other procedure are kept.
+     */
+    void update_procs(const std::set<ProcAst*>& procs);
+
     template <typename Condition>
     void index_calls(Condition *condition) {
         // no-op
     }
 
   private:
-    typedef std::map<ProcAst*, ProcSet > ProcIndex;
+    typedef HashIndex<ProcAst*, ProcSet > ProcIndex;
     SimpleRoot _ast;
     ProcIndex _called_table;
     ProcIndex _calling_table;
-    std::map<ProcAst*, CallSet > _calling_statements;
+    HashIndex<ProcAst*, CallSet > _calling_statements;
 };
 
 template <>
@@ -97,5 +107,10 @@ void CallSolver::index_calls<IfAst>(IfAst *condition);
 
 
 
+template <>
+class SolverExistenceTraits<CallSolver> : 
+    public DirectSolverNonemptyTraits<CallSolver> 
+{ };
+
 } // namespace impl
 } // namespace simple
@@ -0,0 +1,193 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include "impl/solvers/call_graph.h"
+#include "simple/util/ast_utils.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+CallGraph::CallGraph(SimpleRoot ast) {
+    for(SimpleRoot::iterator it = ast.begin(); it != ast.end(); ++it) {
+        _proc_index.insert(*it, _procs.size());
+        _procs.push_back(*it);
+    }
+
+    _callee_offsets.push_back(0);
+
+    for(size_t proc = 0; proc < _procs.size(); ++proc) {
+        std::vector<int> callees;
+        index_calls(_procs[proc]->get_statement(), callees);
+
+        std::sort(callees.begin(), callees.end());
+        callees.erase(std::unique(callees.begin(), callees.end()), callees.end());
+
+        _callees.insert(_callees.end(), callees.begin(), callees.end());
+        _callee_offsets.push_back(_callees.size());
+    }
+
+    build_components();
+}
+
+int CallGraph::get_proc_count() const {
+    return _procs.size();
+}
+
+ProcAst* CallGraph::get_proc(int proc) const {
+    return _procs[proc];
+}
+
+int CallGraph::get_proc_id(ProcAst *proc) const {
+    const int *id = _proc_index.find(proc);
+    if(id == NULL) return -1;
+
+    return *id;
+}
+
+int CallGraph::get_callee_begin(int proc) const {
+    return _callee_offsets[proc];
+}
+
+int CallGraph::get_callee_end(int proc) const {
+    return _callee_offsets[proc + 1];
+}
+
+int CallGraph::get_callee(int edge) const {
+    return _callees[edge];
+}
+
+int CallGraph::get_component_count() const {
+    return _members.size();
+}
+
+int CallGraph::get_component(int proc) const {
+    return _components[proc];
+}
+
+const std::vector<int>& CallGraph::get_members(int component) const {
+    return _members[component];
+}
+
+bool CallGraph::is_cyclic(int component) const {
+    return _cyclic[component];
+}
+
+void CallGraph::index_calls(StatementAst *statement, std::vector<int>& callees) {
+    while(statement != NULL) {
+        if(CallAst *call = statement_cast<CallAst>(statement)) {
+            int callee = get_proc_id(call->get_proc_called());
+            if(callee != -1) callees.push_back(callee);
+
+        } else if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            index_calls(loop->get_body(), callees);
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            index_calls(condition->get_then_branch(), callees);
+            index_calls(condition->get_else_branch(), callees);
+        }
+
+        statement = statement->next();
+    }
+}
+
+/*
+ * Tarjan's algorithm with an explicit stack of (procedure, next call)
+ * frames, so that deep call chains do not overflow the native stack.
+ * Components are numbered in the order they are completed.
+ */
+void CallGraph::build_components() {
+    int proc_count = _procs.size();
+
+    std::vector<int> index(proc_count, -1);
+    std::vector<int> lowlink(proc_count, 0);
+    std::vector<bool> on_stack(proc_count, false);
+    std::vector<int> stack;
+    std::vector< std::pair<int, int> > frames;
+    int next_index = 0;
+
+    _components.assign(proc_count, -1);
+
+    for(int root = 0; root < proc_count; ++root) {
+        if(index[root] != -1) continue;
+
+        index[root] = lowlink[root] = next_index++;
+        stack.push_back(root);
+        on_stack[root] = true;
+        frames.push_back(std::make_pair(root, _callee_offsets[root]));
+
+        while(!frames.empty()) {
+            int proc = frames.back().first;
+            int edge = frames.back().second;
+
+            if(edge < _callee_offsets[proc + 1]) {
+                int callee = _callees[edge];
+                ++frames.back().second;
+
+                if(index[callee] == -1) {
+                    index[callee] = lowlink[callee] = next_index++;
+                    stack.push_back(callee);
+                    on_stack[callee] = true;
+                    frames.push_back(std::make_pair(callee, _callee_offsets[callee]));
+
+                } else if(on_stack[callee]) {
+                    lowlink[proc] = std::min(lowlink[proc], index[callee]);
+                }
+
+                continue;
+            }
+
+            frames.pop_back();
+
+            if(!frames.empty()) {
+                int caller = frames.back().first;
+                lowlink[caller] = std::min(lowlink[caller], lowlink[proc]);
+            }
+
+            if(lowlink[proc] != index[proc]) continue;
+
+            int component = _members.size();
+            _members.push_back(std::vector<int>());
+            _cyclic.push_back(false);
+
+            int member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                on_stack[member] = false;
+
+                _components[member] = component;
+                _members[component].push_back(member);
+            } while(member != proc);
+        }
+    }
+
+    for(int proc = 0; proc < proc_count; ++proc) {
+        for(int edge = _callee_offsets[proc]; edge < _callee_offsets[proc + 1]; ++edge) {
+            if(_components[_callees[edge]] == _components[proc]) {
+                _cyclic[_components[proc]] = true;
+            }
+        }
+    }
+}
+
+} // namespace impl
+} // namespace simple
@@ -0,0 +1,88 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include "simple/ast.h"
+#include "simple/util/relation_index.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * CallGraph is the call graph of a program with dense procedure IDs in
+ * program order. The procedures called directly by each procedure are
+ * stored as sorted adjacency lists in compressed form.
+ *
+ * The graph is condensed into its strongly connected components, which
+ * are numbered in reverse topological order: every component comes
+ * after all the components it calls. Solvers that summarize procedures
+ * bottom up can then process the components in increasing order.
+ */
+class CallGraph {
+  public:
+    CallGraph(SimpleRoot ast);
+
+    int get_proc_count() const;
+    ProcAst* get_proc(int proc) const;
+
+    /*
+     * Get the ID of a procedure, or -1 if it is not in the program.
+     */
+    int get_proc_id(ProcAst *proc) const;
+
+    /*
+     * The procedures called directly by proc are get_callee(edge) for
+     * edge from get_callee_begin(proc) to get_callee_end(proc).
+     */
+    int get_callee_begin(int proc) const;
+    int get_callee_end(int proc) const;
+    int get_callee(int edge) const;
+
+    int get_component_count() const;
+    int get_component(int proc) const;
+    const std::vector<int>& get_members(int component) const;
+
+    /*
+     * A component is cyclic if one of its members calls another member,
+     * or itself.
+     */
+    bool is_cyclic(int component) const;
+
+  private:
+    void index_calls(StatementAst *statement, std::vector<int>& callees);
+    void build_components();
+
+    std::vector<ProcAst*>       _procs;
+    HashIndex<ProcAst*, int>    _proc_index;
+
+    std::vector<int>    _callee_offsets;
+    std::vector<int>    _callees;
+
+    std::vector<int>                    _components;
+    std::vector< std::vector<int> >     _members;
+    std::vector<bool>                   _cyclic;
+};
+
+} // namespace impl
+} // namespace simple
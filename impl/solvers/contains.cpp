@@ -28,24 +28,24 @@ bool ContainsSolver::validate(SimpleCondition *left_condition, SimpleCondition *
     ConditionPtr left(clone_condition(right_condition));
     ConditionPtr right(clone_condition(left_condition));
 
-	return _left_index[left].has_element(right);
+	return _left_index.get(left).has_element(right);
 }
 
 ConditionSet ContainsSolver::solve_left(SimpleCondition *right_condition) {
     ConditionPtr right(clone_condition(right_condition));
 
-	return _right_index[right];
+	return _right_index.get(right);
 }
 
 ConditionSet ContainsSolver::solve_right(SimpleCondition *left_condition) {
     ConditionPtr left(clone_condition(left_condition));
 
-    return _left_index[left];
+    return _left_index.get(left);
 }
 
 void ContainsSolver::index_contains(ConditionPtr parent, ConditionPtr contained) {
-    _left_index[parent].insert(contained);
-    _right_index[contained].insert(parent);
+    _left_index.insert(parent).insert(contained);
+    _right_index.insert(contained).insert(parent);
 }
 
 ConditionSet ContainsSolver::index_contains_set(
@@ -9,11 +9,13 @@
 #include "simple/condition.h"
 #include "simple/condition_set.h"
 #include "impl/condition.h"
+#include "simple/util/relation_index.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 class ContainsSolver : public QuerySolver {
   public:
@@ -29,8 +31,8 @@ class ContainsSolver : public QuerySolver {
   	SimpleRoot _ast;
     bool _indirect;
 
-    std::map< ConditionPtr, ConditionSet > _left_index;
-    std::map< ConditionPtr, ConditionSet > _right_index;
+    HashIndex<ConditionPtr, ConditionSet> _left_index;
+    HashIndex<ConditionPtr, ConditionSet> _right_index;
 
     void index_contains(ConditionPtr left, ConditionPtr right);
     ConditionSet index_contains_set(ConditionPtr left, ConditionSet right);
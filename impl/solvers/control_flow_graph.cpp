@@ -0,0 +1,238 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include "impl/solvers/control_flow_graph.h"
+#include "simple/util/ast_utils.h"
+#include "simple/util/expr_util.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+namespace {
+
+bool is_earlier_proc(ProcAst *proc1, ProcAst *proc2) {
+    return proc1->get_statement()->get_statement_line() < 
+        proc2->get_statement()->get_statement_line();
+}
+
+} // namespace
+
+/*
+ * The procedures are indexed in the order of their statement lines, 
+ * which the root does not keep.
+ */
+ControlFlowGraph::ControlFlowGraph(SimpleRoot ast) : _ast(ast) {
+    std::vector<ProcAst*> procs;
+    for(auto it = _ast.begin(); it != _ast.end(); ++it) {
+        procs.push_back(*it);
+    }
+    std::stable_sort(procs.begin(), procs.end(), is_earlier_proc);
+
+    for(auto it = procs.begin(); it != procs.end(); ++it) {
+        index_statement_list((*it)->get_statement());
+    }
+
+    EdgeList edges;
+    for(auto it = procs.begin(); it != procs.end(); ++it) {
+        add_statement_list_edges((*it)->get_statement(), NULL, edges);
+    }
+
+    build_rows(edges, _next_offsets, _next_targets);
+
+    for(auto it = edges.begin(); it != edges.end(); ++it) {
+        std::swap(it->first, it->second);
+    }
+
+    build_rows(edges, _prev_offsets, _prev_targets);
+
+    build_blocks();
+}
+
+void ControlFlowGraph::index_statement_list(StatementAst *statement) {
+    while(statement != NULL) {
+        _ids.insert(statement, _statements.size());
+        _statements.push_back(statement);
+
+        if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            index_statement_list(loop->get_body());
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            index_statement_list(condition->get_then_branch());
+            index_statement_list(condition->get_else_branch());
+        }
+
+        statement = statement->next();
+    }
+}
+
+/*
+ * A while statement goes to its body and to its follower, and the end
+ * of its body goes back to it. An if statement goes to both branches,
+ * and the ends of both branches go to its follower.
+ */
+void ControlFlowGraph::add_statement_list_edges(
+    StatementAst *statement, StatementAst *follower, EdgeList& edges)
+{
+    while(statement != NULL) {
+        int id = get_id(statement);
+        StatementAst *next = statement->next() != NULL ? 
+            statement->next() : follower;
+
+        if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            edges.push_back(std::make_pair(id, get_id(loop->get_body())));
+            add_statement_list_edges(loop->get_body(), loop, edges);
+
+            if(next != NULL) edges.push_back(std::make_pair(id, get_id(next)));
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            edges.push_back(std::make_pair(id, 
+                get_id(condition->get_then_branch())));
+            edges.push_back(std::make_pair(id, 
+                get_id(condition->get_else_branch())));
+
+            add_statement_list_edges(condition->get_then_branch(), next, edges);
+            add_statement_list_edges(condition->get_else_branch(), next, edges);
+
+        } else if(next != NULL) {
+            edges.push_back(std::make_pair(id, get_id(next)));
+        }
+
+        statement = statement->next();
+    }
+}
+
+/*
+ * Sort the edges by their source and lay the targets out in that order.
+ */
+void ControlFlowGraph::build_rows(EdgeList& edges,
+    std::vector<int>& offsets, std::vector<int>& targets)
+{
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    offsets.assign(_statements.size() + 1, 0);
+    targets.clear();
+    targets.reserve(edges.size());
+
+    for(auto it = edges.begin(); it != edges.end(); ++it) {
+        ++offsets[it->first + 1];
+        targets.push_back(it->second);
+    }
+
+    for(size_t id = 0; id < _statements.size(); ++id) {
+        offsets[id + 1] += offsets[id];
+    }
+}
+
+/*
+ * A statement continues the block of the statement before it when that
+ * statement goes only to it, and it is reached only from that statement.
+ */
+void ControlFlowGraph::build_blocks() {
+    _blocks.resize(_statements.size());
+    _block_offsets.clear();
+
+    for(size_t id = 0; id < _statements.size(); ++id) {
+        Slice prev = get_prev(id);
+
+        bool continues = id > 0 && prev.size() == 1 && 
+            *prev.begin == (int) id - 1 && get_next(id - 1).size() == 1;
+
+        if(!continues) {
+            _block_offsets.push_back(id);
+            _block_summaries.push_back(BlockSummary());
+        }
+
+        _blocks[id] = _block_offsets.size() - 1;
+        BlockSummary& summary = _block_summaries.back();
+
+        if(AssignmentAst *assign = statement_cast<AssignmentAst>(
+                _statements[id])) 
+        {
+            summary.modified.insert(*assign->get_variable());
+
+            VariableSet used = get_expr_vars(assign->get_expr());
+            summary.used.insert(used.begin(), used.end());
+
+        } else if(CallAst *call = statement_cast<CallAst>(_statements[id])) {
+            summary.calls.push_back(call);
+        }
+    }
+
+    _block_offsets.push_back(_statements.size());
+}
+
+size_t ControlFlowGraph::size() const {
+    return _statements.size();
+}
+
+int ControlFlowGraph::get_id(StatementAst *statement) const {
+    const int *id = _ids.find(statement);
+    return id != NULL ? *id : -1;
+}
+
+StatementAst* ControlFlowGraph::get_statement(int id) const {
+    return _statements[id];
+}
+
+ControlFlowGraph::Slice ControlFlowGraph::get_next(int id) const {
+    const int *targets = _next_targets.data();
+    return Slice(targets + _next_offsets[id], targets + _next_offsets[id + 1]);
+}
+
+ControlFlowGraph::Slice ControlFlowGraph::get_prev(int id) const {
+    const int *targets = _prev_targets.data();
+    return Slice(targets + _prev_offsets[id], targets + _prev_offsets[id + 1]);
+}
+
+bool ControlFlowGraph::is_next(int from, int to) const {
+    Slice next = get_next(from);
+    return std::binary_search(next.begin, next.end, to);
+}
+
+bool ControlFlowGraph::has_edges() const {
+    return !_next_targets.empty();
+}
+
+size_t ControlFlowGraph::get_block_count() const {
+    return _block_offsets.size() - 1;
+}
+
+int ControlFlowGraph::get_block(int id) const {
+    return _blocks[id];
+}
+
+int ControlFlowGraph::get_block_begin(int block) const {
+    return _block_offsets[block];
+}
+
+int ControlFlowGraph::get_block_end(int block) const {
+    return _block_offsets[block + 1];
+}
+
+const ControlFlowGraph::BlockSummary& 
+ControlFlowGraph::get_block_summary(int block) const {
+    return _block_summaries[block];
+}
+
+} // namespace impl
+} // namespace simple
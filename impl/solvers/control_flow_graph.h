@@ -0,0 +1,142 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "simple/ast.h"
+#include "simple/condition_set.h"
+#include "simple/util/relation_index.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * ControlFlowGraph is the intraprocedural control flow graph of a
+ * program, built once from the AST.
+ *
+ * Statements get dense IDs in program order, so the ID of a statement
+ * in a parsed program is its statement line less one. The next and
+ * previous statements of all statements are stored as compressed sparse
+ * rows, so the neighbours of a statement are a slice of a single array.
+ *
+ * The statements are also partitioned into basic blocks. A basic block
+ * is a run of statements with consecutive IDs, where control can only
+ * enter at the first statement and leave at the last one. Every next
+ * statement of the last statement of a block starts a block.
+ */
+class ControlFlowGraph {
+  public:
+    ControlFlowGraph(SimpleRoot ast);
+
+    /*
+     * A slice of statement IDs in increasing order.
+     */
+    struct Slice {
+        Slice(const int *begin, const int *end) : 
+            begin(begin), end(end) 
+        { }
+
+        bool empty() const { return begin == end; }
+        size_t size() const { return end - begin; }
+
+        const int *begin;
+        const int *end;
+    };
+
+    size_t size() const;
+
+    /*
+     * Get the ID of a statement, or -1 if it is not in the program.
+     */
+    int get_id(StatementAst *statement) const;
+    StatementAst* get_statement(int id) const;
+
+    Slice get_next(int id) const;
+    Slice get_prev(int id) const;
+
+    bool is_next(int from, int to) const;
+    bool has_edges() const;
+
+    size_t get_block_count() const;
+    int get_block(int id) const;
+
+    /*
+     * The first and one past the last statement ID of a block.
+     */
+    int get_block_begin(int block) const;
+    int get_block_end(int block) const;
+
+    /*
+     * The variables modified and used by the assignments in a block, 
+     * and the calls in it.
+     */
+    struct BlockSummary {
+        VariableSet             modified;
+        VariableSet             used;
+        std::vector<CallAst*>   calls;
+    };
+
+    const BlockSummary& get_block_summary(int block) const;
+
+  private:
+    typedef std::vector< std::pair<int, int> > EdgeList;
+
+    void index_statement_list(StatementAst *statement);
+
+    /*
+     * Add the edges of a statement list, where the last statements go
+     * to the follower, or nowhere if it is NULL.
+     */
+    void add_statement_list_edges(StatementAst *statement, 
+        StatementAst *follower, EdgeList& edges);
+
+    void build_rows(EdgeList& edges,
+        std::vector<int>& offsets, std::vector<int>& targets);
+
+    void build_blocks();
+
+    SimpleRoot _ast;
+
+    std::vector<StatementAst*>  _statements;
+    StatementIndex<int>         _ids;
+
+    /*
+     * The edges of a statement ID are the targets from its offset up to
+     * the offset of the next ID.
+     */
+    std::vector<int>            _next_offsets;
+    std::vector<int>            _next_targets;
+    std::vector<int>            _prev_offsets;
+    std::vector<int>            _prev_targets;
+
+    /*
+     * The block of each statement ID, and the first statement ID of each
+     * block followed by the statement count.
+     */
+    std::vector<int>            _blocks;
+    std::vector<int>            _block_offsets;
+    std::vector<BlockSummary>   _block_summaries;
+};
+
+} // namespace impl
+} // namespace simple
@@ -65,16 +65,18 @@ bool DirectUsesSolver::validate(SimpleCondition *left_condition, SimpleCondition
 bool DirectUsesSolver::validate_statement_var(StatementAst *statement, SimpleVariable *var) {
     switch(get_statement_type(statement)) {
         case WhileST:
-            return (statement_cast<WhileAst>(statement)->get_variable() == var);
+            return (*statement_cast<WhileAst>(statement)->get_variable() == *var);
         case IfST:
-            return (statement_cast<IfAst>(statement)->get_variable() == var);
+            return (*statement_cast<IfAst>(statement)->get_variable() == *var);
+        case AssignST:
+            return (*statement_cast<AssignmentAst>(statement)->get_variable() == *var);
         default:
             return false;
     }
 }
 
 StatementSet DirectUsesSolver::solve_left_statement(SimpleVariable *var) {
-    return _right_statement_index[*var];
+    return _right_statement_index.get(*var);
 }
 
 VariableSet DirectUsesSolver::solve_right_var(StatementAst *statement) {
@@ -127,19 +129,19 @@ void DirectUsesSolver::index_statement(StatementAst *statement) {
 }
 
 void DirectUsesSolver::index_while(WhileAst *while_ast) {
-    _right_statement_index[*while_ast->get_variable()].insert(while_ast);
+    _right_statement_index.insert(*while_ast->get_variable()).insert(while_ast);
     index_statement_list(while_ast->get_body());
 }
 
 void DirectUsesSolver::index_if(IfAst *if_ast) {
-    _right_statement_index[*if_ast->get_variable()].insert(if_ast);
+    _right_statement_index.insert(*if_ast->get_variable()).insert(if_ast);
 
     index_statement_list(if_ast->get_then_branch());
     index_statement_list(if_ast->get_else_branch());
 }
 
 void DirectUsesSolver::index_assign(AssignmentAst *assign) {
-    _right_statement_index[*assign->get_variable()].insert(assign);
+    _right_statement_index.insert(*assign->get_variable()).insert(assign);
 }
 
 }
@@ -23,11 +23,13 @@
 #include "simple/condition.h"
 #include "simple/condition_set.h"
 #include "impl/condition.h"
+#include "simple/util/relation_index.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 class DirectUsesSolver : public QuerySolver  {
   public:
@@ -60,7 +62,7 @@ class DirectUsesSolver : public QuerySolver  {
   
 private:
 	SimpleRoot _ast;
-	std::map<SimpleVariable, StatementSet> _right_statement_index;
+	HashIndex<SimpleVariable, StatementSet> _right_statement_index;
 
 };
 } // namespace impl
@@ -16,6 +16,7 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <vector>
 #include "impl/solvers/equal.h"
 #include "simple/util/ast_utils.h"
 #include "simple/util/expr_util.h"
@@ -32,7 +33,7 @@ EqualSolver::EqualSolver(SimpleRoot ast) : _ast(ast)
 }
 
 void EqualSolver::index_proc(ProcAst *proc) {
-    _name_index[proc->get_name()].insert(new SimpleProcCondition(proc));
+    _name_index.insert(proc->get_name()).insert(new SimpleProcCondition(proc));
 
     index_statement_list(proc->get_statement());
 }
@@ -45,7 +46,7 @@ void EqualSolver::index_statement_list(StatementAst *statement) {
 }
 
 void EqualSolver::index_statement(StatementAst *statement) {
-    _number_index[statement->get_statement_line()].insert(
+    _number_index.insert(statement->get_statement_line()).insert(
         new SimpleStatementCondition(statement));
 
     StatementType type = get_statement_type(statement);
@@ -80,12 +81,12 @@ void EqualSolver::index_while(WhileAst *ast) {
 }
 
 void EqualSolver::index_call(CallAst *call) {
-    _name_index[call->get_proc_called()->get_name()].insert(
+    _name_index.insert(call->get_proc_called()->get_name()).insert(
         new SimpleStatementCondition(call));
 }
 
 void EqualSolver::index_variable(SimpleVariable *var) {
-    _name_index[var->get_name()].insert(new SimpleVariableCondition(*var));
+    _name_index.insert(var->get_name()).insert(new SimpleVariableCondition(*var));
 }
 
 void EqualSolver::index_assign(AssignmentAst *assign) {
@@ -122,33 +123,140 @@ void EqualSolver::index_var_expr(VariableAst *ast) {
 void EqualSolver::index_const_expr(ConstAst *ast) {
     SimpleConstant *constant = ast->get_constant();
 
-    _number_index[constant->get_int()].insert(
+    _number_index.insert(constant->get_int()).insert(
         new SimpleConstantCondition(*constant));
 }
 
 template <>
 ConditionSet EqualSolver::solve_equal<ProcAst>(ProcAst *proc)
 {
-    return _name_index[proc->get_name()];
+    return _name_index.get(proc->get_name());
 }
 
 template <>
 ConditionSet EqualSolver::solve_equal<SimpleVariable>(SimpleVariable *var)
 {
-    return _name_index[var->get_name()];
+    return _name_index.get(var->get_name());
 }
 
 template <>
 ConditionSet EqualSolver::solve_equal<StatementAst>(StatementAst *statement)
 {
-    return _number_index[statement->get_statement_line()];
+    return _number_index.get(statement->get_statement_line());
 }
 
 template <>
 ConditionSet EqualSolver::solve_equal<SimpleConstant>(SimpleConstant *constant)
 {
-    return _number_index[constant->get_int()];
+    return _number_index.get(constant->get_int());
 }
 
+/*
+ * The join table of a with clause groups the conditions of one domain
+ * by the names and numbers they are indexed under, which for a call 
+ * statement is both its line and the name of the called procedure. A
+ * condition probes the table with the one name or number solve_equal()
+ * looks it up with, so the join finds the same pairs as solving every
+ * condition on its own.
+ */
+class EqualJoinTable {
+  public:
+    typedef std::vector<ConditionPtr> Bucket;
+
+    EqualJoinTable(const ConditionSet& domain) {
+        for(auto it = domain.begin(); it != domain.end(); ++it) {
+            SimpleCondition *condition = it->get();
+
+            switch(get_condition_type(condition)) {
+                case ProcCT:
+                    _names.insert(condition_cast<ProcCondition>(condition)->
+                        get_proc_ast()->get_name()).push_back(*it);
+                break;
+                case VariableCT:
+                    _names.insert(condition_cast<VariableCondition>(condition)->
+                        get_variable()->get_name()).push_back(*it);
+                break;
+                case StatementCT:
+                    add_statement(*it, condition_cast<StatementCondition>(
+                        condition)->get_statement_ast());
+                break;
+                case ConstantCT:
+                    _numbers.insert(condition_cast<ConstantCondition>(condition)->
+                        get_constant()->get_int()).push_back(*it);
+                break;
+                default:
+                break;
+            }
+        }
+    }
+
+    const Bucket& probe(SimpleCondition *condition) const {
+        switch(get_condition_type(condition)) {
+            case ProcCT:
+                return _names.get(condition_cast<ProcCondition>(condition)->
+                    get_proc_ast()->get_name());
+            case VariableCT:
+                return _names.get(condition_cast<VariableCondition>(condition)->
+                    get_variable()->get_name());
+            case StatementCT:
+                return _numbers.get(condition_cast<StatementCondition>(condition)->
+                    get_statement_ast()->get_statement_line());
+            case ConstantCT:
+                return _numbers.get(condition_cast<ConstantCondition>(condition)->
+                    get_constant()->get_int());
+            default:
+                return _empty_bucket;
+        }
+    }
+
+  private:
+    void add_statement(const ConditionPtr& condition, StatementAst *statement) {
+        _numbers.insert(statement->get_statement_line()).push_back(condition);
+
+        CallAst *call = statement_cast<CallAst>(statement);
+        if(call != NULL) {
+            _names.insert(call->get_proc_called()->get_name()).push_back(condition);
+        }
+    }
+
+    HashIndex<std::string, Bucket>  _names;
+    HashIndex<int, Bucket>          _numbers;
+    Bucket                          _empty_bucket;
+};
+
+std::set<ConditionPair> EqualSolver::solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+{
+    std::set<ConditionPair> result;
+    EqualJoinTable table(right_domain);
+
+    for(auto it = lefts.begin(); it != lefts.end(); ++it) {
+        const EqualJoinTable::Bucket& rights = table.probe(it->get());
+
+        for(auto right = rights.begin(); right != rights.end(); ++right) {
+            result.insert(ConditionPair(*it, *right));
+        }
+    }
+
+    return result;
+}
+
+std::set<ConditionPair> EqualSolver::solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain)
+{
+    std::set<ConditionPair> result;
+    EqualJoinTable table(left_domain);
+
+    for(auto it = rights.begin(); it != rights.end(); ++it) {
+        const EqualJoinTable::Bucket& lefts = table.probe(it->get());
+
+        for(auto left = lefts.begin(); left != lefts.end(); ++left) {
+            result.insert(ConditionPair(*left, *it));
+        }
+    }
+
+    return result;
+}
+
+}
 }
-}
\ No newline at end of file
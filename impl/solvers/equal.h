@@ -23,11 +23,14 @@
 #include "simple/condition.h"
 #include "simple/condition_set.h"
 #include "impl/condition.h"
+#include "simple/util/relation_index.h"
+#include "simple/util/solver_generator.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 class EqualSolver {
   public:
@@ -45,6 +48,17 @@ class EqualSolver {
     template <typename Condition>
     ConditionSet solve_equal(Condition *condition);
 
+    /*
+     * Both sides of a with clause are query variables. The pairs are
+     * found with a hash join on the compared name or number, building 
+     * the join table over one domain and probing it with the other.
+     */
+    std::set<ConditionPair> solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain);
+
+    std::set<ConditionPair> solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain);
+
   private:
     void index_proc(ProcAst *proc);
     void index_statement_list(StatementAst *statement);
@@ -60,8 +74,8 @@ class EqualSolver {
     void index_const_expr(ConstAst *ast);
 
     SimpleRoot _ast;
-    std::map< std::string, ConditionSet > _name_index;
-    std::map< int, ConditionSet > _number_index;
+    HashIndex< std::string, ConditionSet > _name_index;
+    HashIndex< int, ConditionSet > _number_index;
 };
 
 template <typename Condition>
@@ -168,12 +182,16 @@ bool EqualSolver::validate(Condition1 *condition1, Condition2 *condition2) {
     }
 
     if(has_number<Condition1>(condition1) && has_number<Condition2>(condition2)) {
-        return get_number<Condition1>(condition1) && get_number<Condition2>(condition2);
+        return get_number<Condition1>(condition1) == get_number<Condition2>(condition2);
     }
 
     return false;
 }
 
+template <>
+class SolverBatchTraits<EqualSolver> : 
+    public DirectSolverBatchTraits<EqualSolver> 
+{ };
 
 }
 }
\ No newline at end of file
@@ -80,7 +80,7 @@ bool ExprSolver::validate_assign_expr(AssignmentAst *assign_ast, ExprAst *patter
 
 StatementSet ExprSolver::solve_left_statement(ExprAst *pattern) {
     std::string key = expr_to_string(pattern);
-    return _pattern_index[key];
+    return _pattern_index.get(key);
 }
 
 ExprSet ExprSolver::solve_right_statement_expr(StatementAst *statement) {
@@ -141,7 +141,7 @@ void ExprSolver::index_if(IfAst *if_ast) {
 
 void ExprSolver::index_assign(AssignmentAst *assign_ast) {
     std::string key = expr_to_string(assign_ast->get_expr());
-    _pattern_index[key].insert(assign_ast);
+    _pattern_index.insert(key).insert(assign_ast);
 }
 
 }
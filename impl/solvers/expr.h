@@ -23,11 +23,13 @@
 #include "simple/condition.h"
 #include "simple/condition_set.h"
 #include "impl/condition.h"
+#include "simple/util/relation_index.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 class ExprSolver : public QuerySolver {
   public:
@@ -61,7 +63,7 @@ private:
   SimpleRoot _ast;
   
   // map string to set of assign statement for solve-left
-  std::map<std::string, StatementSet > _pattern_index;
+  HashIndex<std::string, StatementSet > _pattern_index;
 };
 
 
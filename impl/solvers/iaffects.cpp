@@ -11,8 +11,9 @@ using namespace simple;
 using namespace simple::util;
 
 IAffectsSolver::IAffectsSolver(std::shared_ptr<NextBipQuerySolver> next_solver,
-    std::shared_ptr<ModifiesSolver> modifies_solver) :
-    AffectsSolver(next_solver, modifies_solver)
+    std::shared_ptr<ModifiesSolver> modifies_solver,
+    const ControlFlowGraph *graph) :
+    AffectsSolver(next_solver, modifies_solver, graph, "iaffects")
 { }
 
 StackedStatementSet IAffectsSolver::solve_affected_by_var_assignment(
@@ -12,7 +12,8 @@ using namespace simple::util;
 class IAffectsSolver : public AffectsSolver {
   public:
     IAffectsSolver(std::shared_ptr<NextBipQuerySolver> next_solver,
-        std::shared_ptr<ModifiesSolver> modifies_solver);
+        std::shared_ptr<ModifiesSolver> modifies_solver,
+        const ControlFlowGraph *graph = NULL);
 
     virtual StackedStatementSet solve_affected_by_var_assignment(
         SimpleVariable var, AssignmentAst *statement, CallStack callstack);
@@ -21,5 +22,14 @@ class IAffectsSolver : public AffectsSolver {
         SimpleVariable var, AssignmentAst *statement, CallStack callstack);
 };
 
+/*
+ * Affects*(a, _) holds exactly when Affects(a, _) holds, so the 
+ * existence checks of AffectsSolver can be used as they are.
+ */
+template <>
+class SolverExistenceTraits<IAffectsSolver> : 
+    public DirectSolverExistenceTraits<IAffectsSolver> 
+{ };
+
 }
 }
\ No newline at end of file
@@ -18,144 +18,125 @@
 
 #include "impl/solvers/icall.h"
 #include "impl/condition.h"
-#include "simple/util/statement_visitor_generator.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
 using namespace simple::impl;
+using namespace simple::util;
 
 ICallSolver::ICallSolver(SimpleRoot ast) : 
-    _ast(ast) 
+    _ast(ast), _graph(ast)
 { 
-    for(SimpleRoot::iterator it = _ast.begin(); 
-        it != _ast.end(); ++it)
-    {
-        index_calls<ProcAst>(*it);
+    for(int proc = 0; proc < _graph.get_proc_count(); ++proc) {
+        _proc_conditions.push_back(new SimpleProcCondition(_graph.get_proc(proc)));
     }
-}
 
-template <>
-ConditionSet ICallSolver::solve_right<ProcAst>(ProcAst *proc) {
-    if(_calls_table.count(proc)) {
-        ConditionSet result;
-        for(std::set<ProcAst*>::iterator it = _calls_table[proc].begin();
-                it != _calls_table[proc].end(); ++it)
-        {
-            result.insert(new SimpleProcCondition(*it));
-        }
-        return result;
-    } else {
-        return ConditionSet();
-    }
+    build_closure();
 }
 
-template <>
-ConditionSet ICallSolver::solve_left<ProcAst>(ProcAst *proc) {
-    if(_called_table.count(proc)) {
-        ConditionSet result;
-        for(std::set<ProcAst*>::iterator it = _called_table[proc].begin();
-                it != _called_table[proc].end(); ++it)
-        {
-            result.insert(new SimpleProcCondition(*it));
+/*
+ * Calls* is non-empty exactly when Calls is, which is when any 
+ * procedure has a callee.
+ */
+bool ICallSolver::is_nonempty(const ConditionSet& universe) {
+    for(int proc = 0; proc < _graph.get_proc_count(); ++proc) {
+        if(_graph.get_callee_begin(proc) != _graph.get_callee_end(proc)) {
+            return true;
         }
-        return result;
-    } else {
-        return ConditionSet();
     }
-}
 
-template <>
-bool ICallSolver::validate<ProcAst, ProcAst>(ProcAst *proc1, ProcAst *proc2)
-{
-    if(_calls_table.count(proc1)) {
-        return _calls_table[proc1].count(proc2) > 0;
-    } else {
-        return false;
-    }
+    return false;
 }
 
-class IndexCallsVisitorTraits {
-  public:
-    typedef bool ResultType;
-    typedef int   ContextType;
+/*
+ * A component calls every procedure its members call directly, together
+ * with everything those procedures call. A component with a call inside
+ * itself also calls all of its own members.
+ */
+void ICallSolver::build_closure() {
+    int proc_count = _graph.get_proc_count();
+    int component_count = _graph.get_component_count();
+
+    _calls_rows.assign(component_count, BitSet(proc_count));
+    _called_rows.assign(component_count, BitSet(proc_count));
+
+    for(int component = 0; component < component_count; ++component) {
+        BitSet& row = _calls_rows[component];
+        const std::vector<int>& members = _graph.get_members(component);
+
+        for(auto proc = members.begin(); proc != members.end(); ++proc) {
+            for(int edge = _graph.get_callee_begin(*proc); 
+                edge < _graph.get_callee_end(*proc); ++edge)
+            {
+                int callee = _graph.get_callee(edge);
+                row.set(callee);
+
+                if(_graph.get_component(callee) != component) {
+                    row.union_with(_calls_rows[_graph.get_component(callee)]);
+                }
+            }
+        }
 
-    template <typename Ast>
-    static bool visit(ICallSolver *solver, Ast *ast, int *context = NULL) 
-    {
-        solver->template index_calls<Ast>(ast);
-        return true;
-    }
-  private:
-    IndexCallsVisitorTraits();
-};
+        if(!_graph.is_cyclic(component)) continue;
 
-template <>
-void ICallSolver::index_calls<StatementAst>(StatementAst *statement) {
-    StatementVisitorGenerator<ICallSolver, IndexCallsVisitorTraits>
-    visitor(this);
+        for(auto proc = members.begin(); proc != members.end(); ++proc) {
+            row.set(*proc);
+        }
+    }
 
-    statement->accept_statement_visitor(&visitor);
-}
+    for(int proc = 0; proc < proc_count; ++proc) {
+        const BitSet& row = _calls_rows[_graph.get_component(proc)];
 
-template <>
-void ICallSolver::index_calls<ProcAst>(ProcAst *proc) {
-    // initialize the calls table to avoid infinite recursion
-    _calls_table[proc]; 
-
-    StatementAst *statement = proc->get_statement();
-    while(statement != NULL) {
-        index_calls<StatementAst>(statement);
-        statement = statement->next();
+        for(size_t callee = row.next(0); callee < row.size(); 
+            callee = row.next(callee + 1))
+        {
+            _called_rows[_graph.get_component(callee)].set(proc);
+        }
     }
 }
 
-template <>
-void ICallSolver::index_calls<CallAst>(CallAst *call) {
-    ProcAst *caller = call->get_proc();
-    ProcAst *callee = call->get_proc_called();
-
-    _calls_table[caller].insert(callee);
-    _called_table[callee].insert(caller);
-
-    if(_calls_table.count(callee) == 0) {
-        index_calls<ProcAst>(callee);
-    }
+/*
+ * The conditions of the procedures are created once and shared by all
+ * results.
+ */
+ConditionSet ICallSolver::to_condition_set(const BitSet& procs) {
+    ConditionSet result;
 
-    for(std::set<ProcAst*>::iterator it = _calls_table[callee].begin();
-            it != _calls_table[callee].end(); ++it)
+    for(size_t proc = procs.next(0); proc < procs.size(); 
+        proc = procs.next(proc + 1))
     {
-        _calls_table[caller].insert(*it);
-        _called_table[*it].insert(caller);
+        result.insert(_proc_conditions[proc]);
     }
+
+    return result;
 }
 
 template <>
-void ICallSolver::index_calls<WhileAst>(WhileAst *loop) {
-    StatementAst *statement = loop->get_body();
-    while(statement != NULL) {
-        index_calls<StatementAst>(statement);
-        statement = statement->next();
-    }
+ConditionSet ICallSolver::solve_right<ProcAst>(ProcAst *proc) {
+    int id = _graph.get_proc_id(proc);
+    if(id == -1) return ConditionSet();
+
+    return to_condition_set(_calls_rows[_graph.get_component(id)]);
 }
 
 template <>
-void ICallSolver::index_calls<IfAst>(IfAst *condition) {
-    StatementAst *statement = condition->get_then_branch();
-    while(statement != NULL) {
-        index_calls<StatementAst>(statement);
-        statement = statement->next();
-    }
+ConditionSet ICallSolver::solve_left<ProcAst>(ProcAst *proc) {
+    int id = _graph.get_proc_id(proc);
+    if(id == -1) return ConditionSet();
 
-    statement = condition->get_else_branch();
-    while(statement != NULL) {
-        index_calls<StatementAst>(statement);
-        statement = statement->next();
-    }
+    return to_condition_set(_called_rows[_graph.get_component(id)]);
 }
 
+template <>
+bool ICallSolver::validate<ProcAst, ProcAst>(ProcAst *proc1, ProcAst *proc2) {
+    int id1 = _graph.get_proc_id(proc1);
+    int id2 = _graph.get_proc_id(proc2);
+    if(id1 == -1 || id2 == -1) return false;
 
+    return _calls_rows[_graph.get_component(id1)].test(id2);
+}
 
 } // namespace impl
 } // namespace simple
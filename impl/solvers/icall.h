@@ -19,23 +19,31 @@
 #pragma once
 
 #include <map>
-#include <set>
+#include <vector>
 #include "simple/ast.h"
 #include "simple/condition.h"
+#include "simple/condition_set.h"
 #include "simple/solver.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/bit_set.h"
+#include "impl/solvers/call_graph.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
+/*
+ * Solver for Calls*. Each component of the condensed call graph gets a
+ * bitset row of the procedures it calls transitively, made from the
+ * rows of the components it calls directly, and a row of the procedures
+ * calling it. All procedures of a component share its rows.
+ */
 class ICallSolver {
   public:
     ICallSolver(SimpleRoot ast);
 
-    /*
-     * SOLVE RIGHT PART
-     */
     template <typename Condition>
     ConditionSet solve_right(Condition *condition) {
         return ConditionSet();
@@ -51,16 +59,20 @@ class ICallSolver {
         return false;
     }
 
-    template <typename Condition>
-    void index_calls(Condition *condition) {
-        // no-op
-    }
+    bool is_nonempty(const ConditionSet& universe);
 
   private:
-    typedef std::map<ProcAst*, std::set<ProcAst*> > ProcIndex;
+    void build_closure();
+
+    ConditionSet to_condition_set(const BitSet& procs);
+
     SimpleRoot _ast;
-    ProcIndex _calls_table;
-    ProcIndex _called_table;
+    CallGraph _graph;
+
+    std::vector<ConditionPtr>   _proc_conditions;
+
+    std::vector<BitSet> _calls_rows;
+    std::vector<BitSet> _called_rows;
 };
 
 template <>
@@ -73,23 +85,9 @@ template <>
 bool ICallSolver::validate<ProcAst, ProcAst>(ProcAst *proc1, ProcAst *proc2);
 
 template <>
-void ICallSolver::index_calls<StatementAst>(StatementAst *statement);
-
-template <>
-void ICallSolver::index_calls<ProcAst>(ProcAst *proc);
-
-template <>
-void ICallSolver::index_calls<CallAst>(CallAst *call);
-
-template <>
-void ICallSolver::index_calls<WhileAst>(WhileAst *loop);
-
-template <>
-void ICallSolver::index_calls<IfAst>(IfAst *condition);
-
-
-
-
+class SolverExistenceTraits<ICallSolver> : 
+    public DirectSolverNonemptyTraits<ICallSolver> 
+{ };
 
 } // namespace impl
 } // namespace simple
@@ -127,7 +127,7 @@ ExprSet IExprSolver::solve_right_assign_expr(AssignmentAst *assign_ast) {
 StatementSet IExprSolver::solve_left_statement(ExprAst *pattern) {
     std::string key = expr_to_string(pattern);
 
-    return _pattern_index[key];
+    return _pattern_index.get(key);
 }
 
 void IExprSolver::index_proc(ProcAst *proc) {
@@ -175,7 +175,7 @@ void IExprSolver::index_assign(AssignmentAst *assign_ast) {
     
     for (auto it = sub_exprs.begin(); it != sub_exprs.end(); ++it) {
         std::string key = expr_to_string(*it);
-        _pattern_index[key].insert(assign_ast);
+        _pattern_index.insert(key).insert(assign_ast);
     }
 }
 
@@ -17,11 +17,14 @@
  */
 
 #include "impl/solvers/ifollows.h"
+#include "simple/util/condition_domain.h"
+#include "simple/util/condition_utils.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 template <>
 ConditionSet IFollowSolver::solve_right<StatementAst>(StatementAst *statement) {
@@ -62,8 +65,49 @@ bool IFollowSolver::validate<StatementAst, StatementAst>(
     return false;
 }
 
+/*
+ * The domain is indexed once for the whole batch, so that each
+ * statement in the follows chain is checked with a single lookup.
+ */
+std::set<ConditionPair> IFollowSolver::solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+{
+    std::set<ConditionPair> result;
+    StatementDomain domain = make_statement_domain(right_domain);
+
+    for(auto it = lefts.begin(); it != lefts.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+        if(condition == NULL) continue;
+
+        StatementAst *statement = condition->get_statement_ast()->next();
+        while(statement != NULL) {
+            insert_right_pair(result, *it, domain, statement);
+            statement = statement->next();
+        }
+    }
 
+    return result;
+}
 
+std::set<ConditionPair> IFollowSolver::solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain)
+{
+    std::set<ConditionPair> result;
+    StatementDomain domain = make_statement_domain(left_domain);
+
+    for(auto it = rights.begin(); it != rights.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+        if(condition == NULL) continue;
+
+        StatementAst *statement = condition->get_statement_ast()->prev();
+        while(statement != NULL) {
+            insert_left_pair(result, domain, statement, *it);
+            statement = statement->prev();
+        }
+    }
+
+    return result;
+}
 
 }
 }
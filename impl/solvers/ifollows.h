@@ -22,6 +22,7 @@
 #include "simple/condition.h"
 #include "simple/solver.h"
 #include "impl/condition.h"
+#include "simple/util/solver_generator.h"
 
 namespace simple {
 namespace impl {
@@ -50,6 +51,12 @@ class IFollowSolver {
         return false;
     }
 
+    std::set<ConditionPair> solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain);
+
+    std::set<ConditionPair> solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain);
+
   private:
     SimpleRoot _ast;
 };
@@ -64,6 +71,11 @@ template <>
 bool IFollowSolver::validate<StatementAst, StatementAst>(
         StatementAst *left, StatementAst *right);
 
+template <>
+class SolverBatchTraits<IFollowSolver> : 
+    public DirectSolverBatchTraits<IFollowSolver> 
+{ };
+
 
 } // namespace impl
 } // namespace simple
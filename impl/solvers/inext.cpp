@@ -38,28 +38,131 @@ ConditionSet INextSolver::solve_left<StatementAst>(StatementAst *statement) {
 }
 
 StatementSet INextSolver::solve_next_statement(StatementAst *statement) {
-    if(_inext_cache.count(statement) > 0) return _inext_cache[statement];
+    std::shared_ptr<const StatementSet> cached = _inext_cache.find(statement);
+    if(cached != NULL) return *cached;
 
-    _visit_cache.clear();
-    StatementSet results = to_statement_set(
-        solve_inext(statement, CallStack()));
+    int id = _graph != NULL ? _graph->get_id(statement) : -1;
+    StatementSet results;
 
-    _inext_cache[statement] = results;
+    if(id != -1) {
+        results = solve_block_inext(id);
+    } else {
+        _visit_cache.clear();
+        results = to_statement_set(solve_inext(statement, CallStack()));
+    }
+
+    _inext_cache.insert(statement, results);
 
     return results;
 }
 
+/*
+ * Next* is non-empty exactly when Next is, which is when the first
+ * statement of any procedure has a next statement.
+ */
+bool INextSolver::is_nonempty(const ConditionSet& universe) {
+    for(SimpleRoot::iterator it = _ast.begin(); it != _ast.end(); ++it) {
+        if(!_next_solver->solve_next_bip_statement(
+                (*it)->get_statement(), CallStack()).empty()) 
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 StatementSet INextSolver::solve_prev_statement(StatementAst *statement) {
-    if(_iprev_cache.count(statement) > 0) return _iprev_cache[statement];
+    std::shared_ptr<const StatementSet> cached = _iprev_cache.find(statement);
+    if(cached != NULL) return *cached;
+
+    int id = _graph != NULL ? _graph->get_id(statement) : -1;
+    StatementSet results;
 
-    _visit_cache.clear();
-    StatementSet results = to_statement_set(
-        solve_iprev(statement, CallStack()));
+    if(id != -1) {
+        results = solve_block_iprev(id);
+    } else {
+        _visit_cache.clear();
+        results = to_statement_set(solve_iprev(statement, CallStack()));
+    }
 
-    _iprev_cache[statement] = results;
+    _iprev_cache.insert(statement, results);
     return results;
 }
 
+/*
+ * The rest of the block of the statement is reached straight away, and
+ * every block reached from its end is reached whole.
+ */
+StatementSet INextSolver::solve_block_inext(int id) {
+    BitSet reached(_graph->size());
+    BitSet visited(_graph->get_block_count());
+
+    int block = _graph->get_block(id);
+    reached.set_range(id + 1, _graph->get_block_end(block));
+
+    std::vector<int> pending(1, block);
+
+    while(!pending.empty()) {
+        block = pending.back();
+        pending.pop_back();
+
+        ControlFlowGraph::Slice next = _graph->get_next(
+            _graph->get_block_end(block) - 1);
+
+        for(const int *it = next.begin; it != next.end; ++it) {
+            int next_block = _graph->get_block(*it);
+            if(visited.test(next_block)) continue;
+
+            visited.set(next_block);
+            reached.set_range(_graph->get_block_begin(next_block),
+                _graph->get_block_end(next_block));
+            pending.push_back(next_block);
+        }
+    }
+
+    return ids_to_statement_set(reached);
+}
+
+StatementSet INextSolver::solve_block_iprev(int id) {
+    BitSet reached(_graph->size());
+    BitSet visited(_graph->get_block_count());
+
+    int block = _graph->get_block(id);
+    reached.set_range(_graph->get_block_begin(block), id);
+
+    std::vector<int> pending(1, block);
+
+    while(!pending.empty()) {
+        block = pending.back();
+        pending.pop_back();
+
+        ControlFlowGraph::Slice prev = _graph->get_prev(
+            _graph->get_block_begin(block));
+
+        for(const int *it = prev.begin; it != prev.end; ++it) {
+            int prev_block = _graph->get_block(*it);
+            if(visited.test(prev_block)) continue;
+
+            visited.set(prev_block);
+            reached.set_range(_graph->get_block_begin(prev_block),
+                _graph->get_block_end(prev_block));
+            pending.push_back(prev_block);
+        }
+    }
+
+    return ids_to_statement_set(reached);
+}
+
+StatementSet INextSolver::ids_to_statement_set(const BitSet& ids) {
+    StatementSet result;
+    for(size_t id = ids.next(0); id < ids.size(); id = ids.next(id + 1)) {
+        result.insert(_graph->get_statement(id));
+    }
+
+    return result;
+}
+
 StackedStatementSet INextSolver::solve_inext(
     StatementAst *statement, CallStack callstack) 
 {
@@ -20,21 +20,33 @@
 
 #include <map>
 #include "simple/solver.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/relation_index.h"
+#include "simple/util/bit_set.h"
+#include "simple/util/memo_cache.h"
 #include "simple/next.h"
 #include "simple/condition_set.h"
 #include "simple/ast.h"
+#include "impl/solvers/control_flow_graph.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 class INextSolver : public NextQuerySolver {
   public:
-    typedef std::map<StatementAst*, StatementSet>  INextTable;
-
-    INextSolver(SimpleRoot ast, std::shared_ptr<NextBipQuerySolver> solver) :
-        _ast(ast), _next_solver(solver)
+    typedef MemoCache<StatementAst*, StatementSet>  INextTable;
+
+    /*
+     * With the control flow graph of the next solver, Next* is walked 
+     * a basic block at a time.
+     */
+    INextSolver(SimpleRoot ast, std::shared_ptr<NextBipQuerySolver> solver,
+        const ControlFlowGraph *graph = NULL) :
+        _ast(ast), _next_solver(solver), _graph(graph),
+        _inext_cache("inext"), _iprev_cache("iprev")
     { }
 
     StatementSet solve_next_statement(StatementAst *statement);
@@ -61,9 +73,17 @@ class INextSolver : public NextQuerySolver {
         return false;
     }
 
+    bool is_nonempty(const ConditionSet& universe);
+
   private:
+    StatementSet solve_block_inext(int id);
+    StatementSet solve_block_iprev(int id);
+
+    StatementSet ids_to_statement_set(const BitSet& ids);
+
     SimpleRoot _ast;
     std::shared_ptr<NextBipQuerySolver> _next_solver;
+    const ControlFlowGraph *_graph;
 
     INextTable _inext_cache;
     INextTable _iprev_cache;
@@ -81,5 +101,10 @@ ConditionSet INextSolver::solve_right<StatementAst>(StatementAst *statement);
 template <>
 ConditionSet INextSolver::solve_left<StatementAst>(StatementAst *statement);
 
+template <>
+class SolverExistenceTraits<INextSolver> : 
+    public DirectSolverNonemptyTraits<INextSolver> 
+{ };
+
 }
 }
@@ -0,0 +1,73 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "impl/solvers/inext_bip.h"
+#include "impl/condition.h"
+#include "simple/util/set_convert.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple::util;
+
+template <>
+ConditionSet INextBipSolver::solve_right<StatementAst>(StatementAst *statement) {
+    return statement_set_to_condition_set(solve_next_statement(statement));
+}
+
+template <>
+ConditionSet INextBipSolver::solve_left<StatementAst>(StatementAst *statement) {
+    return statement_set_to_condition_set(solve_prev_statement(statement));
+}
+
+StatementSet INextBipSolver::solve_next_statement(StatementAst *statement) {
+    std::shared_ptr<const StatementSet> cached = _inext_cache.find(statement);
+    if(cached != NULL) return *cached;
+
+    StatementSet results = _next_bip_solver->solve_inext_statement(statement);
+    _inext_cache.insert(statement, results);
+
+    return results;
+}
+
+/*
+ * NextBip* is non-empty exactly when NextBip is.
+ */
+bool INextBipSolver::is_nonempty(const ConditionSet& universe) {
+    return _next_bip_solver->is_nonempty(universe);
+}
+
+StatementSet INextBipSolver::solve_prev_statement(StatementAst *statement) {
+    std::shared_ptr<const StatementSet> cached = _iprev_cache.find(statement);
+    if(cached != NULL) return *cached;
+
+    StatementSet results = _next_bip_solver->solve_iprev_statement(statement);
+    _iprev_cache.insert(statement, results);
+
+    return results;
+}
+
+template <>
+bool INextBipSolver::validate<StatementAst, StatementAst>(
+        StatementAst *statement1, StatementAst *statement2)
+{
+    return solve_next_statement(statement1).count(statement2) > 0;
+}
+
+} // namespace impl
+} // namespace simple
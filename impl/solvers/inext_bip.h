@@ -0,0 +1,93 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include "simple/solver.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/relation_index.h"
+#include "simple/util/memo_cache.h"
+#include "simple/condition_set.h"
+#include "simple/ast.h"
+#include "impl/solvers/next_bip.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * Solver for NextBip*. The reachability is computed on the
+ * interprocedural graph of NextBipSolver, so unlike INextSolver it does
+ * not need to carry a call stack.
+ */
+class INextBipSolver {
+  public:
+    typedef MemoCache<StatementAst*, StatementSet>  INextTable;
+
+    INextBipSolver(std::shared_ptr<NextBipSolver> solver) :
+        _next_bip_solver(solver),
+        _inext_cache("inext_bip"), _iprev_cache("iprev_bip")
+    { }
+
+    StatementSet solve_next_statement(StatementAst *statement);
+    StatementSet solve_prev_statement(StatementAst *statement);
+
+    template <typename Condition>
+    ConditionSet solve_right(Condition *condition) {
+        return ConditionSet();
+    }
+
+    template <typename Condition>
+    ConditionSet solve_left(Condition *condition) {
+        return ConditionSet();
+    }
+
+    template <typename Condition1, typename Condition2>
+    bool validate(Condition1 *condition1, Condition2 *condition2) {
+        return false;
+    }
+
+    bool is_nonempty(const ConditionSet& universe);
+
+  private:
+    std::shared_ptr<NextBipSolver> _next_bip_solver;
+
+    INextTable _inext_cache;
+    INextTable _iprev_cache;
+};
+
+template <>
+bool INextBipSolver::validate<StatementAst, StatementAst>(
+        StatementAst *statement1, StatementAst *statement2);
+
+template <>
+ConditionSet INextBipSolver::solve_right<StatementAst>(StatementAst *statement);
+
+template <>
+ConditionSet INextBipSolver::solve_left<StatementAst>(StatementAst *statement);
+
+template <>
+class SolverExistenceTraits<INextBipSolver> : 
+    public DirectSolverNonemptyTraits<INextBipSolver> 
+{ };
+
+} // namespace impl
+} // namespace simple
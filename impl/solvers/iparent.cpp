@@ -18,12 +18,15 @@
 
 #include "impl/solvers/iparent.h"
 #include "simple/util/statement_visitor_generator.h"
+#include "simple/util/ast_utils.h"
+#include "simple/util/condition_utils.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
 using namespace simple::impl;
+using namespace simple::util;
 
 
 template <>
@@ -118,7 +121,73 @@ bool IParentSolver::validate<WhileAst, StatementAst>(
     return validate<ContainerAst, StatementAst>(loop, statement);
 }
 
+/*
+ * Insert the pairs of left with every statement nested in the
+ * statement list starting at statement.
+ */
+void IParentSolver::insert_descendants(StatementAst *statement, 
+    const ConditionPtr& left, const StatementDomain& domain, 
+    std::set<ConditionPair>& result)
+{
+    while(statement != NULL) {
+        insert_right_pair(result, left, domain, statement);
+
+        if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            insert_descendants(loop->get_body(), left, domain, result);
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            insert_descendants(condition->get_then_branch(), left, domain, result);
+            insert_descendants(condition->get_else_branch(), left, domain, result);
+        }
+
+        statement = statement->next();
+    }
+}
+
+std::set<ConditionPair> IParentSolver::solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+{
+    std::set<ConditionPair> result;
+    StatementDomain domain = make_statement_domain(right_domain);
+
+    for(auto it = lefts.begin(); it != lefts.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+        if(condition == NULL) continue;
+
+        StatementAst *statement = condition->get_statement_ast();
 
+        if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            insert_descendants(loop->get_body(), *it, domain, result);
+
+        } else if(IfAst *branch = statement_cast<IfAst>(statement)) {
+            insert_descendants(branch->get_then_branch(), *it, domain, result);
+            insert_descendants(branch->get_else_branch(), *it, domain, result);
+        }
+    }
+
+    return result;
+}
+
+std::set<ConditionPair> IParentSolver::solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain)
+{
+    std::set<ConditionPair> result;
+    StatementDomain domain = make_statement_domain(left_domain);
+
+    for(auto it = rights.begin(); it != rights.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+        if(condition == NULL) continue;
+
+        StatementAst *parent = condition->get_statement_ast()->get_parent();
+        while(parent != NULL) {
+            insert_left_pair(result, domain, 
+                static_cast<StatementAst*>(parent), *it);
+            parent = parent->get_parent();
+        }
+    }
+
+    return result;
+}
 
 }
 }
@@ -22,6 +22,8 @@
 #include "simple/condition.h"
 #include "simple/solver.h"
 #include "impl/condition.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/condition_domain.h"
 
 namespace simple {
 namespace impl {
@@ -51,8 +53,17 @@ class IParentSolver {
         return false;
     }
 
+    std::set<ConditionPair> solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain);
+
+    std::set<ConditionPair> solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain);
+
   private:
     SimpleRoot _ast;
+
+    void insert_descendants(StatementAst *statement, const ConditionPtr& left,
+        const util::StatementDomain& domain, std::set<ConditionPair>& result);
 };
 
 
@@ -84,6 +95,11 @@ template <>
 bool IParentSolver::validate<WhileAst, StatementAst>(
         WhileAst *loop, StatementAst *statement);
 
+template <>
+class SolverBatchTraits<IParentSolver> : 
+    public DirectSolverBatchTraits<IParentSolver> 
+{ };
+
 
 } // namespace impl
 } // namespace simple
@@ -33,5 +33,15 @@ class ModifiesSolver : public AssignmentSolver {
     VariableSet get_vars_modified_by_proc(ProcAst *proc);
 };
 
+template <>
+class SolverExistenceTraits<ModifiesSolver> : 
+    public DirectSolverExistenceTraits<ModifiesSolver> 
+{ };
+
+template <>
+class SolverBatchTraits<ModifiesSolver> : 
+    public DirectSolverBatchTraits<ModifiesSolver> 
+{ };
+
 } // namespace impl
 } // namespace simple
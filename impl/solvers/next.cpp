@@ -100,14 +100,73 @@ class ValidateNextStatementVisitor : public StatementVisitor {
 
 template <>
 ConditionSet NextSolver::solve_right<StatementAst>(StatementAst *ast) {
-    StatementSet statements = solve_next<StatementAst>(ast);
-    return statement_set_to_condition_set(statements);
+    std::shared_ptr<const ConditionSet> cached = _next_condition_cache.find(ast);
+    if(cached != NULL) return *cached;
+
+    ConditionSet result = statement_set_to_condition_set(
+        solve_next<StatementAst>(ast));
+    _next_condition_cache.insert(ast, result);
+
+    return result;
 }
 
 template <>
 ConditionSet NextSolver::solve_left<StatementAst>(StatementAst *ast) {
-    StatementSet statements = solve_previous<StatementAst>(ast);
-    return statement_set_to_condition_set(statements);
+    std::shared_ptr<const ConditionSet> cached = _prev_condition_cache.find(ast);
+    if(cached != NULL) return *cached;
+
+    ConditionSet result = statement_set_to_condition_set(
+        solve_previous<StatementAst>(ast));
+    _prev_condition_cache.insert(ast, result);
+
+    return result;
+}
+
+/*
+ * A statement has a next statement if it is a container, or if it or
+ * one of its enclosing if statements has a following statement, or if
+ * it is nested in a while loop which it can go back to.
+ */
+template <>
+bool NextSolver::has_right<StatementAst>(StatementAst *ast) {
+    StatementType type = get_statement_type(ast);
+    if(type == WhileST || type == IfST) return true;
+
+    StatementAst *statement = ast;
+    while(statement->next() == NULL) {
+        ContainerAst *parent = statement->get_parent();
+
+        if(parent == NULL) return false;
+        if(get_statement_type(parent) == WhileST) return true;
+
+        statement = parent;
+    }
+
+    return true;
+}
+
+/*
+ * A statement has a previous statement unless it is the first statement
+ * of a procedure. Even then a while statement is reached from the end
+ * of its body.
+ */
+template <>
+bool NextSolver::has_left<StatementAst>(StatementAst *ast) {
+    return ast->prev() != NULL || ast->get_parent() != NULL ||
+        get_statement_type(ast) == WhileST;
+}
+
+/*
+ * The Next relation is non-empty if any procedure has more than a single
+ * simple statement, which is exactly when its first statement has a next
+ * statement.
+ */
+bool NextSolver::is_nonempty(const ConditionSet& universe) {
+    for(SimpleRoot::iterator it = _ast.begin(); it != _ast.end(); ++it) {
+        if(has_right<StatementAst>((*it)->get_statement())) return true;
+    }
+
+    return false;
 }
 
 StatementSet NextSolver::solve_next_statement(StatementAst *statement) {
@@ -121,7 +180,8 @@ StatementSet NextSolver::solve_prev_statement(StatementAst *statement) {
 
 template <>
 StatementSet NextSolver::solve_next<StatementAst>(StatementAst *ast) {
-    if(_next_cache.count(ast) > 0) return _next_cache[ast];
+    std::shared_ptr<const StatementSet> cached = _next_cache.find(ast);
+    if(cached != NULL) return *cached;
 
     StatementVisitorGenerator<NextSolver,
         SolveNextVisitorTraits> visitor(this);
@@ -129,7 +189,7 @@ StatementSet NextSolver::solve_next<StatementAst>(StatementAst *ast) {
 
     StatementSet result = visitor.return_result();
 
-    _next_cache[ast] = result;
+    _next_cache.insert(ast, result);
     return result;
 }
 
@@ -297,7 +357,8 @@ StatementSet NextSolver::solve_preceeding_previous<IfAst>(IfAst *ast) {
 
 template <>
 StatementSet NextSolver::solve_previous<StatementAst>(StatementAst *ast) {
-    if(_prev_cache.count(ast) > 0) return _prev_cache[ast];
+    std::shared_ptr<const StatementSet> cached = _prev_cache.find(ast);
+    if(cached != NULL) return *cached;
 
     StatementSet result;
     
@@ -322,7 +383,7 @@ StatementSet NextSolver::solve_previous<StatementAst>(StatementAst *ast) {
 
     union_set(result, visitor.return_result());
 
-    _prev_cache[ast] = result;
+    _prev_cache.insert(ast, result);
     return result;
 }
 
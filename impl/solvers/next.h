@@ -26,15 +26,23 @@
 #include "simple/condition_set.h"
 #include "simple/solver.h"
 #include "simple/next.h"
+#include "simple/util/solver_generator.h"
+#include "simple/util/relation_index.h"
+#include "simple/util/memo_cache.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 class NextSolver : public SimpleNextQuerySolver {
   public:
-    NextSolver(SimpleRoot ast) : _ast(ast) { }
+    NextSolver(SimpleRoot ast) : 
+        _ast(ast), _next_cache("next"), _prev_cache("prev"),
+        _next_condition_cache("next.condition"),
+        _prev_condition_cache("prev.condition")
+    { }
 
     template <typename Condition>
     ConditionSet solve_right(Condition *condition);
@@ -69,10 +77,25 @@ class NextSolver : public SimpleNextQuerySolver {
     template <typename Container>
     bool validate_container_next(Container *container, StatementAst *statement);
 
+    template <typename Condition>
+    bool has_right(Condition *condition);
+
+    template <typename Condition>
+    bool has_left(Condition *condition);
+
+    bool is_nonempty(const ConditionSet& universe);
+
   private:
     SimpleRoot _ast;
-    std::map<StatementAst*, StatementSet> _next_cache;
-    std::map<StatementAst*, StatementSet> _prev_cache;
+    MemoCache<StatementAst*, StatementSet> _next_cache;
+    MemoCache<StatementAst*, StatementSet> _prev_cache;
+
+    /*
+     * The results of solve_right() and solve_left(), which share their
+     * storage with every copy handed out.
+     */
+    MemoCache<StatementAst*, ConditionSet> _next_condition_cache;
+    MemoCache<StatementAst*, ConditionSet> _prev_condition_cache;
 };
 
 template <typename Condition>
@@ -100,6 +123,16 @@ bool NextSolver::validate(Condition1 *condition1, Condition2 *condition2) {
     return false;
 }
 
+template <typename Condition>
+bool NextSolver::has_right(Condition *condition) {
+    return false;
+}
+
+template <typename Condition>
+bool NextSolver::has_left(Condition *condition) {
+    return false;
+}
+
 template <typename Condition>
 StatementSet NextSolver::solve_previous(Condition *condition) {
     return StatementSet();
@@ -136,6 +169,12 @@ ConditionSet NextSolver::solve_right<StatementAst>(StatementAst *ast);
 template <>
 ConditionSet NextSolver::solve_left<StatementAst>(StatementAst *ast);
 
+template <>
+bool NextSolver::has_right<StatementAst>(StatementAst *ast);
+
+template <>
+bool NextSolver::has_left<StatementAst>(StatementAst *ast);
+
 template <>
 StatementSet NextSolver::solve_next<StatementAst>(StatementAst *ast);
 
@@ -197,6 +236,11 @@ bool NextSolver::validate_container_next<IfAst>(IfAst *container, StatementAst *
 template <>
 bool NextSolver::validate_container_next<WhileAst>(WhileAst *container, StatementAst *statement);
 
+template <>
+class SolverExistenceTraits<NextSolver> : 
+    public DirectSolverExistenceTraits<NextSolver> 
+{ };
+
 
 template <>
 StatementSet NextSolver::solve_container_next<ContainerAst>(ContainerAst *container);
@@ -42,6 +42,9 @@ NextBipSolver::NextBipSolver(SimpleRoot ast,
     for(auto it=ast.begin(); it!=ast.end(); ++it) {
         index_last_proc_statement(*it);
     }
+
+    _graph.reset(new NextBipGraph(
+        ast, next_solver, calls_solver));
 }
 
 StackedStatementSet NextBipSolver::solve_next_bip(
@@ -109,7 +112,7 @@ StackedStatementSet NextBipSolver::solve_prev_bip_statement(
             CallStack current_stack(callstack);
             current_stack.push(calls);
 
-            StatementSet last_statements = _last_statement_index[calls->get_proc_called()];
+            const StatementSet& last_statements = _last_statement_index.get(calls->get_proc_called());
             for(auto it2 = last_statements.begin(); it2 != last_statements.end(); ++it2) {
                 result.insert(StackedStatement(*it2, current_stack));
             }
@@ -141,20 +144,43 @@ bool NextBipSolver::is_bip() {
 }
 
 StatementSet NextBipSolver::solve_next_statement(StatementAst *statement) {
-    CallStack callstack;
-
-    return to_statement_set(solve_next_bip_statement(statement, callstack));
+    return _graph->solve_next(statement);
 }
 
 StatementSet NextBipSolver::solve_prev_statement(StatementAst *statement) {
-    CallStack callstack;
+    return _graph->solve_prev(statement);
+}
+
+/*
+ * A procedure whose first statement has no NextBip is a single
+ * assignment, which can only be followed by a return into a procedure 
+ * calling it. The first statement of that procedure then either is the
+ * call or has a next statement, so checking the first statements is
+ * enough.
+ */
+bool NextBipSolver::is_nonempty(const ConditionSet& universe) {
+    for(SimpleRoot::iterator it = _ast.begin(); it != _ast.end(); ++it) {
+        if(!solve_next_statement((*it)->get_statement()).empty()) return true;
+    }
+
+    return false;
+}
+
+StatementSet NextBipSolver::solve_inext_statement(StatementAst *statement) {
+    return _graph->solve_inext(statement);
+}
+
+StatementSet NextBipSolver::solve_iprev_statement(StatementAst *statement) {
+    return _graph->solve_iprev(statement);
+}
 
-    return to_statement_set(solve_prev_bip_statement(statement, callstack));
+NextBipGraph* NextBipSolver::get_graph() {
+    return _graph.get();
 }
 
 
 void NextBipSolver::index_last_proc_statement(ProcAst *proc) {
-    _last_statement_index[proc] = last_statements_in_list(proc->get_statement());
+    _last_statement_index.insert(proc, last_statements_in_list(proc->get_statement()));
 }
 
 StatementSet NextBipSolver::last_statements_in_list(StatementAst *statement) {
@@ -186,15 +212,15 @@ StatementSet NextBipSolver::last_statements_in_statement(StatementAst *statement
 }
 
 StatementSet NextBipSolver::last_statements_in_while(WhileAst *ast) {
-    StatementSet result = last_statements_in_statement(ast->get_body());
+    StatementSet result = last_statements_in_list(ast->get_body());
     result.insert(ast);
 
     return result;
 }
 
 StatementSet NextBipSolver::last_statements_in_if(IfAst *ast) {
-    StatementSet then_result = last_statements_in_statement(ast->get_then_branch());
-    StatementSet else_result = last_statements_in_statement(ast->get_else_branch());
+    StatementSet then_result = last_statements_in_list(ast->get_then_branch());
+    StatementSet else_result = last_statements_in_list(ast->get_else_branch());
 
     union_set(then_result, else_result);
     return then_result;
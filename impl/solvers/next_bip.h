@@ -25,7 +25,9 @@
 #include "simple/condition_set.h"
 #include "simple/util/ast_utils.h"
 #include "simple/solver.h"
+#include "simple/util/solver_generator.h"
 #include "simple/next.h"
+#include "impl/solvers/next_bip_graph.h"
 
 namespace simple {
 namespace impl {
@@ -50,6 +52,8 @@ class NextBipSolver :
     template <typename Condition1, typename Condition2>
     bool validate(Condition1 *condition1, Condition2 *condition2);
 
+    bool is_nonempty(const ConditionSet& universe);
+
     StatementSet solve_next_statement(StatementAst *statement);
 
     StatementSet solve_prev_statement(StatementAst *statement);
@@ -62,6 +66,12 @@ class NextBipSolver :
 
     bool is_bip();
 
+    StatementSet solve_inext_statement(StatementAst *statement);
+
+    StatementSet solve_iprev_statement(StatementAst *statement);
+
+    NextBipGraph* get_graph();
+
     StackedStatementSet solve_next_bip(
         StatementAst *statement, CallStack callstack);
     
@@ -80,7 +90,9 @@ class NextBipSolver :
     std::shared_ptr<NextQuerySolver> _next_solver;
     std::shared_ptr<CallsQuerySolver> _calls_solver;
 
-    std::map< ProcAst*, StatementSet > _last_statement_index;
+    HashIndex< ProcAst*, StatementSet > _last_statement_index;
+
+    std::unique_ptr<NextBipGraph> _graph;
 };
 
 template <typename Condition>
@@ -108,5 +120,10 @@ template <>
 bool NextBipSolver::validate<StatementAst, StatementAst>(
         StatementAst *statement1, StatementAst *statement2);
 
+template <>
+class SolverExistenceTraits<NextBipSolver> : 
+    public DirectSolverNonemptyTraits<NextBipSolver> 
+{ };
+
 }
 }
\ No newline at end of file
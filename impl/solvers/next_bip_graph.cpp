@@ -0,0 +1,373 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "impl/solvers/next_bip_graph.h"
+#include "simple/util/ast_utils.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+bool is_last_statement(StatementAst *statement);
+
+NextBipGraph::NextBipGraph(SimpleRoot ast,
+    std::shared_ptr<NextQuerySolver> next_solver,
+    std::shared_ptr<CallsQuerySolver> calls_solver) :
+    _ast(ast), _next_solver(next_solver), _calls_solver(calls_solver)
+{
+    for(auto it = _ast.begin(); it != _ast.end(); ++it) {
+        _proc_index.insert(*it, _procs.size());
+        _procs.push_back(*it);
+
+        index_statement_list((*it)->get_statement());
+    }
+
+    _statement_count = _nodes.size();
+
+    for(size_t i = 0; i < _procs.size(); ++i) {
+        _exit_nodes.push_back(add_node(NULL));
+        _entry_nodes.push_back(add_node(NULL));
+    }
+
+    build_forward_graph();
+    build_backward_graph();
+}
+
+void NextBipGraph::index_statement_list(StatementAst *statement) {
+    while(statement != NULL) {
+        add_node(statement);
+
+        if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            index_statement_list(loop->get_body());
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            index_statement_list(condition->get_then_branch());
+            index_statement_list(condition->get_else_branch());
+        }
+
+        statement = statement->next();
+    }
+}
+
+/*
+ * Add a node for the statement, or a node that is not a statement if
+ * statement is NULL.
+ */
+int NextBipGraph::add_node(StatementAst *statement) {
+    int node = _nodes.size();
+    _nodes.push_back(statement);
+
+    if(statement != NULL) _node_index.insert(statement, node);
+
+    return node;
+}
+
+int NextBipGraph::get_node(StatementAst *statement) {
+    const int *node = _node_index.find(statement);
+    if(node == NULL) return -1;
+
+    return *node;
+}
+
+StatementAst* NextBipGraph::get_statement(int node) const {
+    return _nodes[node];
+}
+
+const NextBipGraph::DirectedGraph& NextBipGraph::get_forward_graph() const {
+    return _forward_graph;
+}
+
+const NextBipGraph::DirectedGraph& NextBipGraph::get_backward_graph() const {
+    return _backward_graph;
+}
+
+/*
+ * A call statement leaves through its return node. The return node goes
+ * to the next statements of the call, and to the exit node of the
+ * procedure if the call is the last statement.
+ */
+void NextBipGraph::build_forward_graph() {
+    size_t statement_count = _statement_count;
+    Graph& graph = _forward_graph.edges;
+    graph.resize(_nodes.size());
+
+    for(size_t node = 0; node < statement_count; ++node) {
+        StatementAst *statement = _nodes[node];
+        int exit_node = _exit_nodes[_proc_index.get(statement->get_proc())];
+        int from = node;
+
+        if(CallAst *call = statement_cast<CallAst>(statement)) {
+            int proc = _proc_index.get(call->get_proc_called());
+            int return_node = add_node(NULL);
+            graph.resize(_nodes.size());
+
+            graph[node].push_back(Edge(
+                get_node(_procs[proc]->get_statement()), CallEdge));
+            _forward_graph.call_sites.insert(std::make_pair(
+                node, CallSite(node, proc, return_node)));
+
+            from = return_node;
+        }
+
+        StatementSet next = _next_solver->solve_next_statement(statement);
+        for(auto it = next.begin(); it != next.end(); ++it) {
+            graph[from].push_back(Edge(get_node(*it), IntraEdge));
+        }
+
+        if(is_last_statement(statement)) {
+            graph[from].push_back(Edge(exit_node, IntraEdge));
+        }
+    }
+
+    const std::map<int, CallSite>& call_sites = _forward_graph.call_sites;
+    for(auto it = call_sites.begin(); it != call_sites.end(); ++it) {
+        int exit_node = _exit_nodes[it->second.proc];
+        graph[exit_node].push_back(Edge(it->second.target, ReturnEdge));
+    }
+
+    _forward_graph.start_nodes.resize(_procs.size());
+    for(size_t proc = 0; proc < _procs.size(); ++proc) {
+        _forward_graph.start_nodes[proc].push_back(
+            get_node(_procs[proc]->get_statement()));
+    }
+
+    _forward_graph.end_nodes = _exit_nodes;
+    add_summary_edges(_forward_graph);
+}
+
+/*
+ * The backward graph is the transpose of the forward graph, so that the
+ * two always agree. The return node of a call is where the backward walk
+ * enters the called procedure, through its exit node. The first
+ * statement of a procedure goes to the entry node, which goes to every
+ * calling statement.
+ */
+void NextBipGraph::build_backward_graph() {
+    const Graph& forward = _forward_graph.edges;
+    Graph& graph = _backward_graph.edges;
+    graph.resize(_nodes.size());
+
+    for(size_t node = 0; node < forward.size(); ++node) {
+        for(auto it = forward[node].begin(); it != forward[node].end(); ++it) {
+            if(it->type == IntraEdge) {
+                graph[it->target].push_back(Edge(node, IntraEdge));
+            }
+        }
+    }
+
+    const std::map<int, CallSite>& call_sites = _forward_graph.call_sites;
+    for(auto it = call_sites.begin(); it != call_sites.end(); ++it) {
+        int proc = it->second.proc;
+        int return_node = it->second.target;
+
+        graph[return_node].push_back(Edge(_exit_nodes[proc], CallEdge));
+        graph[_entry_nodes[proc]].push_back(Edge(it->first, ReturnEdge));
+
+        _backward_graph.call_sites.insert(std::make_pair(
+            return_node, CallSite(return_node, proc, it->first)));
+    }
+
+    _backward_graph.start_nodes.resize(_procs.size());
+    for(size_t proc = 0; proc < _procs.size(); ++proc) {
+        int first_node = get_node(_procs[proc]->get_statement());
+        graph[first_node].push_back(Edge(_entry_nodes[proc], IntraEdge));
+
+        _backward_graph.start_nodes[proc].push_back(_exit_nodes[proc]);
+    }
+
+    _backward_graph.end_nodes = _entry_nodes;
+    add_summary_edges(_backward_graph);
+}
+
+/*
+ * A procedure can return if its end node is reachable from its start
+ * nodes through intraprocedural edges and the summary edges of the
+ * procedures it calls. This is iterated until no more procedures are
+ * found to return, and the summary edges of the call sites to all
+ * returning procedures are then added to the graph.
+ */
+void NextBipGraph::add_summary_edges(DirectedGraph& directed_graph) {
+    Graph& graph = directed_graph.edges;
+    const std::map<int, CallSite>& call_sites = directed_graph.call_sites;
+    const std::vector< std::vector<int> >& start_nodes =
+        directed_graph.start_nodes;
+    const std::vector<int>& end_nodes = directed_graph.end_nodes;
+
+    std::vector<bool> returns(_procs.size(), false);
+    bool changed = true;
+
+    while(changed) {
+        changed = false;
+
+        for(size_t proc = 0; proc < _procs.size(); ++proc) {
+            if(returns[proc]) continue;
+
+            std::vector<bool> visited(graph.size(), false);
+            std::vector<int> worklist(start_nodes[proc]);
+
+            for(auto it = worklist.begin(); it != worklist.end(); ++it) {
+                visited[*it] = true;
+            }
+
+            while(!worklist.empty() && !visited[end_nodes[proc]]) {
+                int node = worklist.back();
+                worklist.pop_back();
+
+                std::vector<int> targets;
+                for(auto it = graph[node].begin(); it != graph[node].end(); ++it) {
+                    if(it->type == IntraEdge) targets.push_back(it->target);
+                }
+
+                auto call_site = call_sites.find(node);
+                if(call_site != call_sites.end() &&
+                   returns[call_site->second.proc])
+                {
+                    targets.push_back(call_site->second.target);
+                }
+
+                for(auto it = targets.begin(); it != targets.end(); ++it) {
+                    if(visited[*it]) continue;
+
+                    visited[*it] = true;
+                    worklist.push_back(*it);
+                }
+            }
+
+            if(visited[end_nodes[proc]]) {
+                returns[proc] = true;
+                changed = true;
+            }
+        }
+    }
+
+    for(auto it = call_sites.begin(); it != call_sites.end(); ++it) {
+        if(returns[it->second.proc]) {
+            graph[it->first].push_back(Edge(it->second.target, SummaryEdge));
+        }
+    }
+}
+
+StatementSet NextBipGraph::solve_next(StatementAst *statement) {
+    int node = get_node(statement);
+    if(node == -1) return StatementSet();
+
+    return solve_direct(_forward_graph.edges, node);
+}
+
+StatementSet NextBipGraph::solve_prev(StatementAst *statement) {
+    int node = get_node(statement);
+    if(node == -1) return StatementSet();
+
+    return solve_direct(_backward_graph.edges, node);
+}
+
+StatementSet NextBipGraph::solve_inext(StatementAst *statement) {
+    int node = get_node(statement);
+    if(node == -1) return StatementSet();
+
+    return solve_reachable(_forward_graph.edges, node);
+}
+
+StatementSet NextBipGraph::solve_iprev(StatementAst *statement) {
+    int node = get_node(statement);
+    if(node == -1) return StatementSet();
+
+    return solve_reachable(_backward_graph.edges, node);
+}
+
+/*
+ * The direct successors of a statement are the statements reachable
+ * without passing through another statement. Summary edges are skipped,
+ * as a call statement is directly followed by the called procedure.
+ */
+StatementSet NextBipGraph::solve_direct(const Graph& graph, int start) {
+    StatementSet result;
+    std::vector<bool> visited(graph.size(), false);
+    std::vector<int> worklist(1, start);
+
+    while(!worklist.empty()) {
+        int node = worklist.back();
+        worklist.pop_back();
+
+        for(auto it = graph[node].begin(); it != graph[node].end(); ++it) {
+            if(it->type == SummaryEdge) continue;
+
+            if(_nodes[it->target] != NULL) {
+                result.insert(_nodes[it->target]);
+            } else if(!visited[it->target]) {
+                visited[it->target] = true;
+                worklist.push_back(it->target);
+            }
+        }
+    }
+
+    return result;
+}
+
+StatementSet NextBipGraph::solve_reachable(const Graph& graph, int start) {
+    StatementSet result;
+
+    std::vector<bool> outer_visited(graph.size(), false);
+    std::vector<bool> inner_visited(graph.size(), false);
+    std::vector<int> outer_worklist(1, start);
+    std::vector<int> inner_worklist;
+
+    outer_visited[start] = true;
+
+    while(!outer_worklist.empty()) {
+        int node = outer_worklist.back();
+        outer_worklist.pop_back();
+
+        for(auto it = graph[node].begin(); it != graph[node].end(); ++it) {
+            if(_nodes[it->target] != NULL) result.insert(_nodes[it->target]);
+
+            if(it->type == CallEdge) {
+                if(inner_visited[it->target]) continue;
+
+                inner_visited[it->target] = true;
+                inner_worklist.push_back(it->target);
+
+            } else if(!outer_visited[it->target]) {
+                outer_visited[it->target] = true;
+                outer_worklist.push_back(it->target);
+            }
+        }
+    }
+
+    while(!inner_worklist.empty()) {
+        int node = inner_worklist.back();
+        inner_worklist.pop_back();
+
+        for(auto it = graph[node].begin(); it != graph[node].end(); ++it) {
+            if(it->type == ReturnEdge) continue;
+            if(_nodes[it->target] != NULL) result.insert(_nodes[it->target]);
+
+            if(!inner_visited[it->target]) {
+                inner_visited[it->target] = true;
+                inner_worklist.push_back(it->target);
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace impl
+} // namespace simple
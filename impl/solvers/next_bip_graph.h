@@ -0,0 +1,167 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include <memory>
+#include "simple/ast.h"
+#include "simple/solver.h"
+#include "simple/next.h"
+#include "simple/util/relation_index.h"
+
+namespace simple {
+namespace impl {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * NextBipGraph is the interprocedural control flow graph of a program,
+ * built once from the intraprocedural Next relation and the call graph.
+ *
+ * Each statement is a node with a dense ID. Each procedure has an extra
+ * exit node and each call statement an extra return node. Call edges
+ * enter the called procedure, return edges leave a procedure for every
+ * calling statement, and summary edges go from a call statement straight
+ * to its return node when the called procedure can return.
+ *
+ * The backward graph is the transpose of the forward graph, with an
+ * entry node per procedure between its first statement and the calling
+ * statements. Going backward, a procedure is entered at its exit node
+ * from the return node of a call, and left at its entry node.
+ *
+ * NextBip* is then computed as reachability in two phases. The first
+ * phase follows every edge but call edges, which are the returns to any
+ * caller allowed with an empty call stack. The second phase starts from
+ * the called procedures and follows every edge but return edges. Neither
+ * phase tracks the call stack.
+ */
+class NextBipGraph {
+  public:
+    NextBipGraph(SimpleRoot ast,
+        std::shared_ptr<NextQuerySolver> next_solver,
+        std::shared_ptr<CallsQuerySolver> calls_solver);
+
+    /*
+     * NextBip and its reverse, starting with an empty call stack.
+     */
+    StatementSet solve_next(StatementAst *statement);
+    StatementSet solve_prev(StatementAst *statement);
+
+    /*
+     * NextBip* and its reverse.
+     */
+    StatementSet solve_inext(StatementAst *statement);
+    StatementSet solve_iprev(StatementAst *statement);
+
+    enum EdgeType {
+        IntraEdge,
+        CallEdge,
+        ReturnEdge,
+        SummaryEdge
+    };
+
+    struct Edge {
+        Edge(int target, EdgeType type) : target(target), type(type) { }
+
+        int         target;
+        EdgeType    type;
+    };
+
+    typedef std::vector< std::vector<Edge> > Graph;
+
+    /*
+     * A call site is a node with call edges into a procedure. Its summary
+     * edge goes to the target node if the procedure can return.
+     */
+    struct CallSite {
+        CallSite(int node, int proc, int target) : 
+            node(node), proc(proc), target(target) 
+        { }
+
+        int node;
+        int proc;
+        int target;
+    };
+
+    /*
+     * One direction of the graph. A procedure is entered at its start
+     * nodes and left at its end node, which are its first statement and
+     * exit node going forward, and its exit node and entry node going
+     * backward. Call sites are indexed by their node, which is the call
+     * statement going forward and its return node going backward.
+     */
+    struct DirectedGraph {
+        Graph                               edges;
+        std::vector< std::vector<int> >     start_nodes;
+        std::vector<int>                    end_nodes;
+        std::map<int, CallSite>             call_sites;
+    };
+
+    const DirectedGraph& get_forward_graph() const;
+    const DirectedGraph& get_backward_graph() const;
+
+    /*
+     * Get the node of a statement, or -1 if it is not in the program.
+     * The statement of a node is NULL if the node is not a statement.
+     */
+    int get_node(StatementAst *statement);
+    StatementAst* get_statement(int node) const;
+
+  private:
+    void index_statement_list(StatementAst *statement);
+    int add_node(StatementAst *statement);
+
+    void build_forward_graph();
+    void build_backward_graph();
+
+    void add_summary_edges(DirectedGraph& graph);
+
+    StatementSet solve_direct(const Graph& graph, int start);
+    StatementSet solve_reachable(const Graph& graph, int start);
+
+    SimpleRoot _ast;
+    std::shared_ptr<NextQuerySolver>    _next_solver;
+    std::shared_ptr<CallsQuerySolver>   _calls_solver;
+
+    /*
+     * The statement nodes come first, numbered from 0 to the statement
+     * count, followed by the exit and entry nodes.
+     */
+    std::vector<StatementAst*>          _nodes;
+    StatementIndex<int>                 _node_index;
+    size_t                              _statement_count;
+
+    std::vector<ProcAst*>               _procs;
+    HashIndex<ProcAst*, int>            _proc_index;
+
+    /*
+     * The exit node and entry node of each procedure, indexed by the
+     * procedure index.
+     */
+    std::vector<int>        _exit_nodes;
+    std::vector<int>        _entry_nodes;
+
+    DirectedGraph _forward_graph;
+    DirectedGraph _backward_graph;
+};
+
+} // namespace impl
+} // namespace simple
@@ -1,9 +1,24 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
 
 #include "impl/condition.h"
 #include "impl/solvers/next_cached.h"
-#include "simple/util/set_convert.h"
-#include "simple/util/statement_visitor_generator.h"
-#include "simple/types.h"
+#include "simple/util/condition_domain.h"
 
 namespace simple {
 namespace impl {
@@ -11,70 +26,143 @@ namespace impl {
 using namespace simple;
 using namespace simple::util;
 
-CachedNextSolver::CachedNextSolver(SimpleRoot ast, std::shared_ptr<NextQuerySolver> next_solver) :
-_ast(ast), _next_solver(next_solver)
-{ 
-	for(auto it = _ast.begin(); it != _ast.end(); ++it) {
-		index_proc(*it);
-	}
+CachedNextSolver::CachedNextSolver(SimpleRoot ast) : 
+    _ast(ast), _graph(ast),
+    _next_conditions(_graph.size()), _prev_conditions(_graph.size())
+{ }
+
+const ControlFlowGraph* CachedNextSolver::get_graph() const {
+    return &_graph;
+}
+
+StatementSet CachedNextSolver::to_statement_set(ControlFlowGraph::Slice slice) {
+    StatementSet result;
+    for(const int *it = slice.begin; it != slice.end; ++it) {
+        result.insert(_graph.get_statement(*it));
+    }
+
+    return result;
 }
 
-void CachedNextSolver::index_proc(ProcAst *proc) {
-	index_statement_list(proc->get_statement());
+const ConditionSet& CachedNextSolver::to_condition_set(
+    ControlFlowGraph::Slice slice, ConditionSet& cached)
+{
+    if(cached.is_empty()) {
+        for(const int *it = slice.begin; it != slice.end; ++it) {
+            cached.insert(new SimpleStatementCondition(
+                _graph.get_statement(*it)));
+        }
+    }
+
+    return cached;
 }
 
-void CachedNextSolver::index_statement_list(StatementAst *statement) {
-	while(statement != NULL) {
-		index_statement(statement);
-		statement = statement->next();
-	}
+StatementSet CachedNextSolver::solve_next_statement(StatementAst *statement) {
+    int id = _graph.get_id(statement);
+    if(id == -1) return StatementSet();
+
+    return to_statement_set(_graph.get_next(id));
 }
 
-void CachedNextSolver::index_statement(StatementAst *statement) {
-	StatementSet next_result = _next_solver->solve_next_statement(statement);
-	StatementSet prev_result = _next_solver->solve_prev_statement(statement);
-// index result both ways
-	_next_statement_index[statement] = next_result;
-	_prev_statement_index[statement] = prev_result;
-
-	StatementType type = get_statement_type(statement);
-
-	if (type == IfST) {
-		IfAst *ifast = statement_cast<IfAst>(statement);
-		index_statement_list(ifast->get_then_branch());
-		index_statement_list(ifast->get_else_branch());
-	}
-	else if (type == WhileST){
-		WhileAst *whileast = statement_cast<WhileAst>(statement);
-		index_statement_list(whileast->get_body());
-	}
-}   
-
-bool CachedNextSolver::validate(StatementAst *statement1, StatementAst *statement2){
-	StatementSet next_result = _next_statement_index[statement1];
-
-	if (next_result.count(statement2)>0)
-	{
-		return true;
-	}else{
-		return false;
-	}
+StatementSet CachedNextSolver::solve_prev_statement(StatementAst *statement) {
+    int id = _graph.get_id(statement);
+    if(id == -1) return StatementSet();
+
+    return to_statement_set(_graph.get_prev(id));
 }
 
 template <>
-ConditionSet CachedNextSolver::solve_right<StatementAst>(StatementAst *ast) {
-	StatementSet statements = _next_statement_index[ast];
-	return statement_set_to_condition_set(statements);
+ConditionSet CachedNextSolver::solve_right<StatementAst>(StatementAst *statement) {
+    int id = _graph.get_id(statement);
+    if(id == -1) return ConditionSet();
+
+    return to_condition_set(_graph.get_next(id), _next_conditions[id]);
 }
 
 template <>
-ConditionSet CachedNextSolver::solve_left<StatementAst>(StatementAst *ast) {
-	StatementSet statements = _prev_statement_index[ast];
-	return statement_set_to_condition_set(_prev_statement_index[ast]);
+ConditionSet CachedNextSolver::solve_left<StatementAst>(StatementAst *statement) {
+    int id = _graph.get_id(statement);
+    if(id == -1) return ConditionSet();
+
+    return to_condition_set(_graph.get_prev(id), _prev_conditions[id]);
 }
+
+template <>
+bool CachedNextSolver::validate<StatementAst, StatementAst>(
+        StatementAst *statement1, StatementAst *statement2)
+{
+    int from = _graph.get_id(statement1);
+    int to = _graph.get_id(statement2);
+
+    return from != -1 && to != -1 && _graph.is_next(from, to);
 }
+
+template <>
+bool CachedNextSolver::has_right<StatementAst>(StatementAst *statement) {
+    int id = _graph.get_id(statement);
+    return id != -1 && !_graph.get_next(id).empty();
+}
+
+template <>
+bool CachedNextSolver::has_left<StatementAst>(StatementAst *statement) {
+    int id = _graph.get_id(statement);
+    return id != -1 && !_graph.get_prev(id).empty();
 }
 
+bool CachedNextSolver::is_nonempty(const ConditionSet& universe) {
+    return _graph.has_edges();
+}
 
+/*
+ * Each statement in the batch reads its row of the control flow graph
+ * directly, and the domain is indexed once for the whole batch, so no
+ * condition set is built per statement.
+ */
+std::set<ConditionPair> CachedNextSolver::solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+{
+    std::set<ConditionPair> result;
+    StatementDomain domain = make_statement_domain(right_domain);
+
+    for(auto it = lefts.begin(); it != lefts.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+        if(condition == NULL) continue;
+
+        int id = _graph.get_id(condition->get_statement_ast());
+        if(id == -1) continue;
+
+        ControlFlowGraph::Slice next = _graph.get_next(id);
+        for(const int *next_id = next.begin; next_id != next.end; ++next_id) {
+            insert_right_pair(result, *it, domain, 
+                _graph.get_statement(*next_id));
+        }
+    }
+
+    return result;
+}
 
+std::set<ConditionPair> CachedNextSolver::solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain)
+{
+    std::set<ConditionPair> result;
+    StatementDomain domain = make_statement_domain(left_domain);
+
+    for(auto it = rights.begin(); it != rights.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+        if(condition == NULL) continue;
+
+        int id = _graph.get_id(condition->get_statement_ast());
+        if(id == -1) continue;
+
+        ControlFlowGraph::Slice prev = _graph.get_prev(id);
+        for(const int *prev_id = prev.begin; prev_id != prev.end; ++prev_id) {
+            insert_left_pair(result, domain, 
+                _graph.get_statement(*prev_id), *it);
+        }
+    }
+
+    return result;
+}
 
+} // namespace impl
+} // namespace simple
@@ -1,64 +1,129 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
 
 #pragma once
 
-#include <map>
-#include <set>
+#include <vector>
 #include <memory>
 #include "simple/ast.h"
 #include "simple/condition.h"
 #include "simple/condition_set.h"
 #include "simple/solver.h"
-#include "simple/util/ast_utils.h"
+#include "simple/next.h"
+#include "simple/util/solver_generator.h"
+#include "impl/solvers/control_flow_graph.h"
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
-
-class CachedNextSolver : public NextQuerySolver {
+using namespace simple::util;
+
+/*
+ * CachedNextSolver answers Next from the control flow graph built when
+ * the program is loaded, so the next and previous statements of a 
+ * statement are a slice lookup. The solvers built on Next share its
+ * graph through get_graph().
+ */
+class CachedNextSolver : public SimpleNextQuerySolver {
   public:
+    CachedNextSolver(SimpleRoot ast);
+
+    template <typename Condition>
+    ConditionSet solve_right(Condition *condition) {
+        return ConditionSet();
+    }
+
+    template <typename Condition>
+    ConditionSet solve_left(Condition *condition) {
+        return ConditionSet();
+    }
 
-    CachedNextSolver(SimpleRoot ast, std::shared_ptr<NextQuerySolver> next_solver);
+    template <typename Condition1, typename Condition2>
+    bool validate(Condition1 *condition1, Condition2 *condition2) {
+        return false;
+    }
 
     template <typename Condition>
-    ConditionSet solve_right(StatementAst *ast);
+    bool has_right(Condition *condition) {
+        return false;
+    }
 
     template <typename Condition>
-    ConditionSet solve_left(StatementAst *ast);
+    bool has_left(Condition *condition) {
+        return false;
+    }
+
+    bool is_nonempty(const ConditionSet& universe);
 
-    void index_proc(ProcAst *proc);
+    std::set<ConditionPair> solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain);
 
-    void index_statement_list(StatementAst *statement);
+    std::set<ConditionPair> solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain);
 
-    void index_statement(StatementAst *statement);
+    StatementSet solve_next_statement(StatementAst *statement);
+    StatementSet solve_prev_statement(StatementAst *statement);
+
+    const ControlFlowGraph* get_graph() const;
 
-    bool validate(StatementAst *statement1, StatementAst *statement2);
-    
   private:
-    std::map< StatementAst*, StatementSet > _next_statement_index;
-    std::map< StatementAst*, StatementSet > _prev_statement_index;
+    StatementSet to_statement_set(ControlFlowGraph::Slice slice);
+
+    /*
+     * The condition set of a slice, built the first time it is asked
+     * for and shared with every copy handed out afterwards.
+     */
+    const ConditionSet& to_condition_set(ControlFlowGraph::Slice slice,
+        ConditionSet& cached);
 
-    SimpleRoot _ast; 
-    std::shared_ptr<NextQuerySolver> _next_solver;
+    SimpleRoot _ast;
+    ControlFlowGraph _graph;
+
+    std::vector<ConditionSet> _next_conditions;
+    std::vector<ConditionSet> _prev_conditions;
 };
 
-template <typename Condition>
-ConditionSet CachedNextSolver::solve_right(StatementAst *ast) {
-    return ConditionSet();
-}
+template <>
+ConditionSet CachedNextSolver::solve_right<StatementAst>(StatementAst *statement);
 
-template <typename Condition>
-ConditionSet CachedNextSolver::solve_left(StatementAst *ast) {
-    return ConditionSet();
-}
+template <>
+ConditionSet CachedNextSolver::solve_left<StatementAst>(StatementAst *statement);
 
 template <>
-ConditionSet CachedNextSolver::solve_right<StatementAst>(StatementAst *ast);
+bool CachedNextSolver::validate<StatementAst, StatementAst>(
+        StatementAst *statement1, StatementAst *statement2);
 
 template <>
-ConditionSet CachedNextSolver::solve_left<StatementAst>(StatementAst *ast);
+bool CachedNextSolver::has_right<StatementAst>(StatementAst *statement);
 
-}
-}
+template <>
+bool CachedNextSolver::has_left<StatementAst>(StatementAst *statement);
 
+template <>
+class SolverExistenceTraits<CachedNextSolver> : 
+    public DirectSolverExistenceTraits<CachedNextSolver> 
+{ };
+
+template <>
+class SolverBatchTraits<CachedNextSolver> : 
+    public DirectSolverBatchTraits<CachedNextSolver> 
+{ };
 
+} // namespace impl
+} // namespace simple
@@ -43,31 +43,31 @@ bool SiblingSolver::validate(
     ConditionPtr left(clone_condition(right_condition));
     ConditionPtr right(clone_condition(left_condition));
 
-    return _sibling_index[left].has_element(right);
+    return _sibling_index.get(left).has_element(right);
 }
 
 ConditionSet SiblingSolver::solve_left(SimpleCondition *right_condition) {
     ConditionPtr right(clone_condition(right_condition));
 
-    return _sibling_index[right];
+    return _sibling_index.get(right);
 }
 
 ConditionSet SiblingSolver::solve_right(SimpleCondition *left_condition) {
     ConditionPtr left(clone_condition(left_condition));
 
-    return _sibling_index[left];
+    return _sibling_index.get(left);
 }
 
 void SiblingSolver::index_siblings(
     ConditionPtr condition1, ConditionPtr condition2) 
 {
-    _sibling_index[condition1].insert(condition2);
-    _sibling_index[condition2].insert(condition1);
+    _sibling_index.insert(condition1).insert(condition2);
+    _sibling_index.insert(condition2).insert(condition1);
 }
 
 void SiblingSolver::index_proc(ProcAst *proc) {
     ConditionPtr condition(new SimpleProcCondition(proc));
-    ConditionSet& siblings = _sibling_index[condition];
+    ConditionSet& siblings = _sibling_index.insert(condition);
 
     for (auto it = _ast.begin(); it!= _ast.end(); ++it) {
         ProcAst *sibling_proc = *it;
@@ -88,7 +88,7 @@ void SiblingSolver::index_statement_list(StatementAst *statement_list) {
         index_statement(current_statement);
 
         ConditionPtr condition(new SimpleStatementCondition(current_statement));
-        ConditionSet& siblings = _sibling_index[condition];
+        ConditionSet& siblings = _sibling_index.insert(condition);
 
         StatementAst *sibling_statement = statement_list;
 
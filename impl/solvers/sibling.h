@@ -22,12 +22,14 @@
 #include "simple/condition.h"
 #include "simple/solver.h"
 #include "impl/condition.h"
+#include "simple/util/relation_index.h"
 #include <list>
 
 namespace simple {
 namespace impl {
 
 using namespace simple;
+using namespace simple::util;
 
 class SiblingSolver : public QuerySolver {
 public:
@@ -55,7 +57,7 @@ public:
   private:
     SimpleRoot _ast;
 
-    std::map<ConditionPtr, ConditionSet> _sibling_index;
+    HashIndex<ConditionPtr, ConditionSet> _sibling_index;
 };
 
 } // namespace impl
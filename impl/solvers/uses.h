@@ -34,5 +34,15 @@ class UsesSolver : public AssignmentSolver {
     VariableSet get_vars_used_by_proc(ProcAst *proc);
 };
 
+template <>
+class SolverExistenceTraits<UsesSolver> : 
+    public DirectSolverExistenceTraits<UsesSolver> 
+{ };
+
+template <>
+class SolverBatchTraits<UsesSolver> : 
+    public DirectSolverBatchTraits<UsesSolver> 
+{ };
+
 } // namespace impl
 } // namespace simple
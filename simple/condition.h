@@ -24,14 +24,42 @@ namespace simple {
 
 class ConditionVisitor;
 
+/*
+ * The type tag of a condition. Each condition interface sets its tag on
+ * construction, so the type of a condition can be read directly without
+ * going through a condition visitor.
+ */
+enum ConditionType {
+    StatementCT,
+    ProcCT,
+    VariableCT,
+    PatternCT,
+    ConstantCT,
+    OperatorCT,
+    ConditionTypeCount  /* number of condition types */
+};
+
 class SimpleCondition {
   public:
+    SimpleCondition(ConditionType condition_type) : 
+        _condition_type(condition_type) 
+    { }
+
+    ConditionType get_condition_type() const {
+        return _condition_type;
+    }
+
     virtual void accept_condition_visitor(ConditionVisitor *visitor) = 0;
     virtual ~SimpleCondition() { }
+
+  private:
+    ConditionType _condition_type;
 };
 
 class StatementCondition : public SimpleCondition {
   public:
+    StatementCondition() : SimpleCondition(StatementCT) { }
+
     virtual StatementAst* get_statement_ast() = 0;
 
     virtual ~StatementCondition() { }
@@ -39,6 +67,8 @@ class StatementCondition : public SimpleCondition {
 
 class ProcCondition : public SimpleCondition {
   public:
+    ProcCondition() : SimpleCondition(ProcCT) { }
+
     virtual ProcAst* get_proc_ast() = 0;
 
     virtual ~ProcCondition() { }
@@ -46,6 +76,8 @@ class ProcCondition : public SimpleCondition {
 
 class VariableCondition : public SimpleCondition {
   public:
+    VariableCondition() : SimpleCondition(VariableCT) { }
+
     virtual SimpleVariable* get_variable() = 0;
     
     virtual ~VariableCondition() { }
@@ -53,6 +85,8 @@ class VariableCondition : public SimpleCondition {
 
 class ConstantCondition : public SimpleCondition {
   public:
+    ConstantCondition() : SimpleCondition(ConstantCT) { }
+
     virtual SimpleConstant* get_constant() = 0;
 
     virtual ~ConstantCondition() { }
@@ -60,6 +94,8 @@ class ConstantCondition : public SimpleCondition {
 
 class PatternCondition : public SimpleCondition {
   public:
+    PatternCondition() : SimpleCondition(PatternCT) { }
+
     virtual ExprAst* get_expr_ast() = 0;
 
     virtual ~PatternCondition() { }
@@ -67,6 +103,8 @@ class PatternCondition : public SimpleCondition {
 
 class OperatorCondition : public SimpleCondition {
   public:
+    OperatorCondition() : SimpleCondition(OperatorCT) { }
+
     virtual char get_operator() = 0;
 
     virtual ~OperatorCondition() { }
@@ -54,62 +54,118 @@ ConditionSet::ConditionSet(ConditionPtr condition) :
 }
 
 ConditionSet::ConditionSet(std::set<ConditionPtr>&& set) :
-    _set(std::forward< std::set<ConditionPtr> >(set))
-{ }
+    _set()
+{ 
+    if(!set.empty()) {
+        _set = std::make_shared<Storage>(std::forward<Storage>(set));
+    }
+}
+
+const ConditionSet::Storage& ConditionSet::get_storage() const {
+    static const Storage empty_storage;
+
+    return _set ? *_set : empty_storage;
+}
+
+ConditionSet::Storage& ConditionSet::get_mutable_storage() {
+    if(!_set) {
+        _set = std::make_shared<Storage>();
+    } else if(_set.use_count() > 1) {
+        _set = std::make_shared<Storage>(*_set);
+    }
+
+    return *_set;
+}
 
 void ConditionSet::insert(ConditionPtr condition) {
-    _set.insert(condition);
+    get_mutable_storage().insert(condition);
 }
 
 void ConditionSet::insert(SimpleCondition *condition) {
-    _set.insert(ConditionPtr(condition));
+    get_mutable_storage().insert(ConditionPtr(condition));
 }
 
 void ConditionSet::remove(ConditionPtr condition) {
-    _set.erase(condition);
+    if(!has_element(condition)) return;
+
+    get_mutable_storage().erase(condition);
 }
 
 void ConditionSet::union_with(const ConditionSet& other) {
-    union_set(_set, other._set);
+    if(other.is_empty() || _set == other._set) return;
+
+    if(is_empty()) {
+        _set = other._set;
+        return;
+    }
+
+    union_set(get_mutable_storage(), other.get_storage());
 }
 
 void ConditionSet::intersect_with(const ConditionSet& other) {
     if(other.is_empty()) {
         // we are intersecting with empty set, and so
         // the result is also an empty set.
-        _set.clear();
+        _set.reset();
         return; 
     }
 
-    std::set<ConditionPtr>::iterator it = _set.begin();
-    while(it != _set.end()) {
-        if(!other.has_element(*it)) {
-            std::set<ConditionPtr>::iterator old_it = it++;
-            _set.erase(old_it);
-        } else {
-            ++it;
+    if(_set == other._set) return;
+
+    /*
+     * Only copy shared storage if a condition is actually dropped.
+     */
+    const Storage& storage = get_storage();
+    Storage::const_iterator first_dropped = storage.begin();
+
+    while(first_dropped != storage.end() && other.has_element(*first_dropped)) {
+        ++first_dropped;
+    }
+
+    if(first_dropped == storage.end()) return;
+
+    if(_set.use_count() == 1) {
+        Storage::iterator it = _set->erase(first_dropped);
+        while(it != _set->end()) {
+            if(!other.has_element(*it)) {
+                it = _set->erase(it);
+            } else {
+                ++it;
+            }
         }
+        return;
+    }
+
+    Storage result(storage.begin(), first_dropped);
+
+    for(Storage::const_iterator it = first_dropped; it != storage.end(); ++it) {
+        if(other.has_element(*it)) result.insert(result.end(), *it);
     }
+
+    *this = ConditionSet(std::move(result));
 }
 
 ConditionSet ConditionSet::difference_with(const ConditionSet& other) {
-    return ConditionSet(difference_set(_set, other._set));
+    if(other.is_empty()) return *this;
+    if(_set == other._set) return ConditionSet();
+
+    return ConditionSet(difference_set(get_storage(), other.get_storage()));
 }
 
 void ConditionSet::clear() {
-    _set.clear();
+    _set.reset();
 }
 
 bool ConditionSet::is_empty() const {
-    return _set.empty();
+    return !_set || _set->empty();
 }
 
 bool ConditionSet::equals(const ConditionSet& other) const {
-    return _set == other._set;
+    return _set == other._set || get_storage() == other.get_storage();
 }
 
 bool ConditionSet::equals(const std::set<ConditionPtr>& other) const {
-    return _set == other;
+    return get_storage() == other;
 }
 
 bool ConditionSet::operator ==(const ConditionSet& other) const {
@@ -125,20 +181,25 @@ ConditionSet& ConditionSet::operator =(const ConditionSet& other) {
     return *this;
 }
 
+ConditionSet& ConditionSet::operator =(ConditionSet&& other) {
+    _set = std::move(other._set);
+    return *this;
+}
+
 bool ConditionSet::has_element(const ConditionPtr& other) const {
-    return _set.count(other) != 0;
+    return _set && _set->count(other) != 0;
 }
 
 size_t ConditionSet::get_size() const {
-    return _set.size();
+    return _set ? _set->size() : 0;
 }
 
 std::set<ConditionPtr>::const_iterator ConditionSet::begin() const {
-    return _set.begin();
+    return get_storage().begin();
 }
 
 std::set<ConditionPtr>::const_iterator ConditionSet::end() const {
-    return _set.end();
+    return get_storage().end();
 }
 
 ConditionSet::~ConditionSet() { }
@@ -62,6 +62,12 @@ class ConditionPtr {
     std::shared_ptr<SimpleCondition> _ptr;
 };
 
+/*
+ * ConditionSet shares its storage between copies, so that solvers can 
+ * hand out the sets in their caches without copying them. The storage
+ * is immutable while it is shared, and a set copies it the first time
+ * it is changed. An empty set has no storage.
+ */
 class ConditionSet {
   public:
     typedef std::set<ConditionPtr>::const_iterator  iterator;
@@ -91,13 +97,24 @@ class ConditionSet {
 
     ConditionSet& operator =(const ConditionSet& other);
 
+    ConditionSet& operator =(ConditionSet&& other);
+
     iterator begin() const;
     iterator end() const;
 
     ~ConditionSet();
 
   private:
-    std::set<ConditionPtr> _set;
+    typedef std::set<ConditionPtr> Storage;
+
+    const Storage& get_storage() const;
+
+    /*
+     * The storage for a change, copied first if it is shared.
+     */
+    Storage& get_mutable_storage();
+
+    std::shared_ptr<Storage> _set;
 };
 
 typedef std::pair<ConditionPtr, ConditionPtr> ConditionPair;
@@ -21,6 +21,7 @@
 #include <vector>
 #include "simple/query.h"
 #include "simple/tuple.h"
+#include "simple/tuple_table.h"
 #include "simple/predicate.h"
 #include "simple/condition_set.h"
 
@@ -118,10 +119,18 @@ class QueryLinker {
      * tuples will follow the defined links, otherwise it will return 
      * all possible permutations between the variables.
      *
-     * The return result is a list of variable-size tuple, with size of
-     * the same as the size of list of variables supplied in the parameter.
+     * The return result is a table of tuples with the arity of the
+     * list of variables supplied in the parameter, sorted and without
+     * duplicates.
      */
-    virtual TupleSet make_tuples(const std::vector<Qvar>&) = 0;
+    virtual TupleTable make_tuple_table(const std::vector<Qvar>&) = 0;
+
+    /**
+     * The tuples of make_tuple_table() as linked list tuples.
+     */
+    TupleSet make_tuples(const std::vector<Qvar>& qvars) {
+        return make_tuple_table(qvars).to_tuple_set();
+    }
 
     /*
      * Indicates whether the qvar links are in a valid state.
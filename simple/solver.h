@@ -26,6 +26,52 @@
 
 namespace simple {
 
+/*
+ * A typed validator is the validate() of a solver already resolved for
+ * one pair of condition types. Calling it skips the type dispatch, so it
+ * must only be called with conditions of the types it was resolved for.
+ */
+class TypedValidator {
+  public:
+    typedef bool (*Function)(void *solver, 
+            SimpleCondition *left_condition, SimpleCondition *right_condition);
+
+    TypedValidator(Function function, void *solver) :
+        _function(function), _solver(solver)
+    { }
+
+    bool validate(SimpleCondition *left_condition, 
+            SimpleCondition *right_condition) const
+    {
+        return _function(_solver, left_condition, right_condition);
+    }
+
+  private:
+    Function    _function;
+    void        *_solver;
+};
+
+/*
+ * A typed existence check is has_left() or has_right() of a solver
+ * resolved for one condition type, in the same way as TypedValidator.
+ */
+class TypedExistenceCheck {
+  public:
+    typedef bool (*Function)(void *solver, SimpleCondition *condition);
+
+    TypedExistenceCheck(Function function, void *solver) :
+        _function(function), _solver(solver)
+    { }
+
+    bool check(SimpleCondition *condition) const {
+        return _function(_solver, condition);
+    }
+
+  private:
+    Function    _function;
+    void        *_solver;
+};
+
 /*
  * QuerySolver is a generic interface for solving a two-clause relation.
  */
@@ -53,7 +99,128 @@ class QuerySolver {
      */
     virtual ConditionSet solve_right(SimpleCondition *left_condition) = 0;
 
+    /*
+     * Solving case S(a, _)
+     * Check whether there is any right condition that satisfies the
+     * relation R(left_condition, _). Solvers that can answer this 
+     * without computing the full right result should override it.
+     */
+    virtual bool has_right(SimpleCondition *left_condition) {
+        return !solve_right(left_condition).is_empty();
+    }
+
+    /*
+     * Solving case S(_, b)
+     * Check whether there is any left condition that satisfies the
+     * relation R(_, right_condition).
+     */
+    virtual bool has_left(SimpleCondition *right_condition) {
+        return !solve_left(right_condition).is_empty();
+    }
+
+    /*
+     * Solving case S(_, _)
+     * Check whether the relation holds for any pair of conditions in the
+     * program. The universe is the set of all conditions in the program.
+     */
+    virtual bool is_nonempty(const ConditionSet& universe) {
+        for(ConditionSet::iterator it = universe.begin();
+            it != universe.end(); ++it)
+        {
+            if(has_left(*it)) return true;
+        }
+
+        return false;
+    }
+
+    /*
+     * Solving case S(A, B) from the left
+     * Solve the pairs R(left, right) for every left condition in lefts,
+     * keeping only right conditions that are in right_domain. Solvers
+     * that can go through their indexes once for the whole batch should 
+     * override it.
+     */
+    virtual std::set<ConditionPair> solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+    {
+        std::set<ConditionPair> result;
+
+        for(ConditionSet::iterator it = lefts.begin(); it != lefts.end(); ++it) {
+            ConditionSet rights = solve_right(*it);
+            rights.intersect_with(right_domain);
+
+            for(ConditionSet::iterator it2 = rights.begin(); 
+                it2 != rights.end(); ++it2) 
+            {
+                result.insert(ConditionPair(*it, *it2));
+            }
+        }
+
+        return result;
+    }
+
+    /*
+     * Solving case S(A, B) from the right
+     * Solve the pairs R(left, right) for every right condition in rights,
+     * keeping only left conditions that are in left_domain.
+     */
+    virtual std::set<ConditionPair> solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain)
+    {
+        std::set<ConditionPair> result;
+
+        for(ConditionSet::iterator it = rights.begin(); it != rights.end(); ++it) {
+            ConditionSet lefts = solve_left(*it);
+            lefts.intersect_with(left_domain);
+
+            for(ConditionSet::iterator it2 = lefts.begin(); 
+                it2 != lefts.end(); ++it2) 
+            {
+                result.insert(ConditionPair(*it2, *it));
+            }
+        }
+
+        return result;
+    }
+
+    /*
+     * Typed fast paths
+     * Resolve validate(), has_right() and has_left() for conditions of
+     * known types, so that a caller checking many conditions of the same
+     * type pays for the type dispatch only once. By default they simply
+     * go through the virtual methods.
+     */
+    virtual TypedValidator get_validator(
+            ConditionType left_type, ConditionType right_type)
+    {
+        return TypedValidator(&QuerySolver::dispatch_validate, this);
+    }
+
+    virtual TypedExistenceCheck get_right_check(ConditionType left_type) {
+        return TypedExistenceCheck(&QuerySolver::dispatch_has_right, this);
+    }
+
+    virtual TypedExistenceCheck get_left_check(ConditionType right_type) {
+        return TypedExistenceCheck(&QuerySolver::dispatch_has_left, this);
+    }
+
    virtual ~QuerySolver() { }
+
+  private:
+    static bool dispatch_validate(void *solver, 
+            SimpleCondition *left_condition, SimpleCondition *right_condition)
+    {
+        return static_cast<QuerySolver*>(solver)->validate(
+                left_condition, right_condition);
+    }
+
+    static bool dispatch_has_right(void *solver, SimpleCondition *condition) {
+        return static_cast<QuerySolver*>(solver)->has_right(condition);
+    }
+
+    static bool dispatch_has_left(void *solver, SimpleCondition *condition) {
+        return static_cast<QuerySolver*>(solver)->has_left(condition);
+    }
 };
 
 /*
@@ -20,6 +20,19 @@ class SimpleProgramAnalyzerImpl : public SimpleProgramAnalyzer {
       _frontend.reset(new SimplePqlFrontEnd(source_begin, source_end));
     }
 
+    bool reload(const std::string& filename) {
+      if(!_frontend) {
+        parse(filename);
+        return true;
+      }
+
+      std::ifstream source(filename);
+      std::istreambuf_iterator<char> source_begin(source);
+      std::istreambuf_iterator<char> source_end;
+
+      return _frontend->reload_source(source_begin, source_end);
+    }
+
     std::vector<std::string> evaluate(const std::string& query) {
       return _frontend->process_query(query.begin(), query.end());
     }
@@ -7,6 +7,12 @@
 class SimpleProgramAnalyzer {
   public:
     virtual void parse(const std::string& filename) = 0;
+
+    /*
+     * Parse a new version of the file given to parse(), analyzing only
+     * what changed. Returns false if the program did not change.
+     */
+    virtual bool reload(const std::string& filename) = 0;
     virtual std::vector<std::string> evaluate(const std::string& query) = 0;
 };
 
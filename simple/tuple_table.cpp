@@ -0,0 +1,148 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include "simple/tuple_table.h"
+
+namespace simple {
+
+TupleTable::TupleTable(size_t arity) : _arity(arity), _size(0) { }
+
+size_t TupleTable::arity() const {
+    return _arity;
+}
+
+size_t TupleTable::size() const {
+    return _size;
+}
+
+bool TupleTable::empty() const {
+    return _size == 0;
+}
+
+const ConditionPtr* TupleTable::row(size_t index) const {
+    return _conditions.data() + index * _arity;
+}
+
+void TupleTable::reserve(size_t rows) {
+    _conditions.reserve(rows * _arity);
+}
+
+void TupleTable::add_row(const ConditionPtr *conditions) {
+    for(size_t i = 0; i < _arity; ++i) {
+        _conditions.push_back(conditions[i]);
+    }
+
+    ++_size;
+}
+
+void TupleTable::add_row(const ConditionPtr& first, const ConditionPtr *rest) {
+    _conditions.push_back(first);
+
+    for(size_t i = 1; i < _arity; ++i) {
+        _conditions.push_back(rest[i - 1]);
+    }
+
+    ++_size;
+}
+
+void TupleTable::add_joined_row(const std::vector<const TupleTable*>& tables,
+    const std::vector<size_t>& rows,
+    const std::vector< std::pair<size_t, size_t> >& columns)
+{
+    for(size_t i = 0; i < _arity; ++i) {
+        size_t table = columns[i].first;
+        _conditions.push_back(tables[table]->row(rows[table])[columns[i].second]);
+    }
+
+    ++_size;
+}
+
+bool TupleTable::less_row(size_t row1, size_t row2) const {
+    const ConditionPtr *conditions1 = row(row1);
+    const ConditionPtr *conditions2 = row(row2);
+
+    for(size_t i = 0; i < _arity; ++i) {
+        if(conditions1[i] < conditions2[i]) return true;
+        if(conditions2[i] < conditions1[i]) return false;
+    }
+
+    return false;
+}
+
+bool TupleTable::equal_row(size_t row1, size_t row2) const {
+    const ConditionPtr *conditions1 = row(row1);
+    const ConditionPtr *conditions2 = row(row2);
+
+    for(size_t i = 0; i < _arity; ++i) {
+        if(conditions1[i] != conditions2[i]) return false;
+    }
+
+    return true;
+}
+
+/*
+ * The row indexes are sorted, each row equal to the one before it is
+ * dropped, and the rows left are then moved into a new array in order.
+ */
+void TupleTable::sort_unique() {
+    if(_size < 2 || _arity == 0) return;
+
+    std::vector<size_t> order(_size);
+    for(size_t i = 0; i < _size; ++i) order[i] = i;
+
+    std::sort(order.begin(), order.end(), 
+        [this](size_t row1, size_t row2) { return less_row(row1, row2); });
+
+    order.erase(std::unique(order.begin(), order.end(),
+        [this](size_t row1, size_t row2) { return equal_row(row1, row2); }),
+        order.end());
+
+    std::vector<ConditionPtr> conditions;
+    conditions.reserve(order.size() * _arity);
+
+    for(size_t i = 0; i < order.size(); ++i) {
+        ConditionPtr *begin = &_conditions[order[i] * _arity];
+        for(size_t column = 0; column < _arity; ++column) {
+            conditions.push_back(std::move(begin[column]));
+        }
+    }
+
+    _conditions.swap(conditions);
+    _size = order.size();
+}
+
+TupleSet TupleTable::to_tuple_set() const {
+    TupleSet result;
+
+    for(size_t i = 0; i < _size; ++i) {
+        const ConditionPtr *conditions = row(i);
+
+        ConditionTuplePtr tuple;
+        for(size_t column = _arity; column > 0; --column) {
+            tuple = ConditionTuplePtr(
+                new SimpleConditionTuple(conditions[column - 1], tuple));
+        }
+
+        result.insert(tuple);
+    }
+
+    return result;
+}
+
+} // namespace simple
@@ -0,0 +1,87 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "simple/condition_set.h"
+#include "simple/tuple.h"
+
+namespace simple {
+
+/*
+ * TupleTable is a table of result tuples with a fixed arity. The rows 
+ * are stored one after another in a single array of conditions, so a 
+ * tuple costs no allocation of its own, and the array grows the way a
+ * vector does. Rows are added in any order, and sort_unique() orders 
+ * them and drops duplicates.
+ */
+class TupleTable {
+  public:
+    explicit TupleTable(size_t arity);
+
+    size_t arity() const;
+    size_t size() const;
+    bool empty() const;
+
+    const ConditionPtr* row(size_t index) const;
+
+    void reserve(size_t rows);
+
+    /*
+     * Append a row of arity() conditions copied from an array.
+     */
+    void add_row(const ConditionPtr *conditions);
+
+    /*
+     * Append a row of a condition followed by arity() - 1 conditions
+     * copied from an array.
+     */
+    void add_row(const ConditionPtr& first, const ConditionPtr *rest);
+
+    /*
+     * Append a row made of the conditions of the rows of several tables
+     * picked by the given row indexes. Each column of the new row is a
+     * pair of a table index and a column of that table.
+     */
+    void add_joined_row(const std::vector<const TupleTable*>& tables,
+        const std::vector<size_t>& rows,
+        const std::vector< std::pair<size_t, size_t> >& columns);
+
+    /*
+     * Sort the rows in the order of their conditions and remove the
+     * duplicates.
+     */
+    void sort_unique();
+
+    /*
+     * Convert the rows to linked list tuples.
+     */
+    TupleSet to_tuple_set() const;
+
+  private:
+    bool less_row(size_t row1, size_t row2) const;
+    bool equal_row(size_t row1, size_t row2) const;
+
+    size_t                      _arity;
+    size_t                      _size;
+    std::vector<ConditionPtr>   _conditions;
+};
+
+} // namespace simple
@@ -0,0 +1,135 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace simple {
+namespace util {
+
+/*
+ * BitSet is a set of dense integer IDs in the range [0, size), stored
+ * as one bit per ID. Unions and intersections are done a word at a 
+ * time, and the IDs are enumerated in increasing order with next().
+ */
+class BitSet {
+  public:
+    BitSet() : _size(0) { }
+
+    explicit BitSet(size_t size) : 
+        _size(size), _words((size + WordBits - 1) / WordBits, 0) 
+    { }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool test(size_t id) const {
+        return (_words[id / WordBits] & (Word(1) << (id % WordBits))) != 0;
+    }
+
+    void set(size_t id) {
+        _words[id / WordBits] |= Word(1) << (id % WordBits);
+    }
+
+    /*
+     * Set the IDs in [begin, end), a word at a time.
+     */
+    void set_range(size_t begin, size_t end) {
+        while(begin < end && begin % WordBits != 0) set(begin++);
+
+        for(; begin + WordBits <= end; begin += WordBits) {
+            _words[begin / WordBits] = ~Word(0);
+        }
+
+        while(begin < end) set(begin++);
+    }
+
+    /*
+     * Both sets must have the same size.
+     */
+    void union_with(const BitSet& other) {
+        for(size_t i = 0; i < _words.size(); ++i) {
+            _words[i] |= other._words[i];
+        }
+    }
+
+    /*
+     * Both sets must have the same size.
+     */
+    void intersect_with(const BitSet& other) {
+        for(size_t i = 0; i < _words.size(); ++i) {
+            _words[i] &= other._words[i];
+        }
+    }
+
+    bool empty() const {
+        for(size_t i = 0; i < _words.size(); ++i) {
+            if(_words[i] != 0) return false;
+        }
+
+        return true;
+    }
+
+    size_t count() const {
+        size_t result = 0;
+        for(size_t id = next(0); id < _size; id = next(id + 1)) ++result;
+
+        return result;
+    }
+
+    /*
+     * Get the smallest ID in the set that is not less than id, or size()
+     * if there is none. Empty words are skipped whole.
+     */
+    size_t next(size_t id) const {
+        while(id < _size) {
+            Word word = _words[id / WordBits] >> (id % WordBits);
+
+            if(word == 0) {
+                id = (id / WordBits + 1) * WordBits;
+                continue;
+            }
+
+            while((word & 1) == 0) {
+                word >>= 1;
+                ++id;
+            }
+
+            return id;
+        }
+
+        return _size;
+    }
+
+    bool operator ==(const BitSet& other) const {
+        return _size == other._size && _words == other._words;
+    }
+
+  private:
+    typedef unsigned long long Word;
+    static const size_t WordBits = 64;
+
+    size_t              _size;
+    std::vector<Word>   _words;
+};
+
+} // namespace util
+} // namespace simple
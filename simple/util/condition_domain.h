@@ -0,0 +1,109 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "simple/condition.h"
+#include "simple/condition_set.h"
+#include "simple/util/condition_utils.h"
+#include "simple/util/relation_index.h"
+
+namespace simple {
+namespace util {
+
+using namespace simple;
+
+/*
+ * A condition domain maps the AST node or value behind each condition
+ * in a condition set back to the condition itself. Batch solvers use
+ * it to filter their raw results against a domain in one lookup, and
+ * to reuse the domain's conditions in the result pairs instead of
+ * creating new ones. Statement domains are indexed by statement line,
+ * so building and probing one costs an array access per statement.
+ * A domain points into the condition set it was built from, which has
+ * to outlive it.
+ */
+typedef StatementIndex<const ConditionPtr*>             StatementDomain;
+typedef HashIndex<ProcAst*, const ConditionPtr*>        ProcDomain;
+typedef HashIndex<SimpleVariable, const ConditionPtr*>  VariableDomain;
+
+inline StatementDomain make_statement_domain(const ConditionSet& conditions) {
+    StatementDomain result;
+
+    for(auto it = conditions.begin(); it != conditions.end(); ++it) {
+        StatementCondition *condition = condition_cast<StatementCondition>(*it);
+        if(condition == NULL) continue;
+
+        result.insert(condition->get_statement_ast(), &*it);
+    }
+
+    return result;
+}
+
+inline ProcDomain make_proc_domain(const ConditionSet& conditions) {
+    ProcDomain result;
+
+    for(auto it = conditions.begin(); it != conditions.end(); ++it) {
+        ProcCondition *condition = condition_cast<ProcCondition>(*it);
+        if(condition == NULL) continue;
+
+        result.insert(condition->get_proc_ast(), &*it);
+    }
+
+    return result;
+}
+
+inline VariableDomain make_variable_domain(const ConditionSet& conditions) {
+    VariableDomain result;
+
+    for(auto it = conditions.begin(); it != conditions.end(); ++it) {
+        VariableCondition *condition = condition_cast<VariableCondition>(*it);
+        if(condition == NULL) continue;
+
+        result.insert(*condition->get_variable(), &*it);
+    }
+
+    return result;
+}
+
+/*
+ * Look up a key in a domain and, if found, insert the pair of the given
+ * condition with the domain condition into the result.
+ */
+template <typename Domain, typename Key>
+inline void insert_right_pair(std::set<ConditionPair>& result,
+    const ConditionPtr& left, const Domain& right_domain, const Key& key)
+{
+    const ConditionPtr* const *condition = right_domain.find(key);
+    if(condition != NULL) {
+        result.insert(ConditionPair(left, **condition));
+    }
+}
+
+template <typename Domain, typename Key>
+inline void insert_left_pair(std::set<ConditionPair>& result,
+    const Domain& left_domain, const Key& key, const ConditionPtr& right)
+{
+    const ConditionPtr* const *condition = left_domain.find(key);
+    if(condition != NULL) {
+        result.insert(ConditionPair(**condition, right));
+    }
+}
+
+} // namespace util
+} // namespace simple
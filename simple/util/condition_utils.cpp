@@ -25,42 +25,8 @@
 namespace simple {
 namespace util {
 
-class ConditionTypeVisitor : public ConditionVisitor {
-  public:
-    ConditionTypeVisitor() { }
-
-    void visit_statement_condition(StatementCondition*) {
-        result = StatementCT;
-    }
-
-    void visit_proc_condition(ProcCondition*) {
-        result = ProcCT;
-    }
-
-    void visit_variable_condition(VariableCondition*) {
-        result = VariableCT;
-    }
-
-    void visit_constant_condition(ConstantCondition*) {
-        result = ConstantCT;
-    }
-
-    void visit_pattern_condition(PatternCondition*) {
-        result = PatternCT;
-    }
-
-    void visit_operator_condition(OperatorCondition*) {
-        result = OperatorCT;
-    }
-
-    ConditionType result;
-};
-
 ConditionType get_condition_type(SimpleCondition *condition) {
-    ConditionTypeVisitor visitor;
-
-    condition->accept_condition_visitor(&visitor);
-    return visitor.result;
+    return condition->get_condition_type();
 }
 
 
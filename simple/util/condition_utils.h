@@ -26,15 +26,6 @@
 namespace simple {
 namespace util {
 
-enum ConditionType {
-    StatementCT,
-    ProcCT,
-    VariableCT,
-    PatternCT,
-    ConstantCT,
-    OperatorCT,
-};
-
 ConditionType get_condition_type(SimpleCondition *condition);
 
 std::string condition_to_string(SimpleCondition *condition);
@@ -0,0 +1,208 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iomanip>
+#include "simple/util/memo_cache.h"
+
+namespace simple {
+namespace util {
+
+using namespace simple;
+
+namespace {
+
+/*
+ * The size of a node of a std::set, with its three links and color.
+ */
+template <typename Value>
+size_t set_node_cost() {
+    return sizeof(Value) + 4 * sizeof(void*);
+}
+
+} // namespace
+
+void MemoCacheStats::add(const MemoCacheStats& other) {
+    hits += other.hits;
+    misses += other.misses;
+    evictions += other.evictions;
+    entries += other.entries;
+    bytes += other.bytes;
+}
+
+/*
+ * The global budget starts with a limit of 256MB, which the command 
+ * line tools can change.
+ */
+MemoCacheBudget& MemoCacheBudget::global() {
+    static MemoCacheBudget budget(256 << 20);
+    return budget;
+}
+
+MemoCacheBudget::MemoCacheBudget(size_t limit) : 
+    _limit(limit), _usage(0), _clock(0)
+{ }
+
+void MemoCacheBudget::set_limit(size_t limit) {
+    _limit = limit;
+}
+
+size_t MemoCacheBudget::get_limit() const {
+    return _limit;
+}
+
+size_t MemoCacheBudget::get_usage() const {
+    return _usage;
+}
+
+bool MemoCacheBudget::is_over_limit() const {
+    size_t limit = _limit;
+    return limit != 0 && _usage > limit;
+}
+
+void MemoCacheBudget::allocate(size_t bytes) {
+    _usage += bytes;
+}
+
+void MemoCacheBudget::release(size_t bytes) {
+    _usage -= bytes;
+}
+
+size_t MemoCacheBudget::next_tick() {
+    return _clock++;
+}
+
+void MemoCacheBudget::reclaim(MemoCacheBase *requester) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    while(is_over_limit()) {
+        MemoCacheBase *victim = NULL;
+        size_t oldest = MemoCacheBase::no_tick;
+
+        for(auto it = _caches.begin(); it != _caches.end(); ++it) {
+            MemoCacheBase *cache = *it;
+            size_t tick;
+
+            if(cache == requester) {
+                tick = cache->get_oldest_tick(1);
+            } else if(cache->_mutex.try_lock()) {
+                tick = cache->get_oldest_tick(0);
+                cache->_mutex.unlock();
+            } else {
+                continue;
+            }
+
+            if(tick < oldest) {
+                victim = cache;
+                oldest = tick;
+            }
+        }
+
+        if(victim == NULL) return;
+
+        /*
+         * Another thread may have started using the victim since it was
+         * picked, in which case the caches are looked at again.
+         */
+        if(victim == requester) {
+            victim->evict_oldest();
+        } else if(victim->_mutex.try_lock()) {
+            if(victim->get_oldest_tick(0) == oldest) victim->evict_oldest();
+            victim->_mutex.unlock();
+        }
+    }
+}
+
+void MemoCacheBudget::register_cache(MemoCacheBase *cache) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _caches.insert(cache);
+}
+
+/*
+ * A cache has already released its entries when it unregisters, so 
+ * only its counters are kept.
+ */
+void MemoCacheBudget::unregister_cache(MemoCacheBase *cache) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _caches.erase(cache);
+    _retired[cache->get_name()].add(cache->get_stats());
+}
+
+std::map<std::string, MemoCacheStats> MemoCacheBudget::collect_stats() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::map<std::string, MemoCacheStats> result = _retired;
+    for(auto it = _caches.begin(); it != _caches.end(); ++it) {
+        result[(*it)->get_name()].add((*it)->get_stats());
+    }
+
+    return result;
+}
+
+void MemoCacheBudget::print_stats(std::ostream& out) {
+    std::map<std::string, MemoCacheStats> stats = collect_stats();
+
+    out << "cache usage " << get_usage() << " bytes, limit " 
+        << get_limit() << " bytes" << std::endl;
+
+    for(auto it = stats.begin(); it != stats.end(); ++it) {
+        const MemoCacheStats& cache = it->second;
+        size_t lookups = cache.hits + cache.misses;
+
+        out << "  " << std::left << std::setw(22) << it->first << std::right
+            << " hits=" << cache.hits
+            << " misses=" << cache.misses
+            << " hit_rate=" << (lookups == 0 ? 0 : cache.hits * 100 / lookups) << "%"
+            << " evictions=" << cache.evictions
+            << " entries=" << cache.entries
+            << " bytes=" << cache.bytes << std::endl;
+    }
+}
+
+MemoCacheBase::MemoCacheBase(const std::string& name, MemoCacheBudget& budget) :
+    _budget(budget), _name(name)
+{
+    _budget.register_cache(this);
+}
+
+MemoCacheBase::~MemoCacheBase() { }
+
+const std::string& MemoCacheBase::get_name() const {
+    return _name;
+}
+
+const MemoCacheStats& MemoCacheBase::get_stats() const {
+    return _stats;
+}
+
+size_t memo_cost(const StatementSet& statements) {
+    return statements.size() * set_node_cost<StatementAst*>();
+}
+
+/*
+ * Each condition is counted with its own storage, even though the
+ * conditions and the set itself may be shared with other sets.
+ */
+size_t memo_cost(const ConditionSet& conditions) {
+    return conditions.get_size() * 
+        (set_node_cost<ConditionPtr>() + sizeof(StatementCondition) + 
+         4 * sizeof(void*));
+}
+
+} // namespace util
+} // namespace simple
@@ -0,0 +1,272 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <ostream>
+#include <memory>
+#include <utility>
+#include <unordered_map>
+#include "simple/condition_set.h"
+#include "simple/util/relation_index.h"
+
+namespace simple {
+namespace util {
+
+using namespace simple;
+
+struct MemoCacheStats {
+    MemoCacheStats() : 
+        hits(0), misses(0), evictions(0), entries(0), bytes(0)
+    { }
+
+    void add(const MemoCacheStats& other);
+
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;
+};
+
+class MemoCacheBase;
+
+/*
+ * MemoCacheBudget is the memory budget shared by every memo cache in
+ * the process. Each cache charges the estimated size of its entries to
+ * the budget. Every use of an entry is stamped from a clock shared by
+ * all caches, so while the budget is over its limit it evicts the least
+ * recently used entry of all caches, whichever cache holds it. A limit
+ * of zero means no limit.
+ *
+ * The stats of the live caches are read without locking them, so they 
+ * should only be collected while no query is running.
+ */
+class MemoCacheBudget {
+  public:
+    static MemoCacheBudget& global();
+
+    MemoCacheBudget(size_t limit = 0);
+
+    void set_limit(size_t limit);
+    size_t get_limit() const;
+    size_t get_usage() const;
+    bool is_over_limit() const;
+
+    void allocate(size_t bytes);
+    void release(size_t bytes);
+
+    /*
+     * The next stamp of the shared recency clock.
+     */
+    size_t next_tick();
+
+    /*
+     * Evict the least recently used entries of all caches until the 
+     * budget is back under its limit, keeping the entry the requesting
+     * cache just inserted. The requesting cache is locked by the caller.
+     * A cache that is in use by another thread is skipped rather than
+     * waited for.
+     */
+    void reclaim(MemoCacheBase *requester);
+
+    void register_cache(MemoCacheBase *cache);
+    void unregister_cache(MemoCacheBase *cache);
+
+    /*
+     * The stats of every cache by name, including the caches that were
+     * already destroyed.
+     */
+    std::map<std::string, MemoCacheStats> collect_stats();
+    void print_stats(std::ostream& out);
+
+  private:
+    std::atomic<size_t>     _limit;
+    std::atomic<size_t>     _usage;
+    std::atomic<size_t>     _clock;
+
+    std::mutex                              _mutex;
+    std::set<MemoCacheBase*>                _caches;
+    std::map<std::string, MemoCacheStats>   _retired;
+};
+
+/*
+ * A cache registers itself with its budget on construction. The derived
+ * cache has to unregister itself in its own destructor, while the 
+ * budget can still evict from it.
+ */
+class MemoCacheBase {
+  public:
+    MemoCacheBase(const std::string& name, MemoCacheBudget& budget);
+    virtual ~MemoCacheBase();
+
+    const std::string& get_name() const;
+    const MemoCacheStats& get_stats() const;
+
+  protected:
+    friend class MemoCacheBudget;
+
+    static const size_t no_tick = (size_t) -1;
+
+    /*
+     * The stamp of the least recently used entry, or no_tick if the 
+     * cache holds no more than keep entries. Called with the cache 
+     * locked.
+     */
+    virtual size_t get_oldest_tick(size_t keep) const = 0;
+    virtual void evict_oldest() = 0;
+
+    MemoCacheBudget&    _budget;
+    MemoCacheStats      _stats;
+    std::mutex          _mutex;
+
+  private:
+    MemoCacheBase(const MemoCacheBase&);
+    MemoCacheBase& operator =(const MemoCacheBase&);
+
+    std::string         _name;
+};
+
+/*
+ * The estimated heap size of a cached value.
+ */
+size_t memo_cost(const StatementSet& statements);
+size_t memo_cost(const ConditionSet& conditions);
+
+/*
+ * MemoCache memoizes the results of a solver by key, with the entries
+ * kept in least recently used order. Since the budget may evict an 
+ * entry on behalf of another cache at any time, find() hands out 
+ * shared ownership of the value instead of a pointer into the cache.
+ */
+template <typename Key, typename Value>
+class MemoCache : public MemoCacheBase {
+  public:
+    MemoCache(const std::string& name, 
+        MemoCacheBudget& budget = MemoCacheBudget::global()) :
+        MemoCacheBase(name, budget)
+    { }
+
+    std::shared_ptr<const Value> find(const Key& key) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _index.find(key);
+
+        if(it == _index.end()) {
+            ++_stats.misses;
+            return std::shared_ptr<const Value>();
+        }
+
+        ++_stats.hits;
+        it->second->tick = _budget.next_tick();
+        _entries.splice(_entries.begin(), _entries, it->second);
+
+        return it->second->value;
+    }
+
+    bool contains(const Key& key) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _index.count(key) > 0;
+    }
+
+    /*
+     * Insert or replace the value of a key, then let the budget evict
+     * the least recently used entries of all caches, other than this 
+     * one, while it is over its limit.
+     */
+    void insert(const Key& key, const Value& value) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _index.find(key);
+        if(it != _index.end()) erase(it->second);
+
+        size_t cost = sizeof(Entry) + sizeof(Value) + memo_cost(value);
+        _entries.push_front(Entry(key, value, cost, _budget.next_tick()));
+        _index[key] = _entries.begin();
+
+        _stats.bytes += cost;
+        ++_stats.entries;
+        _budget.allocate(cost);
+
+        if(_budget.is_over_limit()) _budget.reclaim(this);
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _budget.release(_stats.bytes);
+
+        _entries.clear();
+        _index.clear();
+        _stats.bytes = 0;
+        _stats.entries = 0;
+    }
+
+    ~MemoCache() {
+        clear();
+        _budget.unregister_cache(this);
+    }
+
+  protected:
+    virtual size_t get_oldest_tick(size_t keep) const {
+        return _entries.size() > keep ? _entries.back().tick : no_tick;
+    }
+
+    virtual void evict_oldest() {
+        erase(--_entries.end());
+        ++_stats.evictions;
+    }
+
+  private:
+    struct Entry {
+        Entry(const Key& key, const Value& value, size_t cost, size_t tick) :
+            key(key), value(new Value(value)), cost(cost), tick(tick)
+        { }
+
+        Key     key;
+        std::shared_ptr<const Value> value;
+        size_t  cost;
+        size_t  tick;
+    };
+
+    typedef typename std::list<Entry>::iterator EntryIterator;
+
+    void erase(EntryIterator entry) {
+        _budget.release(entry->cost);
+        _stats.bytes -= entry->cost;
+        --_stats.entries;
+
+        _index.erase(entry->key);
+        _entries.erase(entry);
+    }
+
+    std::list<Entry>                                        _entries;
+    std::unordered_map<Key, EntryIterator, IndexHash<Key> > _index;
+};
+
+} // namespace util
+} // namespace simple
@@ -0,0 +1,88 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "simple/util/relation_index.h"
+#include "simple/util/expr_util.h"
+
+namespace simple {
+namespace util {
+
+using namespace simple;
+
+namespace {
+
+size_t hash_expr(ExprAst *expr) {
+    switch(get_expr_type(expr)) {
+        case BinaryOpET: {
+            BinaryOpAst *op = expr_cast<BinaryOpAst>(expr);
+            return (op->get_op() * 31 + hash_expr(op->get_lhs())) * 31 + 
+                hash_expr(op->get_rhs());
+        }
+        case VariableET:
+            return std::hash<std::string>()(
+                expr_cast<VariableAst>(expr)->get_variable()->get_name());
+        case ConstantET:
+            return std::hash<int>()(expr_cast<ConstAst>(expr)->get_value());
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+/*
+ * Statements and procedures are the same condition only if they are
+ * the same AST, while the other conditions compare by value.
+ */
+size_t hash_condition(SimpleCondition *condition) {
+    size_t type = condition->get_condition_type();
+    size_t value = 0;
+
+    switch(condition->get_condition_type()) {
+        case StatementCT:
+            value = std::hash<StatementAst*>()(
+                static_cast<StatementCondition*>(condition)->get_statement_ast());
+            break;
+        case ProcCT:
+            value = std::hash<ProcAst*>()(
+                static_cast<ProcCondition*>(condition)->get_proc_ast());
+            break;
+        case VariableCT:
+            value = std::hash<std::string>()(
+                static_cast<VariableCondition*>(condition)->get_variable()->get_name());
+            break;
+        case PatternCT:
+            value = hash_expr(
+                static_cast<PatternCondition*>(condition)->get_expr_ast());
+            break;
+        case ConstantCT:
+            value = std::hash<int>()(
+                static_cast<ConstantCondition*>(condition)->get_constant()->get_int());
+            break;
+        case OperatorCT:
+            value = static_cast<OperatorCondition*>(condition)->get_operator();
+            break;
+        default:
+            break;
+    }
+
+    return value * 8 + type;
+}
+
+} // namespace util
+} // namespace simple
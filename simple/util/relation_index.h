@@ -0,0 +1,320 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <functional>
+#include "simple/ast.h"
+#include "simple/condition_set.h"
+
+namespace simple {
+namespace util {
+
+using namespace simple;
+
+/*
+ * Hash of a condition, consistent with is_same_condition().
+ */
+size_t hash_condition(SimpleCondition *condition);
+
+template <typename Key>
+struct IndexHash {
+    size_t operator()(const Key& key) const {
+        return std::hash<Key>()(key);
+    }
+};
+
+template <>
+struct IndexHash<SimpleVariable> {
+    size_t operator()(const SimpleVariable& variable) const {
+        return std::hash<std::string>()(
+            const_cast<SimpleVariable&>(variable).get_name());
+    }
+};
+
+template <>
+struct IndexHash<ConditionPtr> {
+    size_t operator()(const ConditionPtr& condition) const {
+        return hash_condition(condition.get());
+    }
+};
+
+template <typename First, typename Second>
+struct IndexHash< std::pair<First, Second> > {
+    size_t operator()(const std::pair<First, Second>& key) const {
+        return IndexHash<First>()(key.first) * 31 + 
+            IndexHash<Second>()(key.second);
+    }
+};
+
+/*
+ * HashIndex is the lookup table of a relation index. The entries are 
+ * kept in a dense array in insertion order, and an open addressing 
+ * table with linear probing maps each key to its entry. Looking up a
+ * missing key never inserts it.
+ *
+ * Solvers fill an index with insert() while building it, or while 
+ * caching results, and only look it up afterwards. A reference 
+ * returned by insert() is only valid until the next insert().
+ */
+template <typename Key, typename Value, typename Hash = IndexHash<Key> >
+class HashIndex {
+  public:
+    typedef std::pair<Key, Value>                           Entry;
+    typedef typename std::vector<Entry>::const_iterator     iterator;
+    typedef iterator                                        const_iterator;
+
+    HashIndex() { }
+
+    /*
+     * Get the value of a key, inserting a default value if it is not
+     * in the index yet.
+     */
+    Value& insert(const Key& key) {
+        int entry = find_entry(key);
+        if(entry != -1) return _entries[entry].second;
+
+        return insert_entry(key, Value());
+    }
+
+    Value& insert(const Key& key, const Value& value) {
+        int entry = find_entry(key);
+        if(entry != -1) return _entries[entry].second = value;
+
+        return insert_entry(key, value);
+    }
+
+    /*
+     * The value of a key, or NULL if it is not in the index.
+     */
+    const Value* find(const Key& key) const {
+        int entry = find_entry(key);
+        return entry != -1 ? &_entries[entry].second : NULL;
+    }
+
+    Value* find(const Key& key) {
+        int entry = find_entry(key);
+        return entry != -1 ? &_entries[entry].second : NULL;
+    }
+
+    /*
+     * The value of a key, or an empty value if it is not in the index.
+     */
+    const Value& get(const Key& key) const {
+        static const Value empty_value = Value();
+
+        const Value *value = find(key);
+        return value != NULL ? *value : empty_value;
+    }
+
+    bool contains(const Key& key) const {
+        return find_entry(key) != -1;
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    void clear() {
+        _entries.clear();
+        _buckets.clear();
+    }
+
+    iterator begin() const {
+        return _entries.begin();
+    }
+
+    iterator end() const {
+        return _entries.end();
+    }
+
+  private:
+    /*
+     * Mix the bits of the hash, since pointers and small integers hash
+     * to themselves and would otherwise fill only some of the buckets.
+     */
+    static size_t hash(const Key& key) {
+        unsigned long long value = Hash()(key);
+
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+
+        return (size_t) value;
+    }
+
+    int find_entry(const Key& key) const {
+        if(_buckets.empty()) return -1;
+
+        size_t mask = _buckets.size() - 1;
+        for(size_t bucket = hash(key) & mask; ; bucket = (bucket + 1) & mask) {
+            int entry = _buckets[bucket];
+
+            if(entry == -1) return -1;
+            if(_entries[entry].first == key) return entry;
+        }
+    }
+
+    Value& insert_entry(const Key& key, const Value& value) {
+        _entries.push_back(Entry(key, value));
+
+        if(_entries.size() * 2 > _buckets.size()) {
+            rehash();
+        } else {
+            place_entry(_entries.size() - 1);
+        }
+
+        return _entries.back().second;
+    }
+
+    /*
+     * Keep the table at most half full.
+     */
+    void rehash() {
+        size_t bucket_count = _buckets.empty() ? 16 : _buckets.size() * 2;
+        while(_entries.size() * 2 > bucket_count) bucket_count *= 2;
+
+        _buckets.assign(bucket_count, -1);
+
+        for(size_t entry = 0; entry < _entries.size(); ++entry) {
+            place_entry(entry);
+        }
+    }
+
+    void place_entry(size_t entry) {
+        size_t mask = _buckets.size() - 1;
+        size_t bucket = hash(_entries[entry].first) & mask;
+
+        while(_buckets[bucket] != -1) bucket = (bucket + 1) & mask;
+
+        _buckets[bucket] = entry;
+    }
+
+    std::vector<Entry>  _entries;
+    std::vector<int>    _buckets;
+};
+
+/*
+ * StatementIndex is the lookup table of a relation index keyed by
+ * statements. A statement is stored at its statement line in a dense 
+ * array, so a lookup is a single array access. Statements without a 
+ * line, or sharing their line with another statement as in hand built
+ * test programs, are kept in a hash index instead.
+ */
+template <typename Value>
+class StatementIndex {
+  public:
+    StatementIndex() { }
+
+    Value& insert(StatementAst *statement) {
+        int line = statement->get_statement_line();
+
+        if(line <= 0) return _overflow.insert(statement);
+
+        if(line >= (int) _statements.size()) {
+            _statements.resize(line + 1, NULL);
+            _values.resize(line + 1);
+        }
+
+        if(_statements[line] == NULL) {
+            _statements[line] = statement;
+        } else if(_statements[line] != statement) {
+            return _overflow.insert(statement);
+        }
+
+        return _values[line];
+    }
+
+    Value& insert(StatementAst *statement, const Value& value) {
+        return insert(statement) = value;
+    }
+
+    const Value* find(StatementAst *statement) const {
+        int line = statement->get_statement_line();
+
+        if(line > 0 && line < (int) _statements.size() && 
+            _statements[line] == statement) 
+        {
+            return &_values[line];
+        }
+
+        return _overflow.find(statement);
+    }
+
+    const Value& get(StatementAst *statement) const {
+        static const Value empty_value = Value();
+
+        const Value *value = find(statement);
+        return value != NULL ? *value : empty_value;
+    }
+
+    bool contains(StatementAst *statement) const {
+        return find(statement) != NULL;
+    }
+
+    void clear() {
+        _statements.clear();
+        _values.clear();
+        _overflow.clear();
+    }
+
+    /*
+     * Move every statement to its current statement line, after the
+     * statements of the program were renumbered, and drop the statements
+     * in removed. The values are moved along, not computed again.
+     */
+    void renumber(const std::set<StatementAst*>& removed) {
+        std::vector<StatementAst*> statements;
+        std::vector<Value> values;
+        HashIndex<StatementAst*, Value> overflow;
+
+        statements.swap(_statements);
+        values.swap(_values);
+        std::swap(overflow, _overflow);
+
+        for(size_t line = 0; line < statements.size(); ++line) {
+            StatementAst *statement = statements[line];
+            if(statement == NULL || removed.count(statement) > 0) continue;
+
+            std::swap(insert(statement), values[line]);
+        }
+
+        for(typename HashIndex<StatementAst*, Value>::iterator it = overflow.begin();
+            it != overflow.end(); ++it)
+        {
+            if(removed.count(it->first) == 0) insert(it->first, it->second);
+        }
+    }
+
+  private:
+    std::vector<StatementAst*>          _statements;
+    std::vector<Value>                  _values;
+    HashIndex<StatementAst*, Value>     _overflow;
+};
+
+} // namespace util
+} // namespace simple
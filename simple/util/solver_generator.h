@@ -26,210 +26,313 @@ namespace impl {
 
 using namespace simple;
 
+/*
+ * Existence checks of a concrete solver. By default they are answered
+ * by computing the full result set and checking if it is empty. 
+ * Concrete solvers that have a cheaper way to answer them implement
+ * has_left(), has_right() and is_nonempty() themselves and specialize
+ * SolverExistenceTraits to DirectSolverExistenceTraits, or implement
+ * only is_nonempty() and specialize it to DirectSolverNonemptyTraits.
+ */
 template <typename ConcreteSolver>
-class SimpleSolverGenerator : public QuerySolver  {
-  private:
- 
-    class SolverLeftVisitor : public ConditionVisitor {
-      public:
-        SolverLeftVisitor(ConcreteSolver *solver) : _solver(solver) { }
-
-        void visit_statement_condition(StatementCondition *condition) {
-            _result = _solver->template solve_left<StatementAst>(condition->get_statement_ast());
-        }
-
-        void visit_proc_condition(ProcCondition *condition) {
-            _result = _solver->template solve_left<ProcAst>(condition->get_proc_ast());
-        }
-
-        void visit_variable_condition(VariableCondition *condition) {
-            _result = _solver->template solve_left<SimpleVariable>(condition->get_variable());
-        }
+class DefaultSolverExistenceTraits {
+  public:
+    template <typename Condition>
+    static bool has_right(ConcreteSolver *solver, Condition *condition) {
+        return !solver->template solve_right<Condition>(condition).is_empty();
+    }
 
-        void visit_constant_condition(ConstantCondition *condition) {
-            _result = _solver->template solve_left<SimpleConstant>(condition->get_constant());
-        }
+    template <typename Condition>
+    static bool has_left(ConcreteSolver *solver, Condition *condition) {
+        return !solver->template solve_left<Condition>(condition).is_empty();
+    }
 
-        void visit_pattern_condition(PatternCondition *condition) {
-            _result = _solver->template solve_left<ExprAst>(condition->get_expr_ast());
-        }
+    static bool is_nonempty(ConcreteSolver *solver, 
+            QuerySolver *query_solver, const ConditionSet& universe)
+    {
+        return query_solver->QuerySolver::is_nonempty(universe);
+    }
+};
 
-        void visit_operator_condition(OperatorCondition* condition) {
-            _result = _solver->template solve_left<OperatorCondition>(condition);
-        }
+template <typename ConcreteSolver>
+class SolverExistenceTraits : 
+    public DefaultSolverExistenceTraits<ConcreteSolver>
+{ };
 
-        ConditionSet return_result() {
-            return std::move(_result);
-        }
+template <typename ConcreteSolver>
+class DirectSolverNonemptyTraits : 
+    public DefaultSolverExistenceTraits<ConcreteSolver>
+{
+  public:
+    static bool is_nonempty(ConcreteSolver *solver, 
+            QuerySolver *query_solver, const ConditionSet& universe)
+    {
+        return solver->is_nonempty(universe);
+    }
+};
 
-      private:
-        ConcreteSolver *_solver;
-        ConditionSet _result;
-    };
+template <typename ConcreteSolver>
+class DirectSolverExistenceTraits {
+  public:
+    template <typename Condition>
+    static bool has_right(ConcreteSolver *solver, Condition *condition) {
+        return solver->template has_right<Condition>(condition);
+    }
 
-    class SolverRightVisitor : public ConditionVisitor {
-      public:
-        SolverRightVisitor(ConcreteSolver *solver) : _solver(solver) { }
+    template <typename Condition>
+    static bool has_left(ConcreteSolver *solver, Condition *condition) {
+        return solver->template has_left<Condition>(condition);
+    }
 
-        void visit_statement_condition(StatementCondition *condition) {
-            _result = _solver->template solve_right<StatementAst>(condition->get_statement_ast());
-        }
+    static bool is_nonempty(ConcreteSolver *solver, 
+            QuerySolver *query_solver, const ConditionSet& universe)
+    {
+        return solver->is_nonempty(universe);
+    }
+};
 
-        void visit_proc_condition(ProcCondition *condition) {
-            _result = _solver->template solve_right<ProcAst>(condition->get_proc_ast());
-        }
+/*
+ * Batch solving of a concrete solver. By default the batch is solved
+ * one condition at a time through solve_left() and solve_right().
+ * Concrete solvers with a batch implementation of their own specialize
+ * this class to DirectSolverBatchTraits.
+ */
+template <typename ConcreteSolver>
+class SolverBatchTraits {
+  public:
+    static std::set<ConditionPair> solve_right_batch(
+        ConcreteSolver *solver, QuerySolver *query_solver,
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+    {
+        return query_solver->QuerySolver::solve_right_batch(lefts, right_domain);
+    }
 
-        void visit_variable_condition(VariableCondition *condition) {
-            _result = _solver->template solve_right<SimpleVariable>(condition->get_variable());
-        }
+    static std::set<ConditionPair> solve_left_batch(
+        ConcreteSolver *solver, QuerySolver *query_solver,
+        const ConditionSet& rights, const ConditionSet& left_domain)
+    {
+        return query_solver->QuerySolver::solve_left_batch(rights, left_domain);
+    }
+};
 
-        void visit_constant_condition(ConstantCondition *condition) {
-            _result = _solver->template solve_right<SimpleConstant>(condition->get_constant());
-        }
+template <typename ConcreteSolver>
+class DirectSolverBatchTraits {
+  public:
+    static std::set<ConditionPair> solve_right_batch(
+        ConcreteSolver *solver, QuerySolver *query_solver,
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+    {
+        return solver->solve_right_batch(lefts, right_domain);
+    }
 
-        void visit_pattern_condition(PatternCondition *condition) {
-            _result = _solver->template solve_right<ExprAst>(condition->get_expr_ast());
-        }
+    static std::set<ConditionPair> solve_left_batch(
+        ConcreteSolver *solver, QuerySolver *query_solver,
+        const ConditionSet& rights, const ConditionSet& left_domain)
+    {
+        return solver->solve_left_batch(rights, left_domain);
+    }
+};
 
-        void visit_operator_condition(OperatorCondition* condition) {
-            _result = _solver->template solve_right<OperatorCondition>(condition);
-        }
+/*
+ * Map a condition type tag to the AST type the concrete solvers are
+ * specialized on, and unpack a condition of that tag to it. The tag
+ * guarantees the condition type, so unpacking is a static cast.
+ */
+template <ConditionType Type>
+struct ConditionTypeTraits { };
 
-        ConditionSet return_result() {
-            return std::move(_result);
-        }
+template <>
+struct ConditionTypeTraits<StatementCT> {
+    typedef StatementAst AstType;
 
-      private:
-        ConcreteSolver *_solver;
-        ConditionSet _result;
-    };
+    static StatementAst* unpack(SimpleCondition *condition) {
+        return static_cast<StatementCondition*>(condition)->get_statement_ast();
+    }
+};
 
-    template <typename Condition>
-    class SecondSolverVisitor : public ConditionVisitor {
-      public:
-        SecondSolverVisitor(ConcreteSolver *solver, Condition *condition) :
-            _solver(solver), 
-            _left_condition(condition),
-            _result()
-        { }
-
-        void visit_statement_condition(StatementCondition *right_condition) {
-            _result = _solver->template validate<Condition, StatementAst>(
-                    _left_condition, right_condition->get_statement_ast());
-        }
+template <>
+struct ConditionTypeTraits<ProcCT> {
+    typedef ProcAst AstType;
 
-        void visit_proc_condition(ProcCondition *right_condition) {
-            _result = _solver->template validate<Condition, ProcAst>(
-                    _left_condition, right_condition->get_proc_ast());
-        }
+    static ProcAst* unpack(SimpleCondition *condition) {
+        return static_cast<ProcCondition*>(condition)->get_proc_ast();
+    }
+};
 
-        void visit_variable_condition(VariableCondition *right_condition) {
-            _result = _solver->template validate<Condition, SimpleVariable>(
-                    _left_condition, right_condition->get_variable());
-        }
+template <>
+struct ConditionTypeTraits<VariableCT> {
+    typedef SimpleVariable AstType;
 
-        void visit_constant_condition(ConstantCondition *right_condition) {
-            _result = _solver->template validate<Condition, SimpleConstant>(
-                    _left_condition, right_condition->get_constant());
-        }
+    static SimpleVariable* unpack(SimpleCondition *condition) {
+        return static_cast<VariableCondition*>(condition)->get_variable();
+    }
+};
 
-        void visit_pattern_condition(PatternCondition *right_condition) {
-            _result = _solver->template validate<Condition, ExprAst>(
-                    _left_condition, right_condition->get_expr_ast());
-        }
+template <>
+struct ConditionTypeTraits<PatternCT> {
+    typedef ExprAst AstType;
 
-        void visit_operator_condition(OperatorCondition* right_condition) {
-            _result = _solver->template validate<Condition, OperatorCondition>(
-                    _left_condition, right_condition);
-        }
+    static ExprAst* unpack(SimpleCondition *condition) {
+        return static_cast<PatternCondition*>(condition)->get_expr_ast();
+    }
+};
 
-        bool return_result() {
-            return std::move(_result);
-        }
+template <>
+struct ConditionTypeTraits<ConstantCT> {
+    typedef SimpleConstant AstType;
 
-      private:
-        ConcreteSolver *_solver;
-        Condition *_left_condition;
-        bool _result;
+    static SimpleConstant* unpack(SimpleCondition *condition) {
+        return static_cast<ConstantCondition*>(condition)->get_constant();
+    }
+};
 
-    };
+template <>
+struct ConditionTypeTraits<OperatorCT> {
+    typedef OperatorCondition AstType;
 
-    class FirstSolverVisitor : public ConditionVisitor {
-      public:
-        FirstSolverVisitor(ConcreteSolver *solver, SimpleCondition *right_condition) :
-            _solver(solver), 
-            _right_condition(right_condition)
-        { }
+    static OperatorCondition* unpack(SimpleCondition *condition) {
+        return static_cast<OperatorCondition*>(condition);
+    }
+};
 
-        void visit_statement_condition(StatementCondition *condition) {
-            SecondSolverVisitor<StatementAst> visitor(_solver, condition->get_statement_ast());
-            _right_condition->accept_condition_visitor(&visitor);
-            _result = visitor.return_result();
-        }
+/*
+ * SimpleSolverGenerator turns a concrete solver with templated methods
+ * into a QuerySolver. Every templated method is instantiated for each
+ * condition type, or each pair of condition types for validate(), into
+ * a static function table indexed by the condition type tags. A call is
+ * then dispatched with a single table lookup.
+ */
+template <typename ConcreteSolver>
+class SimpleSolverGenerator : public QuerySolver  {
+  private:
+    typedef SolverExistenceTraits<ConcreteSolver> ExistenceTraits;
+    typedef SolverBatchTraits<ConcreteSolver> BatchTraits;
 
-        void visit_proc_condition(ProcCondition *condition) {
-            SecondSolverVisitor<ProcAst> visitor(_solver, condition->get_proc_ast());
-            _right_condition->accept_condition_visitor(&visitor);
-            _result = visitor.return_result();
-        }
+    typedef ConditionSet (*SolveFunction)(void *solver, SimpleCondition *condition);
 
-        void visit_variable_condition(VariableCondition *condition) {
-            SecondSolverVisitor<SimpleVariable> visitor(_solver, condition->get_variable());
-            _right_condition->accept_condition_visitor(&visitor);
-            _result = visitor.return_result();
-        }
+    template <ConditionType Type>
+    static ConditionSet solve_left_entry(void *solver, SimpleCondition *condition) {
+        typedef ConditionTypeTraits<Type> Traits;
+        return static_cast<ConcreteSolver*>(solver)->template 
+            solve_left<typename Traits::AstType>(Traits::unpack(condition));
+    }
 
-        void visit_constant_condition(ConstantCondition *condition) {
-            SecondSolverVisitor<SimpleConstant> visitor(_solver, condition->get_constant());
-            _right_condition->accept_condition_visitor(&visitor);
-            _result = visitor.return_result();
-        }
+    template <ConditionType Type>
+    static ConditionSet solve_right_entry(void *solver, SimpleCondition *condition) {
+        typedef ConditionTypeTraits<Type> Traits;
+        return static_cast<ConcreteSolver*>(solver)->template 
+            solve_right<typename Traits::AstType>(Traits::unpack(condition));
+    }
 
-        void visit_pattern_condition(PatternCondition *condition) {
-            SecondSolverVisitor<ExprAst> visitor(_solver, condition->get_expr_ast());
-            _right_condition->accept_condition_visitor(&visitor);
-            _result = visitor.return_result();
-        }
+    template <ConditionType Type>
+    static bool has_left_entry(void *solver, SimpleCondition *condition) {
+        typedef ConditionTypeTraits<Type> Traits;
+        return ExistenceTraits::template has_left<typename Traits::AstType>(
+            static_cast<ConcreteSolver*>(solver), Traits::unpack(condition));
+    }
 
-        void visit_operator_condition(OperatorCondition* right_condition) {
-            SecondSolverVisitor<OperatorCondition> visitor(_solver, right_condition);
-            _right_condition->accept_condition_visitor(&visitor);
-            _result = visitor.return_result();
-        }
+    template <ConditionType Type>
+    static bool has_right_entry(void *solver, SimpleCondition *condition) {
+        typedef ConditionTypeTraits<Type> Traits;
+        return ExistenceTraits::template has_right<typename Traits::AstType>(
+            static_cast<ConcreteSolver*>(solver), Traits::unpack(condition));
+    }
 
-        bool return_result() {
-            return std::move(_result);
-        }
+    template <ConditionType LeftType, ConditionType RightType>
+    static bool validate_entry(void *solver, 
+        SimpleCondition *left_condition, SimpleCondition *right_condition)
+    {
+        typedef ConditionTypeTraits<LeftType> LeftTraits;
+        typedef ConditionTypeTraits<RightType> RightTraits;
+
+        return static_cast<ConcreteSolver*>(solver)->template validate<
+                typename LeftTraits::AstType, typename RightTraits::AstType>(
+            LeftTraits::unpack(left_condition), 
+            RightTraits::unpack(right_condition));
+    }
 
-      private:
-        bool _result;
-        ConcreteSolver  *_solver;
-        SimpleCondition *_right_condition;
-    };
+    static const SolveFunction _solve_left_table[ConditionTypeCount];
+    static const SolveFunction _solve_right_table[ConditionTypeCount];
+    static const TypedExistenceCheck::Function _has_left_table[ConditionTypeCount];
+    static const TypedExistenceCheck::Function _has_right_table[ConditionTypeCount];
+    static const TypedValidator::Function 
+        _validate_table[ConditionTypeCount][ConditionTypeCount];
 
   public:
-    SimpleSolverGenerator(ConcreteSolver *solver) : _solver(solver) { }
+    SimpleSolverGenerator(ConcreteSolver *solver) : 
+        _solver(solver), _nonempty_known(false), _nonempty(false) 
+    { }
     
     SimpleSolverGenerator(std::shared_ptr<ConcreteSolver> solver) : 
-        _solver(solver) 
+        _solver(solver), _nonempty_known(false), _nonempty(false) 
     { }
 
     virtual ConditionSet solve_left(SimpleCondition *right_condition) {
-        SolverLeftVisitor visitor(_solver.get());
-        right_condition->accept_condition_visitor(&visitor);
-        return visitor.return_result();
+        return _solve_left_table[right_condition->get_condition_type()](
+            _solver.get(), right_condition);
     }
 
     virtual ConditionSet solve_right(SimpleCondition *left_condition) {
-        SolverRightVisitor visitor(_solver.get());
-        left_condition->accept_condition_visitor(&visitor);
-        return visitor.return_result();
+        return _solve_right_table[left_condition->get_condition_type()](
+            _solver.get(), left_condition);
     }
 
     virtual bool validate(SimpleCondition *left_condition, SimpleCondition *right_condition) {
-        FirstSolverVisitor visitor(_solver.get(), right_condition);
-        left_condition->accept_condition_visitor(&visitor);
-        return visitor.return_result();
+        return _validate_table[left_condition->get_condition_type()]
+                              [right_condition->get_condition_type()](
+            _solver.get(), left_condition, right_condition);
+    }
+
+    virtual bool has_left(SimpleCondition *right_condition) {
+        return _has_left_table[right_condition->get_condition_type()](
+            _solver.get(), right_condition);
+    }
+
+    virtual bool has_right(SimpleCondition *left_condition) {
+        return _has_right_table[left_condition->get_condition_type()](
+            _solver.get(), left_condition);
+    }
+
+    /*
+     * The universe is the same set of all conditions in the program for
+     * every call, so the answer is computed on first use and kept.
+     */
+    virtual bool is_nonempty(const ConditionSet& universe) {
+        if(!_nonempty_known) {
+            _nonempty = ExistenceTraits::is_nonempty(_solver.get(), this, universe);
+            _nonempty_known = true;
+        }
+
+        return _nonempty;
+    }
+
+    virtual std::set<ConditionPair> solve_right_batch(
+        const ConditionSet& lefts, const ConditionSet& right_domain)
+    {
+        return BatchTraits::solve_right_batch(
+            _solver.get(), this, lefts, right_domain);
+    }
+
+    virtual std::set<ConditionPair> solve_left_batch(
+        const ConditionSet& rights, const ConditionSet& left_domain)
+    {
+        return BatchTraits::solve_left_batch(
+            _solver.get(), this, rights, left_domain);
+    }
+
+    virtual TypedValidator get_validator(
+            ConditionType left_type, ConditionType right_type)
+    {
+        return TypedValidator(
+            _validate_table[left_type][right_type], _solver.get());
+    }
+
+    virtual TypedExistenceCheck get_right_check(ConditionType left_type) {
+        return TypedExistenceCheck(_has_right_table[left_type], _solver.get());
+    }
+
+    virtual TypedExistenceCheck get_left_check(ConditionType right_type) {
+        return TypedExistenceCheck(_has_left_table[right_type], _solver.get());
     }
 
     ConcreteSolver* get_solver() {
@@ -239,7 +342,62 @@ class SimpleSolverGenerator : public QuerySolver  {
   private:
     std::shared_ptr<ConcreteSolver> _solver;
 
+    bool _nonempty_known;
+    bool _nonempty;
+
 };
+
+/*
+ * Function table definitions. The entries must follow the order of the
+ * ConditionType enum.
+ */
+#define SIMPLE_CONDITION_TYPE_ROW(entry) { \
+    &entry<StatementCT>, &entry<ProcCT>, &entry<VariableCT>, \
+    &entry<PatternCT>, &entry<ConstantCT>, &entry<OperatorCT> }
+
+#define SIMPLE_VALIDATE_ROW(LeftType) { \
+    &validate_entry<LeftType, StatementCT>, \
+    &validate_entry<LeftType, ProcCT>, \
+    &validate_entry<LeftType, VariableCT>, \
+    &validate_entry<LeftType, PatternCT>, \
+    &validate_entry<LeftType, ConstantCT>, \
+    &validate_entry<LeftType, OperatorCT> }
+
+template <typename ConcreteSolver>
+const typename SimpleSolverGenerator<ConcreteSolver>::SolveFunction
+SimpleSolverGenerator<ConcreteSolver>::_solve_left_table[ConditionTypeCount] =
+    SIMPLE_CONDITION_TYPE_ROW(solve_left_entry);
+
+template <typename ConcreteSolver>
+const typename SimpleSolverGenerator<ConcreteSolver>::SolveFunction
+SimpleSolverGenerator<ConcreteSolver>::_solve_right_table[ConditionTypeCount] =
+    SIMPLE_CONDITION_TYPE_ROW(solve_right_entry);
+
+template <typename ConcreteSolver>
+const TypedExistenceCheck::Function
+SimpleSolverGenerator<ConcreteSolver>::_has_left_table[ConditionTypeCount] =
+    SIMPLE_CONDITION_TYPE_ROW(has_left_entry);
+
+template <typename ConcreteSolver>
+const TypedExistenceCheck::Function
+SimpleSolverGenerator<ConcreteSolver>::_has_right_table[ConditionTypeCount] =
+    SIMPLE_CONDITION_TYPE_ROW(has_right_entry);
+
+template <typename ConcreteSolver>
+const TypedValidator::Function
+SimpleSolverGenerator<ConcreteSolver>::_validate_table
+        [ConditionTypeCount][ConditionTypeCount] = 
+{
+    SIMPLE_VALIDATE_ROW(StatementCT),
+    SIMPLE_VALIDATE_ROW(ProcCT),
+    SIMPLE_VALIDATE_ROW(VariableCT),
+    SIMPLE_VALIDATE_ROW(PatternCT),
+    SIMPLE_VALIDATE_ROW(ConstantCT),
+    SIMPLE_VALIDATE_ROW(OperatorCT)
+};
+
+#undef SIMPLE_CONDITION_TYPE_ROW
+#undef SIMPLE_VALIDATE_ROW
     
 } // namespace impl
 } // namespace simple
@@ -4,36 +4,33 @@
 namespace spa {
 
 using namespace simple;
-using namespace simple::impl;
 
 Affects::Affects(SolverPtr affects_solver, StatementTable *statement_table) :
-  _affects_solver(affects_solver), _statement_table(statement_table)
+  _statement_table(statement_table),
+  _relation(affects_solver, statement_table, statement_table)
 { }
 
 bool Affects::is_affects(StatementLine s1, StatementLine s2) {
-    SimpleStatementCondition c1(
-        _statement_table->get_statement(s1));
-
-    SimpleStatementCondition c2(
-        _statement_table->get_statement(s2));
-
-    return _affects_solver->validate(&c1, &c2);
+    _statement_table->check_id(s2);
+    return _relation.holds(s1, s2);
 }
 
 StatementResults Affects::get_affected(StatementLine s1) {
-    SimpleStatementCondition c1(
-        _statement_table->get_statement(s1));
-    
-    ConditionSet result = _affects_solver->solve_right(&c1);
-    return condition_to_statement_results(result);
+    IdSpan result = _relation.get_rights(s1);
+    return StatementResults(result.begin, result.end);
 }
 
 StatementResults Affects::get_affecter(StatementLine s2) {
-    SimpleStatementCondition c2(
-        _statement_table->get_statement(s2));
-    
-    ConditionSet result = _affects_solver->solve_left(&c2);
-    return condition_to_statement_results(result);
+    IdSpan result = _relation.get_lefts(s2);
+    return StatementResults(result.begin, result.end);
+}
+
+IdSpan Affects::get_affected_ids(StatementLine s1) {
+    return _relation.get_rights(s1);
+}
+
+IdSpan Affects::get_affecter_ids(StatementLine s2) {
+    return _relation.get_lefts(s2);
 }
 
 }
\ No newline at end of file
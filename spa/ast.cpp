@@ -1,14 +1,51 @@
 
 #include "spa/ast.h"
 #include "simple/util/statement_visitor_generator.h"
+#include "simple/util/expr_util.h"
 
 namespace spa {
 
 using namespace simple;
 using namespace simple::util;
 
+namespace {
+
+void collect_statement_list_vars(StatementAst *statement, VariableSet& vars) {
+    while(statement != NULL) {
+        if(AssignmentAst *assign = statement_cast<AssignmentAst>(statement)) {
+            vars.insert(*assign->get_variable());
+
+            VariableSet used = get_expr_vars(assign->get_expr());
+            vars.insert(used.begin(), used.end());
+
+        } else if(WhileAst *loop = statement_cast<WhileAst>(statement)) {
+            vars.insert(*loop->get_variable());
+            collect_statement_list_vars(loop->get_body(), vars);
+
+        } else if(IfAst *condition = statement_cast<IfAst>(statement)) {
+            vars.insert(*condition->get_variable());
+            collect_statement_list_vars(condition->get_then_branch(), vars);
+            collect_statement_list_vars(condition->get_else_branch(), vars);
+        }
+
+        statement = statement->next();
+    }
+}
+
+VariableSet collect_vars(SimpleRoot ast) {
+    VariableSet vars;
+    for(auto it = ast.begin(); it != ast.end(); ++it) {
+        collect_statement_list_vars((*it)->get_statement(), vars);
+    }
+
+    return vars;
+}
+
+}
+
 AST::AST(SimpleRoot ast, StatementTable *statement_table) :
-    _ast(ast), _statement_table(statement_table)
+    _ast(ast), _statement_table(statement_table),
+    _var_table(collect_vars(ast)), _proc_table(ast)
 {
     for(auto it = ast.begin() ; it != ast.end(); ++it) {
         _procs.insert((*it)->get_name());
@@ -27,6 +64,13 @@ ProcAst* AST::get_proc(Proc proc_name) {
     return proc;
 }
 
+int AST::get_proc_id(Proc proc_name) {
+    int id = _proc_table.get_proc_id(proc_name);
+    if(id == -1) throw std::runtime_error("Procedure not found");
+
+    return id;
+}
+
 StatementLine AST::get_proc_body(Proc proc_name) {
     return get_proc(proc_name)->get_statement()->get_statement_line();
 }
@@ -86,5 +130,17 @@ SimpleRoot AST::get_root() {
     return _ast;
 }
 
+StatementTable* AST::get_statement_table() {
+    return _statement_table;
+}
+
+VarTable* AST::get_var_table() {
+    return &_var_table;
+}
+
+ProcTable* AST::get_proc_table() {
+    return &_proc_table;
+}
+
 
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "simple/types.h"
 #include "simple/util/ast_utils.h"
 #include "spa/statement.h"
+#include "spa/var_table.h"
+#include "spa/proc_table.h"
 
 namespace spa {
 
@@ -20,6 +22,12 @@ class AST {
     StatementAst* get_statement(StatementLine line);
 
     ProcAst* get_proc(Proc proc_name);
+
+    /*
+     * The ID of a procedure in the procedure table. Throws if there is 
+     * no procedure by the name.
+     */
+    int get_proc_id(Proc proc_name);
     StatementLine get_proc_body(Proc proc_name);
 
     ProcResults get_all_procs();
@@ -42,10 +50,16 @@ class AST {
 
     SimpleRoot get_root();
 
+    StatementTable* get_statement_table();
+    VarTable* get_var_table();
+    ProcTable* get_proc_table();
+
   private:
     SimpleRoot _ast;
     StatementTable *_statement_table;
     ProcResults _procs;
+    VarTable _var_table;
+    ProcTable _proc_table;
 };
 
 }
\ No newline at end of file
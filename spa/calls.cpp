@@ -4,31 +4,35 @@
 namespace spa {
 
 using namespace simple;
-using namespace simple::impl;
 
 Calls::Calls(SolverPtr calls_solver, AST *ast) :
-  _calls_solver(calls_solver), _ast(ast)
+  _ast(ast),
+  _relation(calls_solver, ast->get_proc_table(), ast->get_proc_table())
 { }
 
 bool Calls::validate_calls(Proc p1, Proc p2) {
-    SimpleProcCondition c1(_ast->get_proc(p1));
-    SimpleProcCondition c2(_ast->get_proc(p2));
-  
-    return _calls_solver->validate(&c1, &c2);
+    int proc_id1 = _ast->get_proc_id(p1);
+    int proc_id2 = _ast->get_proc_id(p2);
+
+    return _relation.holds(proc_id1, proc_id2);
 }
 
 ProcResults Calls::get_called(Proc p1) {
-    SimpleProcCondition c1(_ast->get_proc(p1));
-    
-    ConditionSet result = _calls_solver->solve_right(&c1);
-    return condition_to_proc_results(result);
+    return _ast->get_proc_table()->get_proc_names(
+        get_called_ids(_ast->get_proc_id(p1)));
 }
 
 ProcResults Calls::get_caller(Proc p2) {
-    SimpleProcCondition c2(_ast->get_proc(p2));
-    
-    ConditionSet result = _calls_solver->solve_left(&c2);
-    return condition_to_proc_results(result);
+    return _ast->get_proc_table()->get_proc_names(
+        get_caller_ids(_ast->get_proc_id(p2)));
+}
+
+IdSpan Calls::get_called_ids(int proc_id1) {
+    return _relation.get_rights(proc_id1);
+}
+
+IdSpan Calls::get_caller_ids(int proc_id2) {
+    return _relation.get_lefts(proc_id2);
 }
 
 }
\ No newline at end of file
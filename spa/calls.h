@@ -6,6 +6,7 @@
 #include "impl/condition.h"
 #include "spa/ast.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -21,9 +22,13 @@ class Calls {
 
     ProcResults get_caller(Proc p2);
 
+    IdSpan get_called_ids(int proc_id1);
+
+    IdSpan get_caller_ids(int proc_id2);
+
   private:
-    SolverPtr _calls_solver;
     AST *_ast;
+    IdRelation _relation;
 };
 
 }
\ No newline at end of file
@@ -4,31 +4,35 @@
 namespace spa {
 
 using namespace simple;
-using namespace simple::impl;
 
 CallsStar::CallsStar(SolverPtr calls_star_solver, AST *ast) :
-  _calls_star_solver(calls_star_solver), _ast(ast)
+  _ast(ast),
+  _relation(calls_star_solver, ast->get_proc_table(), ast->get_proc_table())
 { }
 
 bool CallsStar::validate_calls_star(Proc p1, Proc p2) {
-    SimpleProcCondition c1(_ast->get_proc(p1));
-    SimpleProcCondition c2(_ast->get_proc(p2));
-  
-    return _calls_star_solver->validate(&c1, &c2);
+    int proc_id1 = _ast->get_proc_id(p1);
+    int proc_id2 = _ast->get_proc_id(p2);
+
+    return _relation.holds(proc_id1, proc_id2);
 }
 
 ProcResults CallsStar::get_called_star(Proc p1) {
-    SimpleProcCondition c1(_ast->get_proc(p1));
-    
-    ConditionSet result = _calls_star_solver->solve_right(&c1);
-    return condition_to_proc_results(result);
+    return _ast->get_proc_table()->get_proc_names(
+        get_called_star_ids(_ast->get_proc_id(p1)));
 }
 
 ProcResults CallsStar::get_caller_star(Proc p2) {
-    SimpleProcCondition c2(_ast->get_proc(p2));
-    
-    ConditionSet result = _calls_star_solver->solve_left(&c2);
-    return condition_to_proc_results(result);
+    return _ast->get_proc_table()->get_proc_names(
+        get_caller_star_ids(_ast->get_proc_id(p2)));
+}
+
+IdSpan CallsStar::get_called_star_ids(int proc_id1) {
+    return _relation.get_rights(proc_id1);
+}
+
+IdSpan CallsStar::get_caller_star_ids(int proc_id2) {
+    return _relation.get_lefts(proc_id2);
 }
 
 }
\ No newline at end of file
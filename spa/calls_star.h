@@ -6,6 +6,7 @@
 #include "impl/condition.h"
 #include "spa/ast.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -21,9 +22,13 @@ class CallsStar {
 
     ProcResults get_caller_star(Proc p2);
 
+    IdSpan get_called_star_ids(int proc_id1);
+
+    IdSpan get_caller_star_ids(int proc_id2);
+
   private:
-    SolverPtr _calls_star_solver;
     AST *_ast;
+    IdRelation _relation;
 };
 
 }
\ No newline at end of file
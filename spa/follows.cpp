@@ -4,36 +4,33 @@
 namespace spa {
 
 using namespace simple;
-using namespace simple::impl;
 
 Follows::Follows(SolverPtr follows_solver, StatementTable *statement_table) :
-  _follows_solver(follows_solver), _statement_table(statement_table)
+  _statement_table(statement_table),
+  _relation(follows_solver, statement_table, statement_table)
 { }
 
 bool Follows::is_follows(StatementLine s1, StatementLine s2) {
-    SimpleStatementCondition c1(
-        _statement_table->get_statement(s1));
-
-    SimpleStatementCondition c2(
-        _statement_table->get_statement(s2));
-
-    return _follows_solver->validate(&c1, &c2);
+    _statement_table->check_id(s2);
+    return _relation.holds(s1, s2);
 }
 
 StatementResults Follows::get_follows(StatementLine s1) {
-    SimpleStatementCondition c1(
-        _statement_table->get_statement(s1));
-    
-    ConditionSet result = _follows_solver->solve_right(&c1);
-    return condition_to_statement_results(result);
+    IdSpan result = _relation.get_rights(s1);
+    return StatementResults(result.begin, result.end);
 }
 
 StatementResults Follows::get_preceding(StatementLine s2) {
-    SimpleStatementCondition c2(
-        _statement_table->get_statement(s2));
-    
-    ConditionSet result = _follows_solver->solve_left(&c2);
-    return condition_to_statement_results(result);
+    IdSpan result = _relation.get_lefts(s2);
+    return StatementResults(result.begin, result.end);
+}
+
+IdSpan Follows::get_follows_ids(StatementLine s1) {
+    return _relation.get_rights(s1);
+}
+
+IdSpan Follows::get_preceding_ids(StatementLine s2) {
+    return _relation.get_lefts(s2);
 }
 
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "simple/solver.h"
 #include "impl/condition.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -21,9 +22,13 @@ class Follows {
 
     StatementResults get_preceding(StatementLine s2);
 
+    IdSpan get_follows_ids(StatementLine s1);
+
+    IdSpan get_preceding_ids(StatementLine s2);
+
   private:
-    SolverPtr _follows_solver;
     StatementTable *_statement_table;
+    IdRelation _relation;
 };
 
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "simple/solver.h"
 #include "impl/condition.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -21,9 +22,13 @@ class FollowsStar {
 
     StatementResults get_preceding_star(StatementLine s2);
 
+    IdSpan get_follows_star_ids(StatementLine s1);
+
+    IdSpan get_preceding_star_ids(StatementLine s2);
+
   private:
-    SolverPtr _follows_star_solver;
     StatementTable *_statement_table;
+    IdRelation _relation;
 };
 
 }
\ No newline at end of file
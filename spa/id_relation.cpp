@@ -0,0 +1,60 @@
+#include "spa/id_relation.h"
+
+namespace spa {
+
+using namespace simple;
+
+IdRelation::IdRelation(SolverPtr solver, 
+    IdDomain *left_domain, IdDomain *right_domain) :
+    _solver(solver), _left_domain(left_domain), _right_domain(right_domain)
+{ }
+
+IdSpan IdRelation::get_rights(int left) {
+    return get_row(_rights, left, true);
+}
+
+IdSpan IdRelation::get_lefts(int right) {
+    return get_row(_lefts, right, false);
+}
+
+bool IdRelation::holds(int left, int right) {
+    return get_rights(left).contains(right);
+}
+
+/*
+ * The conditions the solver returns outside of the other domain, such 
+ * as procedures for a relation on statements, are left out.
+ */
+IdSpan IdRelation::get_row(Rows& rows, int id, bool right) {
+    IdDomain *domain = right ? _left_domain : _right_domain;
+    IdDomain *other_domain = right ? _right_domain : _left_domain;
+
+    domain->check_id(id);
+
+    if(rows.solved.empty()) {
+        rows.ids.resize(domain->get_id_count());
+        rows.solved.resize(domain->get_id_count(), false);
+    }
+
+    std::vector<int>& row = rows.ids[id];
+
+    if(!rows.solved[id]) {
+        ConditionPtr condition = domain->get_id_condition(id);
+        ConditionSet result = right ? 
+            _solver->solve_right(condition.get()) :
+            _solver->solve_left(condition.get());
+
+        for(auto it = result.begin(); it != result.end(); ++it) {
+            int other_id = other_domain->get_condition_id(*it);
+            if(other_id != -1) row.push_back(other_id);
+        }
+
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+        rows.solved[id] = true;
+    }
+
+    return IdSpan(row.data(), row.data() + row.size());
+}
+
+}
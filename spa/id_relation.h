@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include "simple/condition_set.h"
+#include "simple/solver.h"
+
+namespace spa {
+
+using namespace simple;
+
+/*
+ * A sorted run of dense IDs, pointing into a relation index. It stays
+ * valid for as long as the PKB that handed it out.
+ */
+struct IdSpan {
+    IdSpan() : begin(NULL), end(NULL) { }
+
+    IdSpan(const int *begin, const int *end) : 
+        begin(begin), end(end) 
+    { }
+
+    bool empty() const { return begin == end; }
+    size_t size() const { return end - begin; }
+
+    bool contains(int id) const {
+        return std::binary_search(begin, end, id);
+    }
+
+    const int *begin;
+    const int *end;
+};
+
+/*
+ * IdDomain maps the entities of one kind to dense IDs in the range
+ * [0, get_id_count()), and back to the conditions the solvers take.
+ */
+class IdDomain {
+  public:
+    virtual size_t get_id_count() = 0;
+
+    /*
+     * Throw if the ID is not in the domain.
+     */
+    virtual void check_id(int id) = 0;
+
+    virtual ConditionPtr get_id_condition(int id) = 0;
+
+    /*
+     * The ID of a condition, or -1 if it is not in the domain.
+     */
+    virtual int get_condition_id(SimpleCondition *condition) = 0;
+
+    virtual ~IdDomain() { }
+};
+
+/*
+ * IdRelation is a relation between the IDs of two domains, read from a
+ * solver. The row of an ID is solved the first time it is asked for and
+ * kept sorted, so that every later lookup is an array access with no
+ * allocation.
+ */
+class IdRelation {
+  public:
+    IdRelation(SolverPtr solver, IdDomain *left_domain, IdDomain *right_domain);
+
+    IdSpan get_rights(int left);
+    IdSpan get_lefts(int right);
+
+    bool holds(int left, int right);
+
+  private:
+    struct Rows {
+        std::vector< std::vector<int> >     ids;
+        std::vector<bool>                   solved;
+    };
+
+    IdSpan get_row(Rows& rows, int id, bool right);
+
+    SolverPtr   _solver;
+    IdDomain    *_left_domain;
+    IdDomain    *_right_domain;
+
+    Rows        _rights;
+    Rows        _lefts;
+};
+
+}
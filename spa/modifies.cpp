@@ -4,47 +4,67 @@
 namespace spa {
 
 using namespace simple;
-using namespace simple::impl;
 
 Modifies::Modifies(SolverPtr modifies_solver, AST *ast) :
-  _modifies_solver(modifies_solver), _ast(ast)
+  _ast(ast),
+  _statement_relation(modifies_solver, 
+      ast->get_statement_table(), ast->get_var_table()),
+  _proc_relation(modifies_solver, 
+      ast->get_proc_table(), ast->get_var_table())
 { }
 
 bool Modifies::validate_modifies(StatementLine s, Var v) {
-    SimpleStatementCondition c1(_ast->get_statement(s));
+    _ast->get_statement_table()->check_id(s);
 
-    SimpleVariableCondition c2(v);
-
-    return _modifies_solver->validate(&c1, &c2);
+    int var_id = _ast->get_var_table()->getVarIndex(v);
+    return var_id != -1 && _statement_relation.holds(s, var_id);
 }
 
 bool Modifies::validate_modifies(Proc p, Var v) {
-    SimpleProcCondition c1(_ast->get_proc(p));
-
-    SimpleVariableCondition c2(v);
+    int proc_id = _ast->get_proc_id(p);
 
-    return _modifies_solver->validate(&c1, &c2);
+    int var_id = _ast->get_var_table()->getVarIndex(v);
+    return var_id != -1 && _proc_relation.holds(proc_id, var_id);
 }
 
 VarResults Modifies::get_modified_var(StatementLine s) {
-    SimpleStatementCondition c1(_ast->get_statement(s));
-    
-    ConditionSet result = _modifies_solver->solve_right(&c1);
-    return condition_to_variable_results(result);
+    return _ast->get_var_table()->get_vars(get_modified_var_ids(s));
 }
 
 VarResults Modifies::get_modified_var(Proc p) {
-    SimpleProcCondition c1(_ast->get_proc(p));
-    
-    ConditionSet result = _modifies_solver->solve_right(&c1);
-    return condition_to_variable_results(result);
+    return _ast->get_var_table()->get_vars(
+        get_proc_modified_var_ids(_ast->get_proc_id(p)));
 }
 
 StatementResults Modifies::get_modifiying_statements(Var v) {
-    SimpleVariableCondition c2(v);
-    
-    ConditionSet result = _modifies_solver->solve_left(&c2);
-    return condition_to_statement_results(result);
+    int var_id = _ast->get_var_table()->getVarIndex(v);
+    if(var_id == -1) return StatementResults();
+
+    IdSpan result = get_modifying_statement_ids(var_id);
+    return StatementResults(result.begin, result.end);
+}
+
+ProcResults Modifies::get_modifiying_procs(Var v) {
+    int var_id = _ast->get_var_table()->getVarIndex(v);
+    if(var_id == -1) return ProcResults();
+
+    return _ast->get_proc_table()->get_proc_names(get_modifying_proc_ids(var_id));
+}
+
+IdSpan Modifies::get_modified_var_ids(StatementLine s) {
+    return _statement_relation.get_rights(s);
+}
+
+IdSpan Modifies::get_proc_modified_var_ids(int proc_id) {
+    return _proc_relation.get_rights(proc_id);
+}
+
+IdSpan Modifies::get_modifying_statement_ids(int var_id) {
+    return _statement_relation.get_lefts(var_id);
+}
+
+IdSpan Modifies::get_modifying_proc_ids(int var_id) {
+    return _proc_relation.get_lefts(var_id);
 }
 
 }
\ No newline at end of file
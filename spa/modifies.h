@@ -6,6 +6,7 @@
 #include "impl/condition.h"
 #include "spa/ast.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -24,9 +25,16 @@ class Modifies {
     StatementResults get_modifiying_statements(Var v);
     ProcResults get_modifiying_procs(Var v);
 
+    IdSpan get_modified_var_ids(StatementLine s);
+    IdSpan get_proc_modified_var_ids(int proc_id);
+
+    IdSpan get_modifying_statement_ids(int var_id);
+    IdSpan get_modifying_proc_ids(int var_id);
+
   private:
-    SolverPtr _modifies_solver;
     AST *_ast;
+    IdRelation _statement_relation;
+    IdRelation _proc_relation;
 };
 
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "simple/solver.h"
 #include "impl/condition.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -20,9 +21,13 @@ class NextStar {
 
     StatementResults get_prev_star(StatementLine s2);
 
+    IdSpan get_next_star_ids(StatementLine s1);
+
+    IdSpan get_prev_star_ids(StatementLine s2);
+
   private:
-    SolverPtr _next_star_solver;
     StatementTable *_statement_table;
+    IdRelation _relation;
 };
 
 }
\ No newline at end of file
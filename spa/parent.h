@@ -5,6 +5,7 @@
 #include "simple/solver.h"
 #include "impl/condition.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -21,9 +22,13 @@ class Parent {
 
     StatementResults get_parent(StatementLine s2);
 
+    IdSpan get_children_ids(StatementLine s1);
+
+    IdSpan get_parent_ids(StatementLine s2);
+
   private:
-    SolverPtr _parent_solver;
     StatementTable *_statement_table;
+    IdRelation _relation;
 };
 
 }
\ No newline at end of file
@@ -28,6 +28,18 @@ AST* PKB::get_ast(){
     return &_spa_ast;
 }
 
+StatementTable* PKB::get_statement_table() {
+    return &_statement_table;
+}
+
+VarTable* PKB::get_var_table() {
+    return _spa_ast.get_var_table();
+}
+
+ProcTable* PKB::get_proc_table() {
+    return _spa_ast.get_proc_table();
+}
+
 Follows* PKB::get_follows() {
     return &_follows;
 }
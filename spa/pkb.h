@@ -29,6 +29,15 @@ class PKB {
 
     AST* get_ast();
 
+    /*
+     * The ID tables of the relations below. Statement IDs are the
+     * statement lines, and variables and procedures are numbered in name
+     * order.
+     */
+    StatementTable* get_statement_table();
+    VarTable* get_var_table();
+    ProcTable* get_proc_table();
+
     Follows* get_follows();
     FollowsStar* get_follows_star();
     
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include "impl/condition.h"
+#include "simple/util/condition_utils.h"
+#include "spa/proc_table.h"
+
+namespace spa {
+
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::util;
+
+namespace {
+
+bool is_proc_name_less(ProcAst *proc1, ProcAst *proc2) {
+    return proc1->get_name() < proc2->get_name();
+}
+
+}
+
+ProcTable::ProcTable(SimpleRoot ast) {
+    for(auto it = ast.begin(); it != ast.end(); ++it) {
+        _procs.push_back(*it);
+    }
+
+    std::sort(_procs.begin(), _procs.end(), is_proc_name_less);
+
+    for(size_t id = 0; id < _procs.size(); ++id) {
+        _ids.insert(_procs[id]->get_name(), id);
+    }
+}
+
+int ProcTable::get_proc_id(const Proc& name) {
+    const int *id = _ids.find(name);
+    return id != NULL ? *id : -1;
+}
+
+Proc ProcTable::get_proc_name(int id) {
+    return get_proc(id)->get_name();
+}
+
+ProcAst* ProcTable::get_proc(int id) {
+    check_id(id);
+    return _procs[id];
+}
+
+ProcResults ProcTable::get_proc_names(IdSpan ids) {
+    ProcResults result;
+    for(const int *it = ids.begin; it != ids.end; ++it) {
+        result.insert(result.end(), _procs[*it]->get_name());
+    }
+    return result;
+}
+
+size_t ProcTable::get_id_count() {
+    return _procs.size();
+}
+
+void ProcTable::check_id(int id) {
+    if(id < 0 || id >= (int) _procs.size()) {
+        throw std::out_of_range("Invalid procedure index");
+    }
+}
+
+ConditionPtr ProcTable::get_id_condition(int id) {
+    return new SimpleProcCondition(get_proc(id));
+}
+
+int ProcTable::get_condition_id(SimpleCondition *condition) {
+    ProcCondition *proc_condition = condition_cast<ProcCondition>(condition);
+    if(proc_condition == NULL) return -1;
+
+    return get_proc_id(proc_condition->get_proc_ast()->get_name());
+}
+
+}
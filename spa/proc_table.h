@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include "simple/ast.h"
+#include "simple/util/relation_index.h"
+#include "spa/types.h"
+#include "spa/id_relation.h"
+
+namespace spa {
+
+using namespace simple;
+using namespace simple::util;
+
+/*
+ * ProcTable gives the procedures of a program dense IDs in name order.
+ */
+class ProcTable : public IdDomain {
+  public:
+    ProcTable(SimpleRoot ast);
+
+    /*
+     * The ID of a procedure, or -1 if there is none by the name.
+     */
+    int get_proc_id(const Proc& name);
+
+    Proc get_proc_name(int id);
+    ProcAst* get_proc(int id);
+
+    ProcResults get_proc_names(IdSpan ids);
+
+    size_t get_id_count();
+    void check_id(int id);
+    ConditionPtr get_id_condition(int id);
+    int get_condition_id(SimpleCondition *condition);
+
+  private:
+    std::vector<ProcAst*>   _procs;
+    HashIndex<Proc, int>    _ids;
+};
+
+}
@@ -1,25 +1,57 @@
 
+#include <algorithm>
+#include "impl/condition.h"
 #include "spa/statement.h"
 
 namespace spa {
 
 using namespace simple;
+using namespace simple::impl;
 using namespace simple::util;
 
-StatementTable::StatementTable(LineTable table) :
-  _table(table)
-{ }
+StatementTable::StatementTable(LineTable table) {
+    int line_count = table.empty() ? 0 : table.rbegin()->first + 1;
+    _statements.resize(std::max(line_count, 0), NULL);
+
+    for(auto it = table.begin(); it != table.end(); ++it) {
+        if(it->first >= 0) _statements[it->first] = it->second;
+    }
+}
 
 bool StatementTable::is_valid_statement(StatementLine line) {
-    return _table.count(line) != 0;
+    return line >= 0 && line < (int) _statements.size() && 
+        _statements[line] != NULL;
 }
 
 StatementAst* StatementTable::get_statement(StatementLine line) {
-    if(!is_valid_statement(line)) {
+    check_id(line);
+    return _statements[line];
+}
+
+size_t StatementTable::get_id_count() {
+    return _statements.size();
+}
+
+void StatementTable::check_id(int id) {
+    if(!is_valid_statement(id)) {
         throw std::runtime_error("Invalid statement line");
     }
+}
+
+ConditionPtr StatementTable::get_id_condition(int id) {
+    return new SimpleStatementCondition(get_statement(id));
+}
+
+int StatementTable::get_condition_id(SimpleCondition *condition) {
+    StatementCondition *statement_condition = 
+        condition_cast<StatementCondition>(condition);
+    if(statement_condition == NULL) return -1;
+
+    StatementAst *statement = statement_condition->get_statement_ast();
+    int line = statement->get_statement_line();
 
-    return _table[line];
+    return is_valid_statement(line) && _statements[line] == statement ? 
+        line : -1;
 }
 
 StatementResults condition_to_statement_results(const ConditionSet& conditions) {
@@ -2,19 +2,26 @@
 #pragma once
 
 #include <set>
+#include <vector>
 #include <memory>
 #include <stdexcept>
 #include "simple/ast.h"
 #include "simple/condition_set.h"
 #include "simple/util/condition_utils.h"
 #include "spa/types.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
 using namespace simple;
 using namespace simple::util;
 
-class StatementTable {
+/*
+ * StatementTable maps statement lines to statements. The ID of a 
+ * statement is its line, and the statements are kept in an array 
+ * indexed by line.
+ */
+class StatementTable : public IdDomain {
   public:
     StatementTable(LineTable table);
 
@@ -22,8 +29,13 @@ class StatementTable {
 
     StatementAst* get_statement(StatementLine line);
 
+    size_t get_id_count();
+    void check_id(int id);
+    ConditionPtr get_id_condition(int id);
+    int get_condition_id(SimpleCondition *condition);
+
   private:
-    LineTable _table;
+    std::vector<StatementAst*> _statements;
 };
 
 StatementResults condition_to_statement_results(const ConditionSet& conditions);
@@ -6,6 +6,7 @@
 #include "impl/condition.h"
 #include "spa/ast.h"
 #include "spa/statement.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
@@ -22,11 +23,18 @@ class Uses {
     VarResults get_used_vars(Proc p);
 
     StatementResults get_using_statements(Var v);
-    //ProcResults get_using_procs(Var v);
+    ProcResults get_using_procs(Var v);
+
+    IdSpan get_used_var_ids(StatementLine s);
+    IdSpan get_proc_used_var_ids(int proc_id);
+
+    IdSpan get_using_statement_ids(int var_id);
+    IdSpan get_using_proc_ids(int var_id);
 
   private:
-    SolverPtr _uses_solver;
     AST *_ast;
+    IdRelation _statement_relation;
+    IdRelation _proc_relation;
 };
 
 }
\ No newline at end of file
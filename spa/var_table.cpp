@@ -1,29 +1,61 @@
 
-#include <iterator>
+#include "impl/condition.h"
+#include "simple/util/condition_utils.h"
 #include "spa/var_table.h"
 
 namespace spa {
 
-VarTable::VarTable(VariableSet variables) :
-    _variables(variables), 
-    _begin(_variables.begin()),
-    _end(_variables.end())
-{ }
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::util;
+
+VarTable::VarTable(VariableSet variables) {
+    for(auto it = variables.begin(); it != variables.end(); ++it) {
+        Var name = const_cast<SimpleVariable&>(*it).get_name();
+
+        _ids.insert(name, _names.size());
+        _names.push_back(name);
+    }
+}
 
 int VarTable::getVarIndex(Var var) {
-    VarIterator it = _variables.find(var);
-    if(it == _end) return -1;
-    return std::distance(it, _begin);
+    const int *id = _ids.find(var);
+    return id != NULL ? *id : -1;
 }
 
 Var VarTable::getVarFromIndex(int index) {
-    if(index < 0) throw std::out_of_range("Invalid var index");
+    check_id(index);
+    return _names[index];
+}
+
+VarResults VarTable::get_vars(IdSpan ids) {
+    VarResults result;
+    for(const int *it = ids.begin; it != ids.end; ++it) {
+        result.insert(result.end(), _names[*it]);
+    }
+    return result;
+}
+
+size_t VarTable::get_id_count() {
+    return _names.size();
+}
+
+void VarTable::check_id(int id) {
+    if(id < 0 || id >= (int) _names.size()) {
+        throw std::out_of_range("Invalid var index");
+    }
+}
+
+ConditionPtr VarTable::get_id_condition(int id) {
+    check_id(id);
+    return new SimpleVariableCondition(SimpleVariable(_names[id]));
+}
 
-    VarIterator it = _variables.begin();
-    std::advance(it, index);
-    if(it == _end) throw std::out_of_range("Invalid var index");
+int VarTable::get_condition_id(SimpleCondition *condition) {
+    VariableCondition *var_condition = condition_cast<VariableCondition>(condition);
+    if(var_condition == NULL) return -1;
 
-    return *it;
+    return getVarIndex(var_condition->get_variable()->get_name());
 }
 
 }
\ No newline at end of file
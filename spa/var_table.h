@@ -1,28 +1,40 @@
 
 #pragma once
 
+#include <vector>
 #include <stdexcept>
 #include "simple/condition_set.h"
+#include "simple/util/relation_index.h"
 #include "spa/types.h"
+#include "spa/id_relation.h"
 
 namespace spa {
 
 using namespace simple;
+using namespace simple::util;
 
-class VarTable {
+/*
+ * VarTable gives the variables of a program dense IDs in name order.
+ * Both directions are a single lookup.
+ */
+class VarTable : public IdDomain {
   public:
-    typedef VariableSet::iterator VarIterator;
-
     VarTable(VariableSet variables);
 
     int getVarIndex(Var var);
 
     Var getVarFromIndex(int index);
 
+    VarResults get_vars(IdSpan ids);
+
+    size_t get_id_count();
+    void check_id(int id);
+    ConditionPtr get_id_condition(int id);
+    int get_condition_id(SimpleCondition *condition);
+
   private:
-    VariableSet _variables;
-    VarIterator _begin;
-    VarIterator _end;
+    std::vector<Var>        _names;
+    HashIndex<Var, int>     _ids;
 };
 
 }
\ No newline at end of file
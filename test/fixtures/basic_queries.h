@@ -54,6 +54,53 @@ std::vector<PqlTestFixture> get_basic_test_fixtures() {
 
     fixture1.queries.push_back(query12);
 
+    PqlQueryFixture query13;
+    query13.query =
+        "assign a; constant c; \n"
+        "Select a with a.stmt# = c.value;";
+    query13.expected.push_back("1");
+
+    fixture1.queries.push_back(query13);
+
+    PqlQueryFixture query14;
+    query14.query =
+        "stmt s; assign a; \n"
+        "Select a such that Follows(a, s) with s.stmt# = 2;";
+    query14.expected.push_back("1");
+
+    fixture1.queries.push_back(query14);
+
+    PqlQueryFixture query15;
+    query15.query =
+        "stmt s; \n"
+        "Select s such that Follows*(1, s) with s.stmt# = 2 and s.stmt# = 7;";
+
+    fixture1.queries.push_back(query15);
+
+    PqlQueryFixture query16;
+    query16.query =
+        "stmt s; \n"
+        "Select BOOLEAN such that Follows(1, s) with 7 = s.stmt#;";
+    query16.expected.push_back("false");
+
+    fixture1.queries.push_back(query16);
+
+    PqlQueryFixture query17;
+    query17.query =
+        "call c; \n"
+        "Select c.procName;";
+    query17.expected.push_back("test2");
+
+    fixture1.queries.push_back(query17);
+
+    PqlQueryFixture query18;
+    query18.query =
+        "assign a; stmt s; \n"
+        "Select <a, s> such that Follows(a, s) with s.stmt# = 2;";
+    query18.expected.push_back("1 2");
+
+    fixture1.queries.push_back(query18);
+
     fixtures.push_back(fixture1);
 
     return fixtures;
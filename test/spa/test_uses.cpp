@@ -611,6 +611,48 @@ TEST (UsesTest, MultipleVariables_IfNestedWhileInside) {
  	EXPECT_TRUE(uses.validate_uses("First", "e"));
  	//TO BE COMPLETED
 }
+TEST (UsesTest, IdSpans) {
+	/*
+	 * Meant to build this SIMPLE program
+	 * procedure First {
+	 * x = 1;
+	 * y = x + 1;
+	 * x = y + x;}
+	 */
+	AST *ast = uses_fixture_3();
+
+	SolverPtr uses_solver(new SimpleSolverGenerator<UsesSolver>(
+		new UsesSolver(ast->get_root())));
+	Uses uses(uses_solver, ast);
+
+	VarTable *var_table = ast->get_var_table();
+	int x = var_table->getVarIndex("x");
+	int y = var_table->getVarIndex("y");
+	EXPECT_EQ(0, x);
+	EXPECT_EQ(1, y);
+	EXPECT_EQ(-1, var_table->getVarIndex("z"));
+	EXPECT_EQ("y", var_table->getVarFromIndex(y));
+
+	IdSpan statements = uses.get_using_statement_ids(x);
+	ASSERT_EQ((size_t) 2, statements.size());
+	EXPECT_EQ(2, statements.begin[0]);
+	EXPECT_EQ(3, statements.begin[1]);
+
+	IdSpan vars = uses.get_used_var_ids(3);
+	ASSERT_EQ((size_t) 2, vars.size());
+	EXPECT_TRUE(vars.contains(x));
+	EXPECT_TRUE(vars.contains(y));
+	EXPECT_TRUE(uses.get_used_var_ids(1).empty());
+
+	int first = ast->get_proc_id("First");
+	EXPECT_EQ((size_t) 2, uses.get_proc_used_var_ids(first).size());
+	EXPECT_TRUE(uses.get_using_proc_ids(y).contains(first));
+
+	EXPECT_FALSE(uses.validate_uses(3, "z"));
+	EXPECT_TRUE(uses.get_using_statements("z").empty());
+	EXPECT_THROW(uses.get_used_var_ids(4), std::exception);
+}
+
 #if 0
 TEST (UsesTest, MultipleVariables_MultipleProcedure_SingleVariable) {
 	/*
@@ -0,0 +1,184 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "simple/ast.h"
+#include "simple/util/ast_utils.h"
+#include "impl/ast.h"
+#include "impl/condition.h"
+#include "impl/solvers/next.h"
+#include "impl/solvers/next_bip.h"
+#include "impl/solvers/affects_bip.h"
+#include "impl/solvers/call.h"
+#include "impl/parser/parser.h"
+#include "impl/parser/iterator_tokenizer.h"
+
+namespace simple {
+namespace test {
+
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::util;
+using namespace simple::parser;
+
+TEST(AffectsBipTest, SummaryTest) {
+    /*
+     * proc test1 {
+     *   x = 1;
+     *   call test2;
+     *   y = x;
+     * }
+     *
+     * proc test2 {
+     *   z = x;
+     *   x = z;
+     * }
+     */
+    SimpleProcAst *proc1 = new SimpleProcAst("test1");
+    SimpleProcAst *proc2 = new SimpleProcAst("test2");
+
+    SimpleVariable var_x("x");
+    SimpleVariable var_y("y");
+    SimpleVariable var_z("z");
+
+    SimpleAssignmentAst *stat1 = new SimpleAssignmentAst();
+    stat1->set_variable(var_x);
+    stat1->set_expr(new SimpleConstAst(1));
+    set_proc(stat1, proc1);
+
+    SimpleCallAst *call = new SimpleCallAst();
+    call->set_proc_called(proc2);
+    set_next(stat1, call);
+
+    SimpleAssignmentAst *stat2 = new SimpleAssignmentAst();
+    stat2->set_variable(var_y);
+    stat2->set_expr(new SimpleVariableAst(var_x));
+    set_next(call, stat2);
+
+    SimpleAssignmentAst *stat3 = new SimpleAssignmentAst();
+    stat3->set_variable(var_z);
+    stat3->set_expr(new SimpleVariableAst(var_x));
+    set_proc(stat3, proc2);
+
+    SimpleAssignmentAst *stat4 = new SimpleAssignmentAst();
+    stat4->set_variable(var_x);
+    stat4->set_expr(new SimpleVariableAst(var_z));
+    set_next(stat3, stat4);
+
+    std::vector<ProcAst*> procs;
+    procs.push_back(proc1);
+    procs.push_back(proc2);
+
+    SimpleRoot root(procs.begin(), procs.end());
+
+    std::shared_ptr<NextSolver> next_solver(new NextSolver(root));
+    std::shared_ptr<CallSolver> calls_solver(new CallSolver(root));
+    std::shared_ptr<NextBipSolver> next_bip_solver(
+        new NextBipSolver(root, next_solver, calls_solver));
+
+    AffectsBipSolver solver(next_bip_solver, false);
+    AffectsBipSolver transitive_solver(next_bip_solver, true);
+
+    StatementSet stat1_affected;
+    stat1_affected.insert(stat3);
+    EXPECT_EQ(solver.solve_affected_statements(stat1), stat1_affected);
+
+    StatementSet stat4_affected;
+    stat4_affected.insert(stat2);
+    EXPECT_EQ(solver.solve_affected_statements(stat4), stat4_affected);
+
+    StatementSet stat2_affecting;
+    stat2_affecting.insert(stat4);
+    EXPECT_EQ(solver.solve_affecting_statements(stat2), stat2_affecting);
+
+    EXPECT_TRUE((solver.validate<StatementAst, StatementAst>(stat3, stat4)));
+    EXPECT_FALSE((solver.validate<StatementAst, StatementAst>(stat1, stat2)));
+    EXPECT_FALSE(solver.has_right<StatementAst>(stat2));
+    EXPECT_FALSE(solver.has_left<StatementAst>(stat1));
+
+    StatementSet stat1_iaffected;
+    stat1_iaffected.insert(stat3);
+    stat1_iaffected.insert(stat4);
+    stat1_iaffected.insert(stat2);
+    EXPECT_EQ(transitive_solver.solve_affected_statements(stat1), stat1_iaffected);
+
+    StatementSet stat2_iaffecting;
+    stat2_iaffecting.insert(stat4);
+    stat2_iaffecting.insert(stat3);
+    stat2_iaffecting.insert(stat1);
+    EXPECT_EQ(transitive_solver.solve_affecting_statements(stat2), stat2_iaffecting);
+}
+
+TEST(AffectsBipTest, DirectionTest) {
+    std::string source =
+        "procedure p0 { \n"
+        "   d = 1 - d * a; \n"
+        "   z = y * z - x - a; \n"
+        "   call p1; \n"
+        "   call p1; } \n"
+        "procedure p1 { \n"
+        "   b = z + d - 1; \n"
+        "   if c then { \n"
+        "       y = y; \n"
+        "       d = a; \n"
+        "       d = d - x + 4 + 4; } \n"
+        "   else { \n"
+        "       z = x; } } \n";
+
+    SimpleParser parser(new IteratorTokenizer<std::string::iterator>(
+        source.begin(), source.end()));
+    SimpleRoot root = parser.parse_program();
+    LineTable lines = parser.get_statement_line_table();
+
+    std::shared_ptr<NextSolver> next_solver(new NextSolver(root));
+    std::shared_ptr<CallSolver> calls_solver(new CallSolver(root));
+    std::shared_ptr<NextBipSolver> next_bip_solver(
+        new NextBipSolver(root, next_solver, calls_solver));
+
+    AffectsBipSolver solver(next_bip_solver, false);
+    AffectsBipSolver transitive_solver(next_bip_solver, true);
+
+    /*
+     * Line 9 reaches line 5 through the return from the first call to p1
+     * and the second call.
+     */
+    StatementSet stat5_affecting;
+    stat5_affecting.insert(lines[1]);
+    stat5_affecting.insert(lines[2]);
+    stat5_affecting.insert(lines[9]);
+    stat5_affecting.insert(lines[10]);
+    EXPECT_EQ(solver.solve_affecting_statements(lines[5]), stat5_affecting);
+
+    AffectsBipSolver *solvers[] = { &solver, &transitive_solver };
+
+    for(int i = 0; i < 2; ++i) {
+        for(auto it = lines.begin(); it != lines.end(); ++it) {
+            StatementSet affected = 
+                solvers[i]->solve_affected_statements(it->second);
+
+            for(auto it2 = lines.begin(); it2 != lines.end(); ++it2) {
+                EXPECT_EQ(affected.count(it2->second),
+                    solvers[i]->solve_affecting_statements(
+                        it2->second).count(it->second));
+            }
+        }
+    }
+}
+
+}
+}
@@ -183,5 +183,46 @@ TEST(ConditionTest, ConditionSetTest) {
     EXPECT_EQ(set3.get_size(), (size_t) 1);
 }
 
+TEST(ConditionTest, SharedSetTest) {
+    SimpleAssignmentAst statement1, statement2, statement3;
+
+    ConditionPtr condition1(new SimpleStatementCondition(&statement1));
+    ConditionPtr condition2(new SimpleStatementCondition(&statement2));
+    ConditionPtr condition3(new SimpleStatementCondition(&statement3));
+
+    ConditionSet set1;
+    set1.insert(condition1);
+    set1.insert(condition2);
+
+    ConditionSet set2 = set1;
+    set2.insert(condition3);
+
+    EXPECT_EQ(set1.get_size(), (size_t) 2);
+    EXPECT_EQ(set2.get_size(), (size_t) 3);
+
+    ConditionSet set3 = set2;
+    set3.intersect_with(set1);
+
+    EXPECT_EQ(set3, set1);
+    EXPECT_EQ(set2.get_size(), (size_t) 3);
+
+    ConditionSet set4 = set1;
+    set4.remove(condition1);
+    set4.union_with(ConditionSet(condition3));
+
+    EXPECT_TRUE(set1.has_element(condition1));
+    EXPECT_FALSE(set1.has_element(condition3));
+    EXPECT_FALSE(set4.has_element(condition1));
+    EXPECT_TRUE(set4.has_element(condition3));
+
+    ConditionSet set5 = set2.difference_with(set1);
+    EXPECT_EQ(set5, ConditionSet(condition3));
+
+    set1.clear();
+    EXPECT_TRUE(set1.is_empty());
+    EXPECT_EQ(set2.get_size(), (size_t) 3);
+    EXPECT_EQ(set1.begin(), set1.end());
+}
+
 }
 }
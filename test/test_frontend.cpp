@@ -17,6 +17,7 @@
  */
 
 #include <iterator>
+#include <algorithm>
 #include "gtest/gtest.h"
 #include "impl/frontend.h"
 #include "test/fixture.h"
@@ -66,6 +67,242 @@ TEST(FrontEndTest, IntegratedTest) {
     EXPECT_EQ(result2[1], "c");
 }
 
+TEST(FrontEndTest, BooleanBipTest) {
+    std::string source =
+        "procedure test1 { \n"
+        "   call test2; \n"
+        "   call test2; } \n"
+        "procedure test2 { \n"
+        "   b = d; \n"
+        "   x = 1; \n"
+        "   if c then { \n"
+        "       y = 1; \n"
+        "       d = 2; } \n"
+        "   else { \n"
+        "       z = 3; } } \n";
+
+    SimplePqlFrontEnd frontend(source.begin(), source.end());
+
+    /*
+     * Line 3 is only affected by line 7, through the return from the
+     * first call and the second call. Follows* binds a2 first, so the
+     * search checks AffectsBip with only a1 unbound.
+     */
+    std::string queries[] = {
+        "assign a1, a2; \n"
+        "Select BOOLEAN such that AffectsBip(a1, a2) and Follows*(a2, 5);",
+
+        "assign a1, a2; \n"
+        "Select BOOLEAN such that AffectsBip*(a1, a2) and Follows*(a2, 5);",
+
+        "assign a1, a2; \n"
+        "Select <a1, a2> such that AffectsBip*(a1, a2) and Follows*(a2, 5);"
+    };
+
+    std::vector<std::string> result1 = frontend.process_query(
+        queries[0].begin(), queries[0].end());
+    ASSERT_EQ((int)result1.size(), 1);
+    EXPECT_EQ(result1[0], "true");
+
+    std::vector<std::string> result2 = frontend.process_query(
+        queries[1].begin(), queries[1].end());
+    ASSERT_EQ((int)result2.size(), 1);
+    EXPECT_EQ(result2[0], "true");
+
+    std::vector<std::string> result3 = frontend.process_query(
+        queries[2].begin(), queries[2].end());
+    ASSERT_EQ((int)result3.size(), 1);
+    EXPECT_EQ(result3[0], "7 3");
+}
+
+TEST(FrontEndTest, ReloadTest) {
+    std::string source1 = 
+        "procedure test1 { \n"
+        "   a = 1; \n"
+        "   call test2; \n"
+        "   b = a; } \n"
+        "procedure test2 { \n"
+        "   c = 3; } \n";
+
+    std::string source2 = 
+        "procedure test1 { \n"
+        "   a = 1; \n"
+        "   call test2; \n"
+        "   b = a; } \n"
+        "procedure test2 { \n"
+        "   c = 3; \n"
+        "   d = c; } \n";
+
+    std::string source3 = 
+        "procedure test1 { \n"
+        "   x = 0; \n"
+        "   a = 1; \n"
+        "   call test2; \n"
+        "   b = a; } \n"
+        "procedure test2 { \n"
+        "   c = 3; \n"
+        "   d = c; } \n";
+
+    SimplePqlFrontEnd frontend(source1.begin(), source1.end());
+
+    std::string query1 = 
+        "var v; \n"
+        "Select v such that Modifies(2, v);";
+
+    std::vector<std::string> result1 = frontend.process_query(
+        query1.begin(), query1.end());
+
+    EXPECT_EQ((int)result1.size(), 1);
+    EXPECT_EQ(result1[0], "c");
+
+    EXPECT_FALSE(frontend.reload_source(source1.begin(), source1.end()));
+    EXPECT_TRUE(frontend.reload_source(source2.begin(), source2.end()));
+
+    std::map<int, int> mapping2;
+    mapping2[1] = 1;
+    mapping2[2] = 2;
+    mapping2[3] = 3;
+    EXPECT_EQ(frontend.get_line_mapping(), mapping2);
+
+    std::vector<std::string> result2 = frontend.process_query(
+        query1.begin(), query1.end());
+
+    EXPECT_EQ((int)result2.size(), 2);
+    EXPECT_EQ(result2[0], "c");
+    EXPECT_EQ(result2[1], "d");
+
+    EXPECT_TRUE(frontend.reload_source(source3.begin(), source3.end()));
+
+    std::map<int, int> mapping3;
+    mapping3[4] = 5;
+    mapping3[5] = 6;
+    EXPECT_EQ(frontend.get_line_mapping(), mapping3);
+
+    std::string query2 = 
+        "stmt s; \n"
+        "Select s such that Follows(5, s);";
+
+    std::vector<std::string> result3 = frontend.process_query(
+        query2.begin(), query2.end());
+
+    EXPECT_EQ((int)result3.size(), 1);
+    EXPECT_EQ(result3[0], "6");
+
+    std::string broken = "procedure test1 { a = ; }";
+    EXPECT_ANY_THROW(frontend.reload_source(broken.begin(), broken.end()));
+
+    std::vector<std::string> result4 = frontend.process_query(
+        query2.begin(), query2.end());
+
+    EXPECT_EQ(result4, result3);
+}
+
+TEST(FrontEndTest, ReloadPatchTest) {
+    std::string source1 = 
+        "procedure main { \n"
+        "   x = 1; \n"
+        "   call first; \n"
+        "   while x { \n"
+        "       y = x; } } \n"
+        "procedure first { \n"
+        "   call second; \n"
+        "   if y then { \n"
+        "       z = y; } \n"
+        "   else { \n"
+        "       call second; } } \n"
+        "procedure second { \n"
+        "   w = z; } \n"
+        "procedure other { \n"
+        "   v = 2; } \n";
+
+    std::string source2 = 
+        "procedure main { \n"
+        "   x = 1; \n"
+        "   call first; \n"
+        "   while x { \n"
+        "       y = x; } } \n"
+        "procedure first { \n"
+        "   call second; \n"
+        "   if y then { \n"
+        "       z = y; } \n"
+        "   else { \n"
+        "       call second; } } \n"
+        "procedure second { \n"
+        "   u = w; \n"
+        "   while u { \n"
+        "       call other; \n"
+        "       t = u; } } \n"
+        "procedure other { \n"
+        "   v = 2; } \n";
+
+    std::string source3 = 
+        "procedure main { \n"
+        "   x = 1; \n"
+        "   while x { \n"
+        "       y = x; } } \n"
+        "procedure first { \n"
+        "   call second; \n"
+        "   if y then { \n"
+        "       z = y; } \n"
+        "   else { \n"
+        "       call second; } } \n"
+        "procedure second { \n"
+        "   u = w; \n"
+        "   while u { \n"
+        "       call other; \n"
+        "       t = u; } } \n"
+        "procedure other { \n"
+        "   v = 2; } \n";
+
+    const char *queries[] = {
+        "stmt s; variable v; Select <s, v> such that Modifies(s, v)",
+        "stmt s; variable v; Select <s, v> such that Uses(s, v)",
+        "procedure p; variable v; Select <p, v> such that Modifies(p, v)",
+        "procedure p; variable v; Select <p, v> such that Uses(p, v)",
+        "procedure p, q; Select <p, q> such that Calls(p, q)",
+        "procedure p, q; Select <p, q> such that Calls*(p, q)",
+        "stmt s1, s2; Select <s1, s2> such that Follows(s1, s2)",
+        "stmt s1, s2; Select <s1, s2> such that Parent*(s1, s2)",
+        "prog_line n1, n2; Select <n1, n2> such that Next(n1, n2)",
+        "assign a1, a2; Select <a1, a2> such that Affects(a1, a2)",
+        "call c; Select c such that Modifies(c, \"t\")",
+        "variable v; Select v such that Modifies(\"main\", v)"
+    };
+
+    SimplePqlFrontEnd frontend(source1.begin(), source1.end());
+
+    const char *sources[] = { source2.c_str(), source3.c_str() };
+
+    for(int i = 0; i < 2; ++i) {
+        std::string source(sources[i]);
+        ASSERT_TRUE(frontend.reload_source(source.begin(), source.end()));
+
+        SimplePqlFrontEnd expected(source.begin(), source.end());
+
+        for(size_t j = 0; j < sizeof(queries) / sizeof(queries[0]); ++j) {
+            std::string query(queries[j]);
+
+            std::vector<std::string> expected_result = 
+                expected.process_query(query.begin(), query.end());
+            std::vector<std::string> result = 
+                frontend.process_query(query.begin(), query.end());
+
+            std::sort(expected_result.begin(), expected_result.end());
+            std::sort(result.begin(), result.end());
+
+            EXPECT_EQ(expected_result, result) << query;
+        }
+    }
+
+    std::string query = "variable v; Select v such that Modifies(\"main\", v)";
+    std::vector<std::string> result = frontend.process_query(query.begin(), query.end());
+    std::sort(result.begin(), result.end());
+
+    ASSERT_EQ(result.size(), (size_t) 2);
+    EXPECT_EQ(result[0], "x");
+    EXPECT_EQ(result[1], "y");
+}
+
 class FrontEndFixtureTest : public testing::TestWithParam<PqlTestFixture> {
 
 };
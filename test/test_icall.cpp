@@ -153,5 +153,78 @@ TEST(ICallTest, TrivialTest) {
     EXPECT_EQ(solver.solve_left<ProcAst>(proc4), proc4_called);
 }
 
+TEST(ICallTest, ChainTest) {
+    /*
+     * proc p0 {
+     *   call p1;
+     *   call p129;
+     * }
+     * ...
+     * proc p128 {
+     *   call p129;
+     *   call p129;
+     * }
+     *
+     * proc p129 {
+     *   x = 1;
+     * }
+     */
+    const size_t proc_count = 130;
+    std::vector<SimpleProcAst*> procs;
+
+    for(size_t i = 0; i < proc_count; ++i) {
+        procs.push_back(new SimpleProcAst("p" + std::to_string(i)));
+    }
+
+    for(size_t i = 0; i + 1 < proc_count; ++i) {
+        SimpleCallAst *call1 = new SimpleCallAst(procs[i + 1]);
+        set_proc(call1, procs[i]);
+
+        SimpleCallAst *call2 = new SimpleCallAst(procs[proc_count - 1]);
+        set_next(call1, call2);
+    }
+
+    SimpleAssignmentAst *assign = new SimpleAssignmentAst();
+    assign->set_variable(SimpleVariable("x"));
+    assign->set_expr(new SimpleConstAst(1));
+    set_proc(assign, procs[proc_count - 1]);
+
+    std::vector<ProcAst*> proc_asts(procs.begin(), procs.end());
+    SimpleRoot root(proc_asts.begin(), proc_asts.end());
+    ICallSolver solver(root);
+
+    EXPECT_TRUE((solver.validate<ProcAst, ProcAst>(procs[0], procs[proc_count - 1])));
+    EXPECT_TRUE((solver.validate<ProcAst, ProcAst>(procs[3], procs[100])));
+    EXPECT_FALSE((solver.validate<ProcAst, ProcAst>(procs[100], procs[3])));
+    EXPECT_FALSE((solver.validate<ProcAst, ProcAst>(procs[64], procs[64])));
+
+    EXPECT_EQ(solver.solve_right<ProcAst>(procs[proc_count - 1]), ConditionSet());
+    EXPECT_EQ(solver.solve_right<ProcAst>(procs[64]).get_size(), proc_count - 65);
+    EXPECT_EQ(solver.solve_left<ProcAst>(procs[proc_count - 1]).get_size(), proc_count - 1);
+    EXPECT_EQ(solver.solve_left<ProcAst>(procs[0]), ConditionSet());
+
+    EXPECT_TRUE(solver.is_nonempty(ConditionSet()));
+}
+
+TEST(ICallTest, EmptyTest) {
+    /*
+     * proc test1 {
+     *   x = 1;
+     * }
+     */
+    SimpleProcAst *proc = new SimpleProcAst("test1");
+
+    SimpleAssignmentAst *assign = new SimpleAssignmentAst();
+    assign->set_variable(SimpleVariable("x"));
+    assign->set_expr(new SimpleConstAst(1));
+    set_proc(assign, proc);
+
+    std::vector<ProcAst*> procs(1, proc);
+    SimpleRoot root(procs.begin(), procs.end());
+    ICallSolver solver(root);
+
+    EXPECT_FALSE(solver.is_nonempty(ConditionSet()));
+}
+
 }
 }
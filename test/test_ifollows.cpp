@@ -173,6 +173,24 @@ TEST(IFollowsTest, TrivialTest) {
     EXPECT_EQ(solver.solve_left<StatementAst>(before), ConditionSet());
     EXPECT_EQ(solver.solve_left<StatementAst>(then_branch), ConditionSet());
     EXPECT_EQ(solver.solve_left<StatementAst>(else_branch), ConditionSet());
+
+    ConditionSet lefts;
+    lefts.insert(new SimpleStatementCondition(before));
+    lefts.insert(new SimpleStatementCondition(then_branch));
+
+    ConditionSet rights;
+    rights.insert(new SimpleStatementCondition(after));
+    rights.insert(new SimpleStatementCondition(follow_then2));
+    rights.insert(new SimpleStatementCondition(follow_else));
+
+    std::set<ConditionPair> links;
+    links.insert(ConditionPair(new SimpleStatementCondition(before), 
+        new SimpleStatementCondition(after)));
+    links.insert(ConditionPair(new SimpleStatementCondition(then_branch), 
+        new SimpleStatementCondition(follow_then2)));
+
+    EXPECT_EQ(solver.solve_right_batch(lefts, rights), links);
+    EXPECT_EQ(solver.solve_left_batch(rights, lefts), links);
 }
 
 }
@@ -24,6 +24,12 @@
 #include "impl/condition.h"
 #include "impl/solvers/next.h"
 #include "impl/solvers/inext.h"
+#include "impl/solvers/inext_bip.h"
+#include "impl/solvers/call.h"
+#include "impl/solvers/next_cached.h"
+#include "impl/solvers/affects.h"
+#include "impl/parser/parser.h"
+#include "impl/parser/iterator_tokenizer.h"
 
 namespace simple {
 namespace test {
@@ -31,6 +37,7 @@ namespace test {
 using namespace simple;
 using namespace simple::impl;
 using namespace simple::util;
+using namespace simple::parser;
 
 TEST(INextTest, BasicTest) {
     /*
@@ -487,5 +494,233 @@ TEST(INextTest, QuirksTest) {
     EXPECT_EQ(result, loop_prev);
 }
 
+TEST(INextTest, BipTest) {
+    /*
+     * proc test1 {
+     *   x = 1;
+     *   call test2;
+     *   y = 2;
+     * }
+     *
+     * proc test2 {
+     *   z = 3;
+     *   w = 4;
+     * }
+     */
+    SimpleProcAst *proc1 = new SimpleProcAst("test1");
+    SimpleProcAst *proc2 = new SimpleProcAst("test2");
+
+    SimpleAssignmentAst *stat1 = new SimpleAssignmentAst();
+    stat1->set_variable(SimpleVariable("x"));
+    stat1->set_expr(new SimpleConstAst(1));
+    set_proc(stat1, proc1);
+
+    SimpleCallAst *call = new SimpleCallAst();
+    call->set_proc_called(proc2);
+    set_next(stat1, call);
+
+    SimpleAssignmentAst *stat2 = new SimpleAssignmentAst();
+    stat2->set_variable(SimpleVariable("y"));
+    stat2->set_expr(new SimpleConstAst(2));
+    set_next(call, stat2);
+
+    SimpleAssignmentAst *stat3 = new SimpleAssignmentAst();
+    stat3->set_variable(SimpleVariable("z"));
+    stat3->set_expr(new SimpleConstAst(3));
+    set_proc(stat3, proc2);
+
+    SimpleAssignmentAst *stat4 = new SimpleAssignmentAst();
+    stat4->set_variable(SimpleVariable("w"));
+    stat4->set_expr(new SimpleConstAst(4));
+    set_next(stat3, stat4);
+
+    std::vector<ProcAst*> procs;
+    procs.push_back(proc1);
+    procs.push_back(proc2);
+
+    SimpleRoot root(procs.begin(), procs.end());
+
+    std::shared_ptr<NextSolver> next_solver(new NextSolver(root));
+    std::shared_ptr<CallSolver> calls_solver(new CallSolver(root));
+    std::shared_ptr<NextBipSolver> next_bip_solver(
+        new NextBipSolver(root, next_solver, calls_solver));
+
+    INextBipSolver solver(next_bip_solver);
+
+    StatementSet stat1_next;
+    stat1_next.insert(call);
+    stat1_next.insert(stat2);
+    stat1_next.insert(stat3);
+    stat1_next.insert(stat4);
+    EXPECT_EQ(solver.solve_next_statement(stat1), stat1_next);
+
+    StatementSet stat3_next;
+    stat3_next.insert(stat4);
+    stat3_next.insert(stat2);
+    EXPECT_EQ(solver.solve_next_statement(stat3), stat3_next);
+
+    StatementSet stat2_prev;
+    stat2_prev.insert(stat4);
+    stat2_prev.insert(stat3);
+    stat2_prev.insert(call);
+    stat2_prev.insert(stat1);
+    EXPECT_EQ(solver.solve_prev_statement(stat2), stat2_prev);
+
+    StatementSet stat3_prev;
+    stat3_prev.insert(call);
+    stat3_prev.insert(stat1);
+    EXPECT_EQ(solver.solve_prev_statement(stat3), stat3_prev);
+
+    EXPECT_TRUE((solver.validate<StatementAst, StatementAst>(stat3, stat2)));
+    EXPECT_FALSE((solver.validate<StatementAst, StatementAst>(stat2, stat1)));
+
+    StatementSet call_next;
+    call_next.insert(stat3);
+    EXPECT_EQ(next_bip_solver->solve_next_statement(call), call_next);
+
+    StatementSet stat4_next;
+    stat4_next.insert(stat2);
+    EXPECT_EQ(next_bip_solver->solve_next_statement(stat4), stat4_next);
+
+    StatementSet stat2_bip_prev;
+    stat2_bip_prev.insert(stat4);
+    EXPECT_EQ(next_bip_solver->solve_prev_statement(stat2), stat2_bip_prev);
+}
+
+TEST(INextTest, BipLastContainerTest) {
+    std::string source =
+        "procedure p0 { \n"
+        "   d = 1 - d * a; \n"
+        "   z = y * z - x - a; \n"
+        "   call p1; \n"
+        "   call p1; \n"
+        "   call p2; } \n"
+        "procedure p1 { \n"
+        "   b = z + d - 1; \n"
+        "   if c then { \n"
+        "       y = y; \n"
+        "       d = a; \n"
+        "       d = d - x + 4 + 4; } \n"
+        "   else { \n"
+        "       z = x; } } \n"
+        "procedure p2 { \n"
+        "   while e { \n"
+        "       e = 1; \n"
+        "       f = e; } } \n";
+
+    SimpleParser parser(new IteratorTokenizer<std::string::iterator>(
+        source.begin(), source.end()));
+    SimpleRoot root = parser.parse_program();
+    LineTable lines = parser.get_statement_line_table();
+
+    std::shared_ptr<NextSolver> next_solver(new NextSolver(root));
+    std::shared_ptr<CallSolver> calls_solver(new CallSolver(root));
+    std::shared_ptr<NextBipSolver> next_bip_solver(
+        new NextBipSolver(root, next_solver, calls_solver));
+
+    INextBipSolver solver(next_bip_solver);
+
+    /*
+     * p1 returns from the last statement of each branch of its if.
+     */
+    StatementSet stat4_prev;
+    stat4_prev.insert(lines[10]);
+    stat4_prev.insert(lines[11]);
+    EXPECT_EQ(next_bip_solver->solve_prev_statement(lines[4]), stat4_prev);
+    EXPECT_EQ(next_bip_solver->solve_prev_statement(lines[5]), stat4_prev);
+
+    EXPECT_EQ(solver.solve_prev_statement(lines[7]).count(lines[9]),
+        (size_t) 1);
+    EXPECT_EQ(solver.solve_prev_statement(lines[7]).count(lines[10]),
+        (size_t) 1);
+
+    /*
+     * Going backward must walk the same edges as going forward.
+     */
+    for(auto it = lines.begin(); it != lines.end(); ++it) {
+        StatementSet next = next_bip_solver->solve_next_statement(it->second);
+        StatementSet inext = solver.solve_next_statement(it->second);
+
+        for(auto it2 = lines.begin(); it2 != lines.end(); ++it2) {
+            EXPECT_EQ(next.count(it2->second),
+                next_bip_solver->solve_prev_statement(it2->second).count(
+                    it->second));
+            EXPECT_EQ(inext.count(it2->second),
+                solver.solve_prev_statement(it2->second).count(it->second));
+        }
+    }
+}
+
+TEST(INextTest, BlockTest) {
+    std::string source =
+        "procedure p { \n"
+        "   a = 1; \n"
+        "   b = a; \n"
+        "   while i { \n"
+        "       c = b; \n"
+        "       d = 2; \n"
+        "       e = 3; \n"
+        "       b = c; } \n"
+        "   call q; \n"
+        "   f = b; } \n"
+        "procedure q { \n"
+        "   b = 4; } \n";
+
+    SimpleParser parser(new IteratorTokenizer<std::string::iterator>(
+        source.begin(), source.end()));
+    SimpleRoot root = parser.parse_program();
+
+    std::shared_ptr<CachedNextSolver> next_solver(new CachedNextSolver(root));
+    std::shared_ptr<ModifiesSolver> modifies_solver(new ModifiesSolver(root));
+    const ControlFlowGraph *graph = next_solver->get_graph();
+
+    /*
+     * Lines 4 to 9 form a block, and its summary does not mention e.
+     */
+    const ControlFlowGraph::BlockSummary& summary = 
+        graph->get_block_summary(graph->get_block(3));
+
+    EXPECT_EQ(graph->get_block_begin(graph->get_block(3)), 3);
+    EXPECT_EQ(graph->get_block_end(graph->get_block(3)), 7);
+    EXPECT_EQ(summary.modified.size(), (size_t) 4);
+    EXPECT_EQ(summary.used.size(), (size_t) 2);
+    EXPECT_EQ(graph->get_block_summary(graph->get_block(7)).calls.size(), 
+        (size_t) 1);
+
+    INextSolver inext_solver(root, next_solver);
+    INextSolver block_inext_solver(root, next_solver, graph);
+
+    AffectsSolver affects_solver(next_solver, modifies_solver);
+    AffectsSolver block_affects_solver(next_solver, modifies_solver, graph);
+
+    for(size_t id = 0; id < graph->size(); ++id) {
+        StatementAst *statement = graph->get_statement(id);
+
+        EXPECT_EQ(block_inext_solver.solve_next_statement(statement),
+            inext_solver.solve_next_statement(statement));
+        EXPECT_EQ(block_inext_solver.solve_prev_statement(statement),
+            inext_solver.solve_prev_statement(statement));
+
+        EXPECT_EQ(
+            block_affects_solver.solve_affected_statements<StatementAst>(statement),
+            affects_solver.solve_affected_statements<StatementAst>(statement));
+        EXPECT_EQ(
+            block_affects_solver.solve_affecting_statements<StatementAst>(statement),
+            affects_solver.solve_affecting_statements<StatementAst>(statement));
+    }
+
+    /*
+     * The while body is reached whole from line 2, and b at line 7 
+     * reaches line 4 through the loop but not line 9 past the call.
+     */
+    EXPECT_EQ(block_inext_solver.solve_next_statement(
+        graph->get_statement(1)).size(), (size_t) 7);
+
+    StatementSet affected = block_affects_solver.
+        solve_affected_statements<StatementAst>(graph->get_statement(6));
+    EXPECT_EQ(affected.size(), (size_t) 1);
+    EXPECT_EQ(affected.count(graph->get_statement(3)), (size_t) 1);
+}
+
 }
 }
@@ -110,6 +110,38 @@ TEST(TupleTest, TuplePtrTripleEquality) {
     EXPECT_EQ(list1, list2);
 }
 
+TEST(TupleTest, TupleTableTest) {
+    SimpleAssignmentAst stat1;
+    SimpleAssignmentAst stat2;
+    SimpleAssignmentAst stat3;
+
+    ConditionPtr condition1(new SimpleStatementCondition(&stat1));
+    ConditionPtr condition2(new SimpleStatementCondition(&stat2));
+    ConditionPtr condition3(new SimpleStatementCondition(&stat3));
+
+    TupleTable table(2);
+    EXPECT_TRUE(table.empty());
+
+    ConditionPtr row[] = { condition2, condition3 };
+    table.add_row(row);
+    table.add_row(condition1, &condition3);
+    table.add_row(condition2, &condition3);
+
+    EXPECT_EQ((int) table.size(), 3);
+
+    table.sort_unique();
+    EXPECT_EQ((int) table.size(), 2);
+    EXPECT_EQ((int) table.arity(), 2);
+
+    TupleSet tuples;
+    tuples.insert(make_tuples(condition1, condition3));
+    tuples.insert(make_tuples(condition2, condition3));
+
+    EXPECT_EQ(table.to_tuple_set(), tuples);
+    EXPECT_TRUE(table.row(0)[0] < table.row(1)[0]);
+    EXPECT_EQ(table.row(1)[1], condition3);
+}
+
 TEST(LinkerTest, EmptyResultTest) {
     SimpleQueryLinker linker1;
     EXPECT_EQ(linker1.is_initialized("x"), false);
@@ -610,6 +642,95 @@ TEST(LinkerTest, TwoWayLinks) {
     EXPECT_EQ(linker.make_tuples(make_string_list("y", "x")), expected2);
 }
 
+/*
+ * Links x, y and z in a cycle where each condition has one support in
+ * each neighbour, so that removing the first condition of x removes 
+ * every condition one after another.
+ */
+TEST(LinkerTest, CascadeTest) {
+    const int count = 5000;
+
+    std::vector<ConditionPtr> x, y, z;
+    ConditionSet x1, y1, z1;
+
+    for(int i = 0; i < count; ++i) {
+        x.push_back(ConditionPtr(new SimpleConstantCondition(i)));
+        y.push_back(ConditionPtr(new SimpleConstantCondition(count + i)));
+        z.push_back(ConditionPtr(new SimpleConstantCondition(2 * count + i)));
+
+        x1.insert(x[i]);
+        y1.insert(y[i]);
+        z1.insert(z[i]);
+    }
+
+    std::set<ConditionPair> links_xy, links_yz, links_zx;
+
+    for(int i = 0; i < count; ++i) {
+        links_xy.insert(ConditionPair(x[i], y[i]));
+        links_yz.insert(ConditionPair(y[i], z[i]));
+        links_zx.insert(ConditionPair(z[i], x[(i + 1) % count]));
+    }
+
+    SimpleQueryLinker linker;
+
+    linker.init_qvar("x", x1);
+    linker.init_qvar("y", y1);
+    linker.init_qvar("z", z1);
+
+    linker.update_links("x", "y", links_xy);
+    linker.update_links("y", "z", links_yz);
+    linker.update_links("z", "x", links_zx);
+
+    EXPECT_EQ(linker.get_conditions("z"), z1);
+    EXPECT_TRUE(linker.is_valid_state());
+
+    x1.remove(x[0]);
+    linker.update_results("x", x1);
+
+    EXPECT_TRUE(linker.get_conditions("x").is_empty());
+    EXPECT_TRUE(linker.get_conditions("y").is_empty());
+    EXPECT_TRUE(linker.get_conditions("z").is_empty());
+    EXPECT_FALSE(linker.is_valid_state());
+}
+
+/*
+ * A condition is only removed once the counter of its supports in a
+ * neighbour drops to zero, and adding a link twice counts it once.
+ */
+TEST(LinkerTest, SupportCounterTest) {
+    ConditionPtr x1(new SimpleConstantCondition(1));
+    ConditionPtr y1(new SimpleConstantCondition(11));
+    ConditionPtr y2(new SimpleConstantCondition(12));
+
+    ConditionSet xs(x1);
+    ConditionSet ys;
+    ys.insert(y1);
+    ys.insert(y2);
+
+    std::set<ConditionPair> links;
+    links.insert(ConditionPair(x1, y1));
+    links.insert(ConditionPair(x1, y2));
+
+    SimpleQueryLinker linker;
+    linker.init_qvar("x", xs);
+    linker.init_qvar("y", ys);
+    linker.update_links("x", "y", links);
+
+    EXPECT_TRUE(linker.add_link("x", "y", x1, y1));
+    EXPECT_EQ(linker.get_links_as_tuples("x", "y"), links);
+
+    linker.break_link("x", "y", x1, y1);
+    EXPECT_TRUE(linker.has_condition("x", x1));
+    EXPECT_FALSE(linker.has_condition("y", y1));
+    EXPECT_FALSE(linker.validate("x", "y", x1, y1));
+    EXPECT_TRUE(linker.validate("x", "y", x1, y2));
+
+    linker.break_link("y", "x", y2, x1);
+    EXPECT_TRUE(linker.get_conditions("x").is_empty());
+    EXPECT_TRUE(linker.get_conditions("y").is_empty());
+    EXPECT_FALSE(linker.is_valid_state());
+}
+
 TEST(LinkerTest, UnlinkedPermutations) {
 
 }
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "simple/util/memo_cache.h"
+#include "impl/ast.h"
+
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::util;
+
+TEST(MemoCacheTest, CounterTest) {
+  MemoCacheBudget budget;
+  SimpleAssignmentAst assign1, assign2;
+
+  {
+    MemoCache<StatementAst*, StatementSet> cache("test", budget);
+
+    EXPECT_EQ(cache.find(&assign1).get(), (const StatementSet*) NULL);
+
+    StatementSet statements;
+    statements.insert(&assign2);
+    cache.insert(&assign1, statements);
+
+    ASSERT_NE(cache.find(&assign1).get(), (const StatementSet*) NULL);
+    EXPECT_EQ(*cache.find(&assign1), statements);
+    EXPECT_FALSE(cache.contains(&assign2));
+
+    EXPECT_EQ(cache.get_stats().hits, (size_t) 2);
+    EXPECT_EQ(cache.get_stats().misses, (size_t) 1);
+    EXPECT_EQ(cache.get_stats().entries, (size_t) 1);
+    EXPECT_EQ(cache.get_stats().bytes, budget.get_usage());
+    EXPECT_GT(budget.get_usage(), memo_cost(statements));
+  }
+
+  /*
+   * The counters of a destroyed cache are kept, but not its entries.
+   */
+  EXPECT_EQ(budget.get_usage(), (size_t) 0);
+
+  std::map<std::string, MemoCacheStats> stats = budget.collect_stats();
+  EXPECT_EQ(stats["test"].hits, (size_t) 2);
+  EXPECT_EQ(stats["test"].entries, (size_t) 0);
+}
+
+TEST(MemoCacheTest, EvictionTest) {
+  MemoCacheBudget budget;
+  MemoCache<int, StatementSet> cache1("test1", budget);
+  MemoCache<int, StatementSet> cache2("test2", budget);
+
+  for(int i = 0; i < 4; ++i) cache1.insert(i, StatementSet());
+  size_t entry_cost = budget.get_usage() / 4;
+
+  /*
+   * Room for five entries. Touching 0 makes 1 the least recently used
+   * entry, which goes first.
+   */
+  budget.set_limit(entry_cost * 5);
+  cache1.find(0);
+
+  cache1.insert(4, StatementSet());
+  EXPECT_EQ(cache1.size(), (size_t) 5);
+
+  cache1.insert(5, StatementSet());
+  EXPECT_EQ(cache1.size(), (size_t) 5);
+  EXPECT_FALSE(cache1.contains(1));
+  EXPECT_TRUE(cache1.contains(0));
+  EXPECT_EQ(cache1.get_stats().evictions, (size_t) 1);
+
+  /*
+   * The budget evicts the least recently used entry of all caches, so
+   * inserting into the second cache evicts 2 from the first.
+   */
+  cache2.insert(0, StatementSet());
+  EXPECT_EQ(cache2.size(), (size_t) 1);
+  EXPECT_EQ(cache1.size(), (size_t) 4);
+  EXPECT_FALSE(cache1.contains(2));
+  EXPECT_FALSE(budget.is_over_limit());
+
+  /*
+   * A small cache that is used all the time keeps its entry while the
+   * large one churns through its own.
+   */
+  for(int i = 10; i < 20; ++i) {
+    cache2.find(0);
+    cache1.insert(i, StatementSet());
+  }
+
+  EXPECT_TRUE(cache2.contains(0));
+  EXPECT_EQ(cache1.size(), (size_t) 4);
+  EXPECT_TRUE(cache1.contains(16));
+
+  /*
+   * Once the large cache goes cold, the small one grows at its expense
+   * instead of evicting its own entries.
+   */
+  for(int i = 1; i < 4; ++i) cache2.insert(i, StatementSet());
+
+  EXPECT_EQ(cache2.size(), (size_t) 4);
+  EXPECT_EQ(cache1.size(), (size_t) 1);
+  EXPECT_TRUE(cache1.contains(19));
+  EXPECT_EQ(cache1.get_stats().evictions, (size_t) 15);
+  EXPECT_EQ(cache2.get_stats().evictions, (size_t) 0);
+  EXPECT_FALSE(budget.is_over_limit());
+
+  cache1.clear();
+  cache2.clear();
+  EXPECT_EQ(budget.get_usage(), (size_t) 0);
+}
@@ -58,6 +58,10 @@ TEST(ModifiesTest, FixtureTest1) {
     EXPECT_TRUE((solver.validate<StatementAst, SimpleVariable>(assign, &var)));
     EXPECT_TRUE((solver.validate<StatementAst, SimpleVariable>(assign, &var)));
     EXPECT_TRUE((solver.validate<ProcAst, SimpleVariable>(proc, &var)));
+    EXPECT_TRUE(solver.has_right<StatementAst>(assign));
+    EXPECT_TRUE(solver.has_left<SimpleVariable>(&var3));
+    EXPECT_FALSE(solver.has_left<SimpleVariable>(&var2));
+    EXPECT_TRUE(solver.is_nonempty(ConditionSet()));
     // Different variable objects with same name
     EXPECT_TRUE((solver.validate<StatementAst, SimpleVariable>(assign, &var3)));
     EXPECT_TRUE((solver.validate<StatementAst, SimpleVariable>(assign, &var3)));
@@ -246,6 +250,104 @@ TEST(ModifiesTest, QuirksTest) {
     a_statements.insert(new SimpleStatementCondition(stat2_2));
     a_statements.insert(new SimpleStatementCondition(stat3));
     EXPECT_EQ(solver.solve_left<SimpleVariable>(&var_a), a_statements);
+
+    ConditionSet lefts;
+    lefts.insert(new SimpleStatementCondition(condition));
+    lefts.insert(new SimpleProcCondition(proc2));
+
+    ConditionSet rights;
+    rights.insert(new SimpleVariableCondition(var_x));
+    rights.insert(new SimpleVariableCondition(var_a));
+
+    std::set<ConditionPair> links;
+    links.insert(ConditionPair(new SimpleStatementCondition(condition), 
+        new SimpleVariableCondition(var_x)));
+    links.insert(ConditionPair(new SimpleProcCondition(proc2), 
+        new SimpleVariableCondition(var_a)));
+
+    EXPECT_EQ(solver.solve_right_batch(lefts, rights), links);
+    EXPECT_EQ(solver.solve_left_batch(rights, lefts), links);
+}
+
+TEST(ModifiesTest, DiamondTest) {
+    /*
+     * proc test1 {
+     *   call test2;
+     *   call test3;
+     * }
+     *
+     * proc test2 {
+     *   x = 1;
+     *   call test4;
+     * }
+     *
+     * proc test3 {
+     *   call test4;
+     * }
+     *
+     * proc test4 {
+     *   w = 2;
+     * }
+     */
+    SimpleProcAst *proc1 = new SimpleProcAst("test1");
+    SimpleProcAst *proc2 = new SimpleProcAst("test2");
+    SimpleProcAst *proc3 = new SimpleProcAst("test3");
+    SimpleProcAst *proc4 = new SimpleProcAst("test4");
+
+    SimpleVariable var_x("x");
+    SimpleVariable var_w("w");
+
+    SimpleCallAst *call1 = new SimpleCallAst(proc2);
+    set_proc(call1, proc1);
+
+    SimpleCallAst *call2 = new SimpleCallAst(proc3);
+    set_next(call1, call2);
+
+    SimpleAssignmentAst *stat1 = new SimpleAssignmentAst();
+    stat1->set_variable(var_x);
+    stat1->set_expr(new SimpleConstAst(1));
+    set_proc(stat1, proc2);
+
+    SimpleCallAst *call3 = new SimpleCallAst(proc4);
+    set_next(stat1, call3);
+
+    SimpleCallAst *call4 = new SimpleCallAst(proc4);
+    set_proc(call4, proc3);
+
+    SimpleAssignmentAst *stat2 = new SimpleAssignmentAst();
+    stat2->set_variable(var_w);
+    stat2->set_expr(new SimpleConstAst(2));
+    set_proc(stat2, proc4);
+
+    std::vector<ProcAst*> procs;
+    procs.push_back(proc1);
+    procs.push_back(proc2);
+    procs.push_back(proc3);
+    procs.push_back(proc4);
+
+    SimpleRoot root(procs.begin(), procs.end());
+    ModifiesSolver solver(root);
+
+    EXPECT_TRUE((solver.validate<ProcAst, SimpleVariable>(proc1, &var_x)));
+    EXPECT_TRUE((solver.validate<ProcAst, SimpleVariable>(proc1, &var_w)));
+    EXPECT_TRUE((solver.validate<ProcAst, SimpleVariable>(proc3, &var_w)));
+    EXPECT_FALSE((solver.validate<ProcAst, SimpleVariable>(proc3, &var_x)));
+
+    EXPECT_TRUE((solver.validate<StatementAst, SimpleVariable>(call1, &var_x)));
+    EXPECT_TRUE((solver.validate<StatementAst, SimpleVariable>(call2, &var_w)));
+    EXPECT_FALSE((solver.validate<StatementAst, SimpleVariable>(call2, &var_x)));
+
+    ConditionSet w_modifiers;
+    w_modifiers.insert(new SimpleProcCondition(proc1));
+    w_modifiers.insert(new SimpleProcCondition(proc2));
+    w_modifiers.insert(new SimpleProcCondition(proc3));
+    w_modifiers.insert(new SimpleProcCondition(proc4));
+    w_modifiers.insert(new SimpleStatementCondition(call1));
+    w_modifiers.insert(new SimpleStatementCondition(call2));
+    w_modifiers.insert(new SimpleStatementCondition(call3));
+    w_modifiers.insert(new SimpleStatementCondition(call4));
+    w_modifiers.insert(new SimpleStatementCondition(stat2));
+    EXPECT_EQ(solver.solve_left<SimpleVariable>(&var_w), w_modifiers);
 }
 
 } // namespace test
@@ -22,6 +22,9 @@
 #include "impl/ast.h"
 #include "impl/condition.h"
 #include "impl/solvers/next.h"
+#include "impl/solvers/next_cached.h"
+#include "impl/parser/parser.h"
+#include "impl/parser/iterator_tokenizer.h"
 
 namespace simple {
 namespace test {
@@ -29,6 +32,7 @@ namespace test {
 using namespace simple;
 using namespace simple::impl;
 using namespace simple::util;
+using namespace simple::parser;
 
 TEST(NextTest, BasicTest) {
     /*
@@ -57,6 +61,12 @@ TEST(NextTest, BasicTest) {
     NextSolver solver(root);
 
     EXPECT_TRUE((solver.validate<StatementAst, StatementAst>(stat1, stat2)));
+
+    EXPECT_TRUE(solver.has_right<StatementAst>(stat1));
+    EXPECT_FALSE(solver.has_right<StatementAst>(stat2));
+    EXPECT_FALSE(solver.has_left<StatementAst>(stat1));
+    EXPECT_TRUE(solver.has_left<StatementAst>(stat2));
+    EXPECT_TRUE(solver.is_nonempty(ConditionSet()));
 }
 
 TEST(NextTest, IfTest) {
@@ -133,6 +143,12 @@ TEST(NextTest, IfTest) {
     EXPECT_FALSE((solver.validate<StatementAst, StatementAst>(else_branch, else_branch)));
     EXPECT_FALSE((solver.validate<StatementAst, StatementAst>(after, after)));
 
+    EXPECT_TRUE(solver.has_right<StatementAst>(then_branch));
+    EXPECT_TRUE(solver.has_right<StatementAst>(condition));
+    EXPECT_FALSE(solver.has_right<StatementAst>(after));
+    EXPECT_TRUE(solver.has_left<StatementAst>(else_branch));
+    EXPECT_FALSE(solver.has_left<StatementAst>(before));
+
     ConditionSet before_next;
     before_next.insert(new SimpleStatementCondition(condition));
     EXPECT_EQ(solver.solve_right<StatementAst>(before), before_next);
@@ -373,5 +389,100 @@ TEST(NextTest, QuirksTest) {
     EXPECT_EQ(solver.solve_left<StatementAst>(condition1), condition1_prev);
 }
 
+TEST(NextTest, ControlFlowGraphTest) {
+    std::string source =
+        "procedure p { \n"
+        "   a = 1; \n"
+        "   b = a; \n"
+        "   while i { \n"
+        "       c = b; \n"
+        "       d = c; } \n"
+        "   if j then { \n"
+        "       e = 1; } \n"
+        "   else { \n"
+        "       f = 2; } \n"
+        "   g = 3; } \n"
+        "procedure q { \n"
+        "   h = 1; } \n";
+
+    SimpleParser parser(new IteratorTokenizer<std::string::iterator>(
+        source.begin(), source.end()));
+    SimpleRoot root = parser.parse_program();
+
+    CachedNextSolver solver(root);
+    NextSolver next_solver(root);
+    const ControlFlowGraph *graph = solver.get_graph();
+
+    EXPECT_EQ(graph->size(), (size_t) 10);
+
+    for(int id = 0; id < 10; ++id) {
+        StatementAst *statement = graph->get_statement(id);
+
+        EXPECT_EQ(statement->get_statement_line(), id + 1);
+        EXPECT_EQ(graph->get_id(statement), id);
+
+        EXPECT_EQ(solver.solve_next_statement(statement),
+            next_solver.solve_next_statement(statement));
+        EXPECT_EQ(solver.solve_prev_statement(statement),
+            next_solver.solve_prev_statement(statement));
+    }
+
+    /*
+     * The while statement at line 3 goes to its body and the if 
+     * statement, and is reached from line 2 and the end of its body.
+     */
+    ControlFlowGraph::Slice next = graph->get_next(2);
+    ASSERT_EQ(next.size(), (size_t) 2);
+    EXPECT_EQ(next.begin[0], 3);
+    EXPECT_EQ(next.begin[1], 5);
+    EXPECT_EQ(graph->get_prev(2).size(), (size_t) 2);
+    EXPECT_TRUE(graph->is_next(4, 2));
+    EXPECT_FALSE(graph->is_next(2, 4));
+
+    EXPECT_TRUE(graph->get_next(9).empty());
+    EXPECT_TRUE(graph->get_prev(9).empty());
+    EXPECT_TRUE(graph->get_next(8).empty());
+
+    /*
+     * The blocks are {1, 2}, {3}, {4, 5}, {6}, {7}, {8}, {9} and {10}.
+     */
+    EXPECT_EQ(graph->get_block_count(), (size_t) 8);
+    EXPECT_EQ(graph->get_block(1), graph->get_block(0));
+    EXPECT_EQ(graph->get_block(4), graph->get_block(3));
+    EXPECT_EQ(graph->get_block_begin(graph->get_block(4)), 3);
+    EXPECT_EQ(graph->get_block_end(graph->get_block(4)), 5);
+    EXPECT_NE(graph->get_block(2), graph->get_block(1));
+    EXPECT_NE(graph->get_block(5), graph->get_block(4));
+
+    /*
+     * The batches read the graph rows directly and must agree with
+     * solving each statement on its own.
+     */
+    ConditionSet lefts;
+    lefts.insert(new SimpleStatementCondition(graph->get_statement(2)));
+    lefts.insert(new SimpleStatementCondition(graph->get_statement(4)));
+    lefts.insert(new SimpleStatementCondition(graph->get_statement(9)));
+
+    ConditionSet rights;
+    rights.insert(new SimpleStatementCondition(graph->get_statement(2)));
+    rights.insert(new SimpleStatementCondition(graph->get_statement(5)));
+    rights.insert(new SimpleStatementCondition(graph->get_statement(6)));
+
+    std::set<ConditionPair> links;
+    links.insert(ConditionPair(
+        new SimpleStatementCondition(graph->get_statement(2)), 
+        new SimpleStatementCondition(graph->get_statement(5))));
+    links.insert(ConditionPair(
+        new SimpleStatementCondition(graph->get_statement(4)), 
+        new SimpleStatementCondition(graph->get_statement(2))));
+
+    EXPECT_EQ(solver.solve_right_batch(lefts, rights), links);
+    EXPECT_EQ(solver.solve_left_batch(rights, lefts), links);
+
+    SimpleSolverGenerator<NextSolver> per_condition(new NextSolver(root));
+    EXPECT_EQ(per_condition.solve_right_batch(lefts, rights), links);
+    EXPECT_EQ(per_condition.solve_left_batch(rights, lefts), links);
+}
+
 } // namespace test
 } // namespace simple
@@ -24,6 +24,7 @@
 #include "impl/parser/tokenizer.h"
 #include "impl/parser/parser.h"
 #include "impl/parser/iterator_tokenizer.h"
+#include "impl/parser/incremental_parser.h"
 #include "test/mock.h"
 
 namespace simple {
@@ -635,6 +636,72 @@ TEST(ParserTest, FullItegrationTest) {
     EXPECT_EQ(parser.current_statement_line(), 9);
 }
 
+TEST(ParserTest, IncrementalParserTest) {
+    std::string source1 = 
+        "procedure test1 { \n"
+        "   a = 1; \n"
+        "   call test2; \n"
+        "   while i { \n"
+        "       b = a; } } \n"
+        "procedure test2 { \n"
+        "   c = 3; } \n";
+
+    std::string source2 = 
+        "procedure test1 { \n"
+        "   a = 1; \n"
+        "   call test2; \n"
+        "   while i { \n"
+        "       b = a; } } \n"
+        "procedure test2 { \n"
+        "   c = 3; \n"
+        "   d = c; } \n";
+
+    IncrementalParser parser(source1);
+    SimpleRoot ast = parser.get_ast();
+    ProcAst *test1 = ast.get_proc("test1");
+    ProcAst *test2 = ast.get_proc("test2");
+    StatementAst *old_body = test2->get_statement();
+
+    CallAst *call = statement_cast<CallAst>(test1->get_statement()->next());
+    ASSERT_TRUE(call != NULL);
+    WhileAst *loop = statement_cast<WhileAst>(call->next());
+    ASSERT_TRUE(loop != NULL);
+
+    EXPECT_FALSE(parser.update(source1));
+    ASSERT_TRUE(parser.update(source2));
+    EXPECT_FALSE(parser.is_new_program());
+
+    /*
+     * The unchanged procedure keeps its statements, and the changed one
+     * gets its new body in place.
+     */
+    EXPECT_EQ(parser.get_ast().get_proc("test1"), test1);
+    EXPECT_EQ(parser.get_ast().get_proc("test2"), test2);
+    EXPECT_EQ(statement_cast<CallAst>(test1->get_statement()->next()), call);
+    EXPECT_EQ(call->get_proc_called(), test2);
+    EXPECT_EQ(loop->get_body()->get_statement_line(), 4);
+
+    StatementAst *new_body = test2->get_statement();
+    EXPECT_NE(new_body, old_body);
+    EXPECT_EQ(new_body->get_proc(), test2);
+    EXPECT_EQ(new_body->get_statement_line(), 5);
+    ASSERT_TRUE(new_body->next() != NULL);
+    EXPECT_EQ(new_body->next()->get_statement_line(), 6);
+
+    std::vector<StatementAst*> old_bodies = parser.get_old_bodies();
+    ASSERT_EQ(old_bodies.size(), (size_t) 1);
+    EXPECT_EQ(old_bodies[0], old_body);
+
+    EXPECT_EQ(parser.get_statement_line_table().size(), (size_t) 6);
+    EXPECT_EQ(parser.get_changed_procs().size(), (size_t) 1);
+    EXPECT_EQ(parser.get_changed_procs().count(test2), (size_t) 1);
+
+    std::string broken = "procedure test1 { a = ; }";
+    EXPECT_ANY_THROW(parser.update(broken));
+    EXPECT_EQ(parser.get_ast().get_proc("test2"), test2);
+    EXPECT_EQ(test2->get_statement(), new_body);
+}
+
 
 }
 }
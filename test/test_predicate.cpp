@@ -149,6 +149,33 @@ TEST(PredicateTest, BasicTest) {
     assign_set.insert(new SimpleStatementCondition(stat2_1));
     assign_set.insert(new SimpleStatementCondition(stat3));
     EXPECT_EQ(assign_pred->global_set(), assign_set);
+
+    std::shared_ptr<PredicateDomain> domain(new PredicateDomain(root));
+
+    BitSetPredicate statement_bits(domain, 
+        PredicateDomain::StatementEK, StatementPredicate::get_name());
+    BitSetPredicate assign_bits(domain, 
+        PredicateDomain::AssignEK, AssignPredicate::get_name());
+    BitSetPredicate variable_bits(domain,
+        PredicateDomain::VariableEK, VariablePredicate::get_name());
+
+    BitSetPredicate wildcard_bits(domain,
+        PredicateDomain::WildcardEK, WildCardPredicate::get_name());
+
+    EXPECT_EQ(wildcard_bits.global_set(), wildcard_set);
+    EXPECT_EQ(statement_bits.global_set(), statement_set);
+    EXPECT_EQ(assign_bits.global_set(), assign_set);
+    EXPECT_EQ((int) variable_bits.global_set().get_size(), 6);
+
+    EXPECT_TRUE(assign_bits.validate(new SimpleStatementCondition(stat3)));
+    EXPECT_FALSE(assign_bits.validate(new SimpleStatementCondition(loop)));
+    EXPECT_TRUE(variable_bits.validate(new SimpleVariableCondition(var_j)));
+    EXPECT_FALSE(variable_bits.validate(new SimpleConstantCondition(1)));
+
+    ConditionSet filtered(statement_set);
+    filtered.insert(new SimpleVariableCondition(var_x));
+    assign_bits.filter(filtered);
+    EXPECT_EQ(filtered, assign_set);
 }
 
 
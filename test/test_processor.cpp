@@ -28,6 +28,7 @@
 #include "impl/solvers/modifies.h"
 #include "impl/predicate.h"
 #include "impl/processor.h"
+#include "impl/boolean_processor.h"
 
 namespace simple {
 namespace test {
@@ -122,6 +123,85 @@ TEST(QueryProcessorTest, IntegratedTest) {
     //        new SimpleStatementCondition(stat2)), expected_v);
 }
 
+TEST(QueryProcessorTest, BooleanTest) {
+    /*
+     * proc test {
+     *   x = 1;
+     *   y = 2;
+     * }
+     */
+    SimpleProcAst *proc = new SimpleProcAst("test");
+    SimpleAssignmentAst *stat1 = new SimpleAssignmentAst();
+    SimpleVariable var_x("x");
+    SimpleVariable var_y("y");
+
+    stat1->set_variable(var_x);
+    stat1->set_expr(new SimpleConstAst(1));
+    stat1->set_line(1);
+    set_proc(stat1, proc);
+
+    SimpleAssignmentAst *stat2 = new SimpleAssignmentAst();
+
+    stat2->set_variable(var_y);
+    stat2->set_expr(new SimpleConstAst(2));
+    stat2->set_line(2);
+    set_next(stat1, stat2);
+
+    SimpleRoot ast(proc);
+
+    std::shared_ptr<QuerySolver> follows_solver(
+            new SimpleSolverGenerator<FollowSolver>(new FollowSolver(ast)));
+    std::shared_ptr<QuerySolver> modifies_solver(
+            new SimpleSolverGenerator<ModifiesSolver>(new ModifiesSolver(ast)));
+
+    std::shared_ptr<SimplePredicate> wildcard_pred(new SimpleWildCardPredicate(ast));
+    std::shared_ptr<SimplePredicate> statement_pred(new SimpleStatementPredicate(ast));
+    std::shared_ptr<SimplePredicate> variable_pred(new SimpleVariablePredicate(ast));
+
+    PredicateTable pred_table;
+    pred_table["s1"] = statement_pred;
+    pred_table["s2"] = statement_pred;
+    pred_table["v"] = variable_pred;
+
+    /*
+     * Follows(s1, s2) and Modifies(s2, v) with v = y
+     */
+    ClauseSet clauses1;
+    clauses1.insert(ClausePtr(new SimplePqlClause(follows_solver,
+                new SimplePqlVariableTerm("s1"),
+                new SimplePqlVariableTerm("s2"))));
+    clauses1.insert(ClausePtr(new SimplePqlClause(modifies_solver,
+                new SimplePqlVariableTerm("s2"),
+                new SimplePqlVariableTerm("v"))));
+
+    BooleanQueryProcessor processor(pred_table, wildcard_pred);
+    bool result = false;
+
+    EXPECT_TRUE(processor.solve(clauses1, result));
+    EXPECT_TRUE(result);
+
+    /*
+     * Follows(s1, s2) and Modifies(s2, "x")
+     */
+    ClauseSet clauses2;
+    clauses2.insert(ClausePtr(new SimplePqlClause(follows_solver,
+                new SimplePqlVariableTerm("s1"),
+                new SimplePqlVariableTerm("s2"))));
+    clauses2.insert(ClausePtr(new SimplePqlClause(modifies_solver,
+                new SimplePqlVariableTerm("s2"),
+                new SimplePqlConditionTerm(ConditionPtr(
+                    new SimpleVariableCondition(var_x))))));
+
+    EXPECT_TRUE(processor.solve(clauses2, result));
+    EXPECT_FALSE(result);
+
+    /*
+     * A search without enough budget gives up instead of answering.
+     */
+    BooleanQueryProcessor limited_processor(pred_table, wildcard_pred, 1);
+    EXPECT_FALSE(limited_processor.solve(clauses1, result));
+}
+
 
 
 }
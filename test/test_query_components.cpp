@@ -0,0 +1,155 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "impl/ast.h"
+#include "impl/condition.h"
+#include "impl/linker.h"
+#include "impl/parser/parser.h"
+#include "impl/parser/pql_parser.h"
+#include "impl/parser/iterator_tokenizer.h"
+#include "impl/query_components.h"
+#include "impl/solver_table.h"
+#include "impl/predicate_table.h"
+
+namespace simple {
+namespace test {
+
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::parser;
+
+class QueryComponentsTest : public testing::Test {
+  protected:
+    QueryComponentsTest() :
+        _source(
+            "procedure test1 { \n"
+            "   a = 1; \n"
+            "   while i { \n"
+            "       call test2; \n"
+            "       b = a; } \n"
+            "   c = b; } \n"
+            "procedure test2 { \n"
+            "   d = 3; } \n"),
+        _parser(new IteratorTokenizer<std::string::iterator>(
+            _source.begin(), _source.end()))
+    {
+        _ast = _parser.parse_program();
+        _solver_table = create_solver_table(_ast);
+        _pred_table = create_predicate_table(_ast);
+    }
+
+    PqlQuerySet parse_query(std::string query) {
+        SimplePqlParser parser(std::shared_ptr<SimpleTokenizer>(
+                new IteratorTokenizer<std::string::iterator>(
+                    query.begin(), query.end())),
+                _ast, _parser.get_statement_line_table(),
+                _solver_table, _pred_table);
+
+        return parser.parse_query();
+    }
+
+    std::string     _source;
+    SimpleParser    _parser;
+    SimpleRoot      _ast;
+    SolverTable     _solver_table;
+    PredicateTable  _pred_table;
+};
+
+TEST_F(QueryComponentsTest, SplitTest) {
+    PqlQuerySet query_set = parse_query(
+        "stmt s1, s2, s3; variable v; \n"
+        "Select s1 such that Follows(s1, s2) and Parent(s2, _) "
+        "and Modifies(s3, v) and Follows(1, 2);");
+
+    std::vector<QueryComponent> components = split_query_components(query_set);
+    EXPECT_EQ((int) components.size(), 3);
+
+    int selected = 0;
+    for(size_t i = 0; i < components.size(); ++i) {
+        if(components[i].qvars.count("s1") > 0) {
+            EXPECT_TRUE(components[i].selected);
+            EXPECT_EQ((int) components[i].qvars.size(), 2);
+            EXPECT_EQ((int) components[i].clauses.size(), 2);
+        } else if(components[i].qvars.count("s3") > 0) {
+            EXPECT_FALSE(components[i].selected);
+            EXPECT_EQ((int) components[i].qvars.size(), 2);
+        } else {
+            EXPECT_TRUE(components[i].qvars.empty());
+            EXPECT_EQ((int) components[i].clauses.size(), 1);
+        }
+
+        if(components[i].selected) ++selected;
+    }
+
+    EXPECT_EQ(selected, 1);
+}
+
+TEST(ComponentQueryLinkerTest, ProductTest) {
+    SimpleAssignmentAst stat1;
+    SimpleAssignmentAst stat2;
+    SimpleAssignmentAst stat3;
+
+    ConditionPtr condition1(new SimpleStatementCondition(&stat1));
+    ConditionPtr condition2(new SimpleStatementCondition(&stat2));
+    ConditionPtr condition3(new SimpleStatementCondition(&stat3));
+
+    ConditionSet x;
+    x.insert(condition1);
+    x.insert(condition2);
+
+    ConditionSet y;
+    y.insert(condition3);
+
+    std::shared_ptr<QueryLinker> linker_x(new SimpleQueryLinker());
+    std::shared_ptr<QueryLinker> linker_y(new SimpleQueryLinker());
+    linker_x->update_results("x", x);
+    linker_y->update_results("y", y);
+
+    QueryComponent component_x;
+    component_x.qvars.insert("x");
+    QueryComponent component_y;
+    component_y.qvars.insert("y");
+
+    std::map<Qvar, PredicatePtr> pred_table;
+    ComponentQueryLinker linker(pred_table, ConditionSet());
+    linker.add_component(component_x, linker_x);
+    linker.add_component(component_y, linker_y);
+
+    EXPECT_TRUE(linker.is_valid_state());
+    EXPECT_EQ(linker.get_conditions("x"), x);
+    EXPECT_EQ(linker.get_conditions("y"), y);
+
+    std::vector<Qvar> qvars;
+    qvars.push_back("y");
+    qvars.push_back("x");
+
+    TupleSet expected;
+    expected.insert(ConditionTuplePtr(new SimpleConditionTuple(condition3,
+        new SimpleConditionTuple(condition1))));
+    expected.insert(ConditionTuplePtr(new SimpleConditionTuple(condition3,
+        new SimpleConditionTuple(condition2))));
+
+    EXPECT_EQ(linker.make_tuples(qvars), expected);
+
+    linker_y->update_results("y", ConditionSet());
+    EXPECT_FALSE(linker.is_valid_state());
+}
+
+}
+}
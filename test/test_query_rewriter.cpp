@@ -0,0 +1,212 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "impl/parser/parser.h"
+#include "impl/parser/pql_parser.h"
+#include "impl/parser/iterator_tokenizer.h"
+#include "impl/query_rewriter.h"
+#include "impl/solver_table.h"
+#include "impl/predicate_table.h"
+#include "impl/processor.h"
+#include "impl/linker.h"
+
+namespace simple {
+namespace test {
+
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::parser;
+
+class QueryRewriterTest : public testing::Test {
+  protected:
+    QueryRewriterTest(const std::string& source =
+            "procedure test1 { \n"
+            "   a = 1; \n"
+            "   while i { \n"
+            "       call test2; \n"
+            "       b = a; } \n"
+            "   c = b; } \n"
+            "procedure test2 { \n"
+            "   d = 3; } \n") :
+        _source(source),
+        _parser(new IteratorTokenizer<std::string::iterator>(
+            _source.begin(), _source.end()))
+    {
+        _ast = _parser.parse_program();
+        _solver_table = create_solver_table(_ast);
+        _pred_table = create_predicate_table(_ast);
+    }
+
+    PqlQuerySet parse_query(std::string query) {
+        SimplePqlParser parser(std::shared_ptr<SimpleTokenizer>(
+                new IteratorTokenizer<std::string::iterator>(
+                    query.begin(), query.end())),
+                _ast, _parser.get_statement_line_table(),
+                _solver_table, _pred_table);
+
+        return parser.parse_query();
+    }
+
+    /*
+     * Solve the clauses of a query in order, as the frontend does for a 
+     * query with a single component.
+     */
+    ConditionSet solve_query(PqlQuerySet& query, const std::string& qvar) {
+        PredicatePtr wildcard_pred = _pred_table["wildcard"];
+        query.predicates["*"] = wildcard_pred;
+
+        std::shared_ptr<SimpleQueryLinker> linker(new SimpleQueryLinker(
+            query.predicates, wildcard_pred->global_set()));
+        QueryProcessor processor(linker, query.predicates, wildcard_pred);
+
+        for(ClauseSet::iterator it = query.clauses.begin();
+            it != query.clauses.end(); ++it)
+        {
+            processor.solve_clause(it->get());
+        }
+
+        return linker->get_conditions(qvar);
+    }
+
+    std::string     _source;
+    SimpleParser    _parser;
+    SimpleRoot      _ast;
+    SolverTable     _solver_table;
+    PredicateTable  _pred_table;
+};
+
+TEST_F(QueryRewriterTest, SubstituteTest) {
+    QueryRewriter rewriter(_solver_table);
+
+    std::string query =
+        "stmt s1, s2; \n"
+        "Select s1 such that Follows*(s1, s2) and Parent(s2, 3) "
+        "with s2.stmt# = 2;";
+    PqlQuerySet query_set = parse_query(query);
+
+    EXPECT_EQ((int) query_set.clauses.size(), 3);
+    EXPECT_TRUE(rewriter.rewrite(query_set));
+
+    /*
+     * Parent(2, 3) holds and is dropped, and Follows*(s1, 2) is left
+     * next to the with clause.
+     */
+    EXPECT_EQ((int) query_set.clauses.size(), 2);
+}
+
+TEST_F(QueryRewriterTest, ImpliedTest) {
+    QueryRewriter rewriter(_solver_table);
+
+    std::string query =
+        "stmt s1, s2; \n"
+        "Select s1 such that Follows(s1, s2) and Follows*(s1, s2) "
+        "and Follows(s1, _) and Next*(s1, s2);";
+    PqlQuerySet query_set = parse_query(query);
+
+    EXPECT_EQ((int) query_set.clauses.size(), 4);
+    EXPECT_TRUE(rewriter.rewrite(query_set));
+    EXPECT_EQ((int) query_set.clauses.size(), 2);
+}
+
+TEST_F(QueryRewriterTest, ContradictionTest) {
+    QueryRewriter rewriter(_solver_table);
+
+    PqlQuerySet query_set1 = parse_query(
+        "stmt s; \n"
+        "Select s with s.stmt# = 1 and s.stmt# = 2;");
+    EXPECT_FALSE(rewriter.rewrite(query_set1));
+
+    PqlQuerySet query_set2 = parse_query(
+        "assign a; \n"
+        "Select a with a.stmt# = 2;");
+    EXPECT_FALSE(rewriter.rewrite(query_set2));
+
+    PqlQuerySet query_set3 = parse_query(
+        "stmt s; \n"
+        "Select s such that Follows(s, 3) with s.stmt# = 1;");
+    EXPECT_FALSE(rewriter.rewrite(query_set3));
+
+    PqlQuerySet query_set4 = parse_query(
+        "stmt s; \n"
+        "Select s such that Follows(s, 2) with s.stmt# = 1;");
+    EXPECT_TRUE(rewriter.rewrite(query_set4));
+}
+
+class QueryRewriterBipTest : public QueryRewriterTest {
+  protected:
+    QueryRewriterBipTest() :
+        QueryRewriterTest(
+            "procedure p0 { \n"
+            "   d = 1 - d * a; \n"
+            "   z = y * z - x - a; \n"
+            "   call p1; \n"
+            "   call p1; } \n"
+            "procedure p1 { \n"
+            "   b = z + d - 1; \n"
+            "   if c then { \n"
+            "       y = y; \n"
+            "       d = a; \n"
+            "       d = d - x + 4 + 4; } \n"
+            "   else { \n"
+            "       z = x; } } \n")
+    { }
+
+    /*
+     * The with clause is kept, and the constant substituted into the
+     * relation clause solves it from the right side. That must give the
+     * same result as solving the relation first.
+     */
+    void expect_same_result(const std::string& query) {
+        QueryRewriter rewriter(_solver_table);
+
+        PqlQuerySet query_set = parse_query(query);
+        ConditionSet expected = solve_query(query_set, "a");
+
+        PqlQuerySet rewritten_set = parse_query(query);
+        EXPECT_TRUE(rewriter.rewrite(rewritten_set));
+
+        EXPECT_EQ(solve_query(rewritten_set, "a"), expected);
+    }
+};
+
+TEST_F(QueryRewriterBipTest, SubstituteTest) {
+    expect_same_result(
+        "assign a; stmt s; \n"
+        "Select a such that NextBip(a, s) with s.stmt# = 4;");
+
+    expect_same_result(
+        "assign a; stmt s; \n"
+        "Select a such that NextBip*(a, s) with s.stmt# = 6;");
+
+    expect_same_result(
+        "assign a; stmt s; \n"
+        "Select a such that AffectsBip(a, s) with s.stmt# = 5;");
+
+    expect_same_result(
+        "assign a; stmt s; \n"
+        "Select a such that AffectsBip*(a, s) with s.stmt# = 5;");
+
+    PqlQuerySet query_set = parse_query(
+        "assign a; stmt s; \n"
+        "Select a such that NextBip*(a, s) with s.stmt# = 6;");
+    EXPECT_EQ(solve_query(query_set, "a").get_size(), (size_t) 7);
+}
+
+}
+}
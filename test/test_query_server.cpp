@@ -0,0 +1,85 @@
+/*
+ * CS3201 Simple Static Analyzer
+ * Copyright (C) 2011 Soares Chen Ruo Fei
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "impl/query_server.h"
+
+namespace simple {
+namespace test {
+
+using namespace simple;
+using namespace simple::impl;
+
+/*
+ * Strip the latency from a response.
+ */
+std::string strip_latency(const std::string& response) {
+    std::string::size_type first = response.find(' ');
+    std::string::size_type second = response.find(' ', first + 1);
+
+    if(second == std::string::npos) return response.substr(0, first);
+    return response.substr(0, first) + response.substr(second);
+}
+
+TEST(QueryServerTest, ProgramTest) {
+    std::string filename = "query_server_test.simple";
+
+    {
+        std::ofstream source(filename);
+        source << "procedure test { a = 1; b = a; }";
+    }
+
+    QueryServer server(2);
+
+    EXPECT_EQ(strip_latency(server.handle_request("LOAD p " + filename)), "OK loaded p");
+    EXPECT_EQ(strip_latency(server.handle_request("LIST")), "OK p");
+
+    std::future<std::string> result1 = server.submit(
+        "QUERY p stmt s; Select s such that Affects(1, s)");
+    std::future<std::string> result2 = server.submit(
+        "QUERY p variable v; Select v such that Modifies(1, v)");
+
+    EXPECT_EQ(strip_latency(result1.get()), "OK 2");
+    EXPECT_EQ(strip_latency(result2.get()), "OK a");
+
+    EXPECT_EQ(strip_latency(server.handle_request("STATS p")).substr(0, 12), 
+        "OK queries=2");
+    EXPECT_EQ(strip_latency(server.handle_request("RELOAD p")), "OK unchanged p");
+
+    {
+        std::ofstream source(filename);
+        source << "procedure test { a = 1; c = 2; b = a; }";
+    }
+
+    EXPECT_EQ(strip_latency(server.handle_request("RELOAD p")), "OK reloaded p");
+    EXPECT_EQ(strip_latency(server.handle_request(
+        "QUERY p stmt s; Select s such that Affects(1, s)")), "OK 3");
+
+    EXPECT_EQ(strip_latency(server.handle_request("DROP p")), "OK dropped p");
+    EXPECT_EQ(strip_latency(server.handle_request("QUERY p stmt s; Select s")), 
+        "ERROR No program named p");
+    EXPECT_EQ(strip_latency(server.handle_request("FOO")), 
+        "ERROR Unknown command FOO");
+
+    std::remove(filename.c_str());
+}
+
+} // namespace test
+} // namespace simple
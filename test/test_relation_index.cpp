@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "simple/util/relation_index.h"
+#include "impl/ast.h"
+#include "impl/condition.h"
+
+using namespace simple;
+using namespace simple::impl;
+using namespace simple::util;
+
+TEST(RelationIndexTest, HashIndexTest) {
+  HashIndex<SimpleVariable, int> index;
+
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.find(SimpleVariable("a")), (int*) NULL);
+  EXPECT_EQ(index.get(SimpleVariable("a")), 0);
+  EXPECT_TRUE(index.empty());
+
+  for(int i = 0; i < 100; ++i) {
+    index.insert(SimpleVariable("v" + std::string(1, 'a' + i % 26) +
+        std::string(1, 'a' + i / 26)), i);
+  }
+
+  EXPECT_EQ(index.size(), (size_t) 100);
+  EXPECT_EQ(index.get(SimpleVariable("vaa")), 0);
+  EXPECT_EQ(index.get(SimpleVariable("vzc")), 77);
+  EXPECT_TRUE(index.contains(SimpleVariable("vad")));
+  EXPECT_FALSE(index.contains(SimpleVariable("vae")));
+
+  index.insert(SimpleVariable("vaa")) += 5;
+  EXPECT_EQ(index.get(SimpleVariable("vaa")), 5);
+  EXPECT_EQ(index.size(), (size_t) 100);
+
+  int sum = 0;
+  for(auto it = index.begin(); it != index.end(); ++it) {
+    sum += it->second;
+  }
+  EXPECT_EQ(sum, 99 * 100 / 2 + 5);
+}
+
+TEST(RelationIndexTest, ConditionKeyTest) {
+  SimpleAssignmentAst assign;
+  HashIndex<ConditionPtr, int> index;
+
+  index.insert(new SimpleStatementCondition(&assign), 1);
+  index.insert(new SimpleVariableCondition(SimpleVariable("x")), 2);
+  index.insert(new SimpleConstantCondition(3), 3);
+
+  EXPECT_EQ(index.get(new SimpleStatementCondition(&assign)), 1);
+  EXPECT_EQ(index.get(new SimpleVariableCondition(SimpleVariable("x"))), 2);
+  EXPECT_EQ(index.get(new SimpleConstantCondition(3)), 3);
+  EXPECT_FALSE(index.contains(new SimpleConstantCondition(4)));
+}
+
+TEST(RelationIndexTest, StatementIndexTest) {
+  SimpleAssignmentAst assign1, assign2, assign3, unnumbered;
+  assign1.set_statement_line(1);
+  assign2.set_statement_line(5);
+  assign3.set_statement_line(5);
+
+  StatementIndex<int> index;
+  index.insert(&assign1, 1);
+  index.insert(&assign2, 2);
+  index.insert(&assign3, 3);
+  index.insert(&unnumbered, 4);
+
+  EXPECT_EQ(index.get(&assign1), 1);
+  EXPECT_EQ(index.get(&assign2), 2);
+  EXPECT_EQ(index.get(&assign3), 3);
+  EXPECT_EQ(index.get(&unnumbered), 4);
+
+  SimpleAssignmentAst missing;
+  missing.set_statement_line(3);
+  EXPECT_FALSE(index.contains(&missing));
+  EXPECT_EQ(index.get(&missing), 0);
+
+  index.clear();
+  EXPECT_FALSE(index.contains(&assign1));
+  EXPECT_FALSE(index.contains(&unnumbered));
+}
@@ -123,6 +123,19 @@ TEST(SolverTest, BasicTest) {
     EXPECT_EQ((next_interface->solve_left(&loop_condition)), 
         (next_solver.get_solver()->solve_left<StatementAst>(loop)));;
 
+    TypedValidator modifies_validator = 
+        modifies_interface->get_validator(StatementCT, VariableCT);
+    EXPECT_TRUE(modifies_validator.validate(&loop_condition, &z_condition));
+    EXPECT_FALSE(modifies_validator.validate(&stat1_condition, &z_condition));
+
+    TypedExistenceCheck modifies_has_left = 
+        modifies_interface->get_left_check(VariableCT);
+    EXPECT_TRUE(modifies_has_left.check(&z_condition));
+
+    TypedExistenceCheck next_has_right = 
+        next_interface->get_right_check(StatementCT);
+    EXPECT_EQ(next_has_right.check(&stat1_condition), 
+        next_interface->has_right(&stat1_condition));
 }
 
 }